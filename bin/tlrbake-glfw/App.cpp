@@ -158,9 +158,13 @@ namespace tlr
         _renderInfo.size = _options.renderSize.isValid() ?
             _options.renderSize :
             timelineInfo.size;
-        const auto timelinePixelType = imaging::PixelType::YUV_420P == timelineInfo.pixelType ?
-            imaging::PixelType::RGB_U8 :
-            timelineInfo.pixelType;
+        auto timelinePixelType = timelineInfo.pixelType;
+        if (imaging::isYUV(timelinePixelType))
+        {
+            timelinePixelType = imaging::getBitDepth(timelinePixelType) > 8 ?
+                imaging::PixelType::RGB_U16 :
+                imaging::PixelType::RGB_U8;
+        }
         _renderInfo.pixelType = _options.renderPixelType != imaging::PixelType::None ?
             _options.renderPixelType :
             timelinePixelType;
@@ -3,6 +3,7 @@ include(ExternalProject)
 set(tlRender_ARGS
     ${TLR_EXTERNAL_ARGS}
     -DTLR_ENABLE_MMAP=${TLR_ENABLE_MMAP}
+    -DTLR_ENABLE_IO_URING=${TLR_ENABLE_IO_URING}
     -DTLR_ENABLE_PYTHON=${TLR_ENABLE_PYTHON}
     -DTLR_BUILD_GL=${TLR_BUILD_GL}
     -DTLR_BUILD_QT=${TLR_BUILD_QT}
@@ -45,9 +45,13 @@ namespace tlr
         void IRead::_init(
             const file::Path& path,
             const Options& options,
+            const std::shared_ptr<Cache>& cache,
+            const std::shared_ptr<core::ThreadPool>& threadPool,
             const std::shared_ptr<core::LogSystem>& logSystem)
         {
             IIO::_init(path, options, logSystem);
+            _cache = cache;
+            _threadPool = threadPool;
         }
 
         IRead::IRead()
@@ -111,6 +115,16 @@ namespace tlr
             _options = options;
         }
 
+        void IPlugin::setCache(const std::shared_ptr<Cache>& cache)
+        {
+            _cache = cache;
+        }
+
+        void IPlugin::setThreadPool(const std::shared_ptr<core::ThreadPool>& threadPool)
+        {
+            _threadPool = threadPool;
+        }
+
         uint8_t IPlugin::getWriteAlignment(imaging::PixelType) const
         {
             return 1;
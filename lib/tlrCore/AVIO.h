@@ -18,11 +18,14 @@ namespace tlr
     namespace core
     {
         class LogSystem;
+        class ThreadPool;
     }
 
     //! Audio/visual I/O.
     namespace avio
     {
+        class Cache;
+
         //! I/O information.
         struct Info
         {
@@ -87,6 +90,8 @@ namespace tlr
             void _init(
                 const file::Path&,
                 const Options&,
+                const std::shared_ptr<Cache>&,
+                const std::shared_ptr<core::ThreadPool>&,
                 const std::shared_ptr<core::LogSystem>&);
             IRead();
 
@@ -96,8 +101,18 @@ namespace tlr
             //! Get the information.
             virtual std::future<Info> getInfo() = 0;
 
-            //! Read a video frame.
-            virtual std::future<VideoFrame> readVideoFrame(const otime::RationalTime&) = 0;
+            //! Read a video frame. Requests with a lower priority value are
+            //! served first, and requests with the same priority are served
+            //! in the order they were made.
+            //!
+            //! If a size is given the image may be read at a reduced
+            //! resolution, halving the full resolution while the image still
+            //! covers the size (see imaging::getProxyLevel()). This is used
+            //! for thumbnails, where decoding the full resolution is wasted.
+            virtual std::future<VideoFrame> readVideoFrame(
+                const otime::RationalTime&,
+                int64_t priority = 0,
+                const imaging::Size& size = imaging::Size()) = 0;
 
             //! Are there pending video frame requests?
             virtual bool hasVideoFrames() = 0;
@@ -110,6 +125,10 @@ namespace tlr
 
             //! Has the reader stopped?
             virtual bool hasStopped() const = 0;
+
+        protected:
+            std::shared_ptr<Cache> _cache;
+            std::shared_ptr<core::ThreadPool> _threadPool;
         };
         
         //! Base class for writers.
@@ -159,6 +178,12 @@ namespace tlr
             //! Set the plugin options.
             void setOptions(const Options&);
 
+            //! Set the video frame cache that is shared with the readers.
+            void setCache(const std::shared_ptr<Cache>&);
+
+            //! Set the thread pool that is shared with the readers.
+            void setThreadPool(const std::shared_ptr<core::ThreadPool>&);
+
             //! Create a reader for the given path.
             virtual std::shared_ptr<IRead> read(
                 const file::Path&,
@@ -184,6 +209,8 @@ namespace tlr
 
             std::shared_ptr<core::LogSystem> _logSystem;
             Options _options;
+            std::shared_ptr<Cache> _cache;
+            std::shared_ptr<core::ThreadPool> _threadPool;
 
         private:
             TLR_PRIVATE();
@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCore/AVIOCache.h>
+
+#include <tlrCore/LRUCache.h>
+
+#include <mutex>
+
+namespace tlr
+{
+    namespace avio
+    {
+        struct Cache::Private
+        {
+            memory::LRUCache<CacheKey, VideoFrame> cache;
+            mutable std::mutex mutex;
+        };
+
+        void Cache::_init()
+        {
+            TLR_PRIVATE_P();
+            p.cache.setMax(cacheMaxByteCount);
+        }
+
+        Cache::Cache() :
+            _p(new Private)
+        {}
+
+        Cache::~Cache()
+        {}
+
+        std::shared_ptr<Cache> Cache::create()
+        {
+            auto out = std::shared_ptr<Cache>(new Cache);
+            out->_init();
+            return out;
+        }
+
+        std::size_t Cache::getMax() const
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.cache.getMax();
+        }
+
+        void Cache::setMax(std::size_t value)
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.cache.setMax(value);
+        }
+
+        std::size_t Cache::getSize() const
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.cache.getSize();
+        }
+
+        std::size_t Cache::getCount() const
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.cache.getCount();
+        }
+
+        float Cache::getPercentageUsed() const
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.cache.getPercentageUsed();
+        }
+
+        bool Cache::contains(const CacheKey& key) const
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.cache.contains(key);
+        }
+
+        bool Cache::get(const CacheKey& key, VideoFrame& value)
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.cache.get(key, value);
+        }
+
+        void Cache::add(const CacheKey& key, const VideoFrame& value)
+        {
+            TLR_PRIVATE_P();
+            if (value.image)
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.cache.add(key, value, value.image->getDataByteCount());
+            }
+        }
+
+        void Cache::remove(const CacheKey& key)
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.cache.remove(key);
+        }
+
+        void Cache::clear()
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.cache.clear();
+        }
+    }
+}
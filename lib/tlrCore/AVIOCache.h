@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlrCore/AVIO.h>
+#include <tlrCore/Memory.h>
+
+#include <functional>
+
+namespace tlr
+{
+    namespace avio
+    {
+        //! Default maximum number of bytes for the video frame cache.
+        const std::size_t cacheMaxByteCount = memory::gigabyte;
+
+        //! Video frame cache key.
+        struct CacheKey
+        {
+            CacheKey();
+            CacheKey(
+                const std::string& fileName,
+                int64_t frame,
+                imaging::PixelType = imaging::PixelType::None,
+                uint16_t proxyLevel = 0,
+                const std::string& options = std::string());
+
+            //! Resolved file name.
+            std::string fileName;
+
+            //! Source frame number.
+            int64_t frame = 0;
+
+            //! Requested pixel type, or PixelType::None for the native
+            //! pixel type of the file.
+            imaging::PixelType pixelType = imaging::PixelType::None;
+
+            //! Proxy level, see imaging::getProxyLevel().
+            uint16_t proxyLevel = 0;
+
+            //! Reader options that change the decoded image (the layer,
+            //! channels, etc.), so that frames read with different options
+            //! are not shared.
+            std::string options;
+
+            bool operator == (const CacheKey&) const;
+            bool operator != (const CacheKey&) const;
+        };
+
+        //! Video frame cache.
+        //!
+        //! The cache is shared by all of the readers created by the I/O
+        //! system, so frames decoded by one reader can be re-used by any
+        //! other reader of the same media. Frames are weighted by the size
+        //! of their image data, and the least recently used frames are
+        //! removed when the total exceeds the maximum number of bytes.
+        //!
+        //! The cache is thread safe.
+        class Cache : public std::enable_shared_from_this<Cache>
+        {
+            TLR_NON_COPYABLE(Cache);
+
+        protected:
+            void _init();
+            Cache();
+
+        public:
+            ~Cache();
+
+            //! Create a new cache.
+            static std::shared_ptr<Cache> create();
+
+            //! Get the maximum number of bytes.
+            std::size_t getMax() const;
+
+            //! Set the maximum number of bytes.
+            void setMax(std::size_t);
+
+            //! Get the number of bytes used.
+            std::size_t getSize() const;
+
+            //! Get the number of frames in the cache.
+            std::size_t getCount() const;
+
+            //! Get the percentage used.
+            float getPercentageUsed() const;
+
+            //! Get whether the cache contains the given key.
+            bool contains(const CacheKey&) const;
+
+            //! Get a frame from the cache.
+            bool get(const CacheKey&, VideoFrame&);
+
+            //! Add a frame to the cache. Frames without an image are ignored.
+            void add(const CacheKey&, const VideoFrame&);
+
+            //! Remove a frame from the cache.
+            void remove(const CacheKey&);
+
+            //! Remove all of the frames from the cache.
+            void clear();
+
+        private:
+            TLR_PRIVATE();
+        };
+    }
+}
+
+namespace std
+{
+    template<>
+    struct hash<tlr::avio::CacheKey>
+    {
+        std::size_t operator() (const tlr::avio::CacheKey&) const noexcept;
+    };
+}
+
+#include <tlrCore/AVIOCacheInline.h>
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+namespace tlr
+{
+    namespace avio
+    {
+        inline CacheKey::CacheKey()
+        {}
+
+        inline CacheKey::CacheKey(
+            const std::string& fileName,
+            int64_t frame,
+            imaging::PixelType pixelType,
+            uint16_t proxyLevel,
+            const std::string& options) :
+            fileName(fileName),
+            frame(frame),
+            pixelType(pixelType),
+            proxyLevel(proxyLevel),
+            options(options)
+        {}
+
+        inline bool CacheKey::operator == (const CacheKey& other) const
+        {
+            return
+                fileName == other.fileName &&
+                frame == other.frame &&
+                pixelType == other.pixelType &&
+                proxyLevel == other.proxyLevel &&
+                options == other.options;
+        }
+
+        inline bool CacheKey::operator != (const CacheKey& other) const
+        {
+            return !(*this == other);
+        }
+    }
+}
+
+namespace std
+{
+    inline std::size_t hash<tlr::avio::CacheKey>::operator() (const tlr::avio::CacheKey& key) const noexcept
+    {
+        std::size_t out = std::hash<std::string>()(key.fileName);
+        out ^= std::hash<int64_t>()(key.frame) + 0x9e3779b9 + (out << 6) + (out >> 2);
+        out ^= std::hash<int>()(static_cast<int>(key.pixelType)) + 0x9e3779b9 + (out << 6) + (out >> 2);
+        out ^= std::hash<uint16_t>()(key.proxyLevel) + 0x9e3779b9 + (out << 6) + (out >> 2);
+        out ^= std::hash<std::string>()(key.options) + 0x9e3779b9 + (out << 6) + (out >> 2);
+        return out;
+    }
+}
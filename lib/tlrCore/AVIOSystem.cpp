@@ -7,6 +7,7 @@
 #include <tlrCore/Context.h>
 #include <tlrCore/File.h>
 #include <tlrCore/String.h>
+#include <tlrCore/ThreadPool.h>
 
 #include <tlrCore/Cineon.h>
 #include <tlrCore/DPX.h>
@@ -53,6 +54,14 @@ namespace tlr
 #if defined(TIFF_FOUND)
             _plugins.push_back(tiff::Plugin::create(logSystem));
 #endif
+
+            _cache = Cache::create();
+            const auto threadPool = _context->getSystem<core::ThreadPool>();
+            for (const auto& i : _plugins)
+            {
+                i->setCache(_cache);
+                i->setThreadPool(threadPool);
+            }
         }
 
         System::System(const std::shared_ptr<core::Context>& context) :
@@ -75,6 +84,15 @@ namespace tlr
             {
                 i->setOptions(options);
             }
+
+            const auto i = options.find("AVIO/CacheMax");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                std::size_t max = 0;
+                ss >> max;
+                _cache->setMax(max);
+            }
         }
 
         std::shared_ptr<IPlugin> System::getPlugin(const file::Path& path) const
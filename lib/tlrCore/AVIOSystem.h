@@ -4,7 +4,7 @@
 
 #pragma once
 
-#include <tlrCore/AVIO.h>
+#include <tlrCore/AVIOCache.h>
 #include <tlrCore/ISystem.h>
 
 namespace tlr
@@ -39,6 +39,10 @@ namespace tlr
             //! Get a plugin for the given path.
             std::shared_ptr<IPlugin> getPlugin(const file::Path&) const;
 
+            //! Get the video frame cache. The cache is shared by all of the
+            //! readers created with this system.
+            const std::shared_ptr<Cache>& getCache() const;
+
             // Create a reader for the given path.
             std::shared_ptr<IRead> read(
                 const file::Path&,
@@ -52,6 +56,7 @@ namespace tlr
 
         private:
             std::vector<std::shared_ptr<IPlugin> > _plugins;
+            std::shared_ptr<Cache> _cache;
         };
     }
 }
@@ -11,6 +11,11 @@ namespace tlr
             return _plugins;
         }
 
+        inline const std::shared_ptr<Cache>& System::getCache() const
+        {
+            return _cache;
+        }
+
         template<typename T>
         inline std::shared_ptr<T> System::getPlugin() const
         {
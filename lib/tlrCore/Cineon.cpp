@@ -210,6 +210,90 @@ namespace tlr
                     *in < _floatMax;
             }
 
+            void getTags(const Header& out, avio::Info& info)
+            {
+                if (cineon::isValid(out.file.time, 24))
+                {
+                    info.tags["Time"] = toString(out.file.time, 24);
+                }
+                if (isValid(&out.source.offset[0]) && isValid(&out.source.offset[1]))
+                {
+                    std::stringstream ss;
+                    ss << out.source.offset[0] << " " << out.source.offset[1];
+                    info.tags["Source Offset"] = ss.str();
+                }
+                if (cineon::isValid(out.source.file, 100))
+                {
+                    info.tags["Source File"] = toString(out.source.file, 100);
+                }
+                if (cineon::isValid(out.source.time, 24))
+                {
+                    info.tags["Source Time"] = toString(out.source.time, 24);
+                }
+                if (cineon::isValid(out.source.inputDevice, 64))
+                {
+                    info.tags["Source Input Device"] = toString(out.source.inputDevice, 64);
+                }
+                if (cineon::isValid(out.source.inputModel, 32))
+                {
+                    info.tags["Source Input Model"] = toString(out.source.inputModel, 32);
+                }
+                if (cineon::isValid(out.source.inputSerial, 32))
+                {
+                    info.tags["Source Input Serial"] = toString(out.source.inputSerial, 32);
+                }
+                if (isValid(&out.source.inputPitch[0]) && isValid(&out.source.inputPitch[1]))
+                {
+                    std::stringstream ss;
+                    ss << out.source.inputPitch[0] << " " << out.source.inputPitch[1];
+                    info.tags["Source Input Pitch"] = ss.str();
+                }
+                if (isValid(&out.source.gamma))
+                {
+                    std::stringstream ss;
+                    ss << out.source.gamma;
+                    info.tags["Source Gamma"] = ss.str();
+                }
+                if (isValid(&out.film.id) &&
+                    isValid(&out.film.type) &&
+                    isValid(&out.film.offset) &&
+                    isValid(&out.film.prefix) &&
+                    isValid(&out.film.count))
+                {
+                    info.tags["Keycode"] = time::keycodeToString(
+                        out.film.id,
+                        out.film.type,
+                        out.film.prefix,
+                        out.film.count,
+                        out.film.offset);
+                }
+                if (cineon::isValid(out.film.format, 32))
+                {
+                    info.tags["Film Format"] = toString(out.film.format, 32);
+                }
+                if (isValid(&out.film.frame))
+                {
+                    std::stringstream ss;
+                    ss << out.film.frame;
+                    info.tags["Film Frame"] = ss.str();
+                }
+                if (isValid(&out.film.frameRate) && out.film.frameRate >= _minSpeed)
+                {
+                    info.videoDuration = otime::RationalTime(1.0, out.film.frameRate);
+                    std::stringstream ss;
+                    ss << out.film.frameRate;
+                    info.tags["Film Frame Rate"] = ss.str();
+                }
+                if (cineon::isValid(out.film.frameId, 32))
+                {
+                    info.tags["Film Frame ID"] = toString(out.film.frameId, 32);
+                }
+                if (cineon::isValid(out.film.slate, 200))
+                {
+                    info.tags["Film Slate"] = toString(out.film.slate, 200);
+                }
+            }
+
         } // namespace
 
         Header read(const std::shared_ptr<file::FileIO>& io, avio::Info& info)
@@ -339,86 +423,7 @@ namespace tlr
             info.video.push_back(imageInfo);
 
             // Tags.
-            if (isValid(out.file.time, 24))
-            {
-                info.tags["Time"] = toString(out.file.time, 24);
-            }
-            if (isValid(&out.source.offset[0]) && isValid(&out.source.offset[1]))
-            {
-                std::stringstream ss;
-                ss << out.source.offset[0] << " " << out.source.offset[1];
-                info.tags["Source Offset"] = ss.str();
-            }
-            if (isValid(out.source.file, 100))
-            {
-                info.tags["Source File"] = toString(out.source.file, 100);
-            }
-            if (isValid(out.source.time, 24))
-            {
-                info.tags["Source Time"] = toString(out.source.time, 24);
-            }
-            if (isValid(out.source.inputDevice, 64))
-            {
-                info.tags["Source Input Device"] = toString(out.source.inputDevice, 64);
-            }
-            if (isValid(out.source.inputModel, 32))
-            {
-                info.tags["Source Input Model"] = toString(out.source.inputModel, 32);
-            }
-            if (isValid(out.source.inputSerial, 32))
-            {
-                info.tags["Source Input Serial"] = toString(out.source.inputSerial, 32);
-            }
-            if (isValid(&out.source.inputPitch[0]) && isValid(&out.source.inputPitch[1]))
-            {
-                std::stringstream ss;
-                ss << out.source.inputPitch[0] << " " << out.source.inputPitch[1];
-                info.tags["Source Input Pitch"] = ss.str();
-            }
-            if (isValid(&out.source.gamma))
-            {
-                std::stringstream ss;
-                ss << out.source.gamma;
-                info.tags["Source Gamma"] = ss.str();
-            }
-            if (isValid(&out.film.id) &&
-                isValid(&out.film.type) &&
-                isValid(&out.film.offset) &&
-                isValid(&out.film.prefix) &&
-                isValid(&out.film.count))
-            {
-                info.tags["Keycode"] = time::keycodeToString(
-                    out.film.id,
-                    out.film.type,
-                    out.film.prefix,
-                    out.film.count,
-                    out.film.offset);
-            }
-            if (isValid(out.film.format, 32))
-            {
-                info.tags["Film Format"] = toString(out.film.format, 32);
-            }
-            if (isValid(&out.film.frame))
-            {
-                std::stringstream ss;
-                ss << out.film.frame;
-                info.tags["Film Frame"] = ss.str();
-            }
-            if (isValid(&out.film.frameRate) && out.film.frameRate >= _minSpeed)
-            {
-                info.videoDuration = otime::RationalTime(1.0, out.film.frameRate);
-                std::stringstream ss;
-                ss << out.film.frameRate;
-                info.tags["Film Frame Rate"] = ss.str();
-            }
-            if (isValid(out.film.frameId, 32))
-            {
-                info.tags["Film Frame ID"] = toString(out.film.frameId, 32);
-            }
-            if (isValid(out.film.slate, 200))
-            {
-                info.tags["Film Slate"] = toString(out.film.slate, 200);
-            }
+            getTags(out, info);
 
             // Set the file position.
             if (out.file.imageOffset)
@@ -429,6 +434,15 @@ namespace tlr
             return out;
         }
 
+        void readTags(Header header, avio::Info& info)
+        {
+            if (magic[1] == header.file.magic)
+            {
+                convertEndian(header);
+            }
+            getTags(header, info);
+        }
+
         void write(const std::shared_ptr<file::FileIO>& io, const avio::Info& info)
         {
             Header header;
@@ -612,7 +626,7 @@ namespace tlr
             const file::Path& path,
             const avio::Options& options)
         {
-            return Read::create(path, avio::merge(options, _options), _logSystem);
+            return Read::create(path, avio::merge(options, _options), _cache, _threadPool, _logSystem);
         }
 
         std::vector<imaging::PixelType> Plugin::getWritePixelTypes() const
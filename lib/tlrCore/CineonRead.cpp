@@ -6,33 +6,66 @@
 
 #include <tlrCore/StringFormat.h>
 
+#include <cstring>
+#include <map>
+#include <mutex>
 #include <sstream>
+#include <vector>
 
 namespace tlr
 {
     namespace cineon
     {
+        struct Read::Private
+        {
+            struct Layout
+            {
+                Header::File file;
+                Header::Image image;
+                size_t ioSize = 0;
+                size_t imageOffset = 0;
+                avio::Info info;
+            };
+            std::unique_ptr<Layout> layout;
+            std::mutex mutex;
+
+            // The read queues are re-used by the batches, so that a queue
+            // (and its io_uring ring) is only created for each batch that is
+            // in flight at the same time.
+            std::vector<std::shared_ptr<file::ReadQueue> > readQueues;
+            std::mutex readQueuesMutex;
+        };
+
         void Read::_init(
             const file::Path& path,
             const avio::Options& options,
+            const std::shared_ptr<avio::Cache>& cache,
+            const std::shared_ptr<core::ThreadPool>& threadPool,
             const std::shared_ptr<core::LogSystem>& logSystem)
         {
-            ISequenceRead::_init(path, options, logSystem);
+            ISequenceRead::_init(path, options, cache, threadPool, logSystem);
         }
 
-        Read::Read()
-        {}
+        Read::Read() :
+            _p(new Private)
+        {
+            _batchRead = true;
+        }
 
         Read::~Read()
-        {}
+        {
+            _finish();
+        }
 
         std::shared_ptr<Read> Read::create(
             const file::Path& path,
             const avio::Options& options,
+            const std::shared_ptr<avio::Cache>& cache,
+            const std::shared_ptr<core::ThreadPool>& threadPool,
             const std::shared_ptr<core::LogSystem>& logSystem)
         {
             auto out = std::shared_ptr<Read>(new Read);
-            out->_init(path, options, logSystem);
+            out->_init(path, options, cache, threadPool, logSystem);
             return out;
         }
 
@@ -48,20 +81,159 @@ namespace tlr
 
         avio::VideoFrame Read::_readVideoFrame(
             const std::string& fileName,
-            const otime::RationalTime& time)
+            const otime::RationalTime& time,
+            uint16_t proxyLevel)
         {
             avio::VideoFrame out;
             out.time = time;
 
             auto io = file::FileIO::create();
-            io->open(fileName, file::Mode::Read);
+            io->open(fileName, file::Mode::Read, _directIO);
             avio::Info info;
-            read(io, info);
+            size_t imageOffset = 0;
+            _readHeader(io, info, imageOffset);
 
-            out.image = imaging::Image::create(info.video[0]);
+            if (proxyLevel > 0)
+            {
+                out.image = _readProxyImage(io, info.video[0], imageOffset, proxyLevel);
+            }
+            else
+            {
+                out.image = _mapImage(io, info.video[0], imageOffset);
+                if (!out.image)
+                {
+                    out.image = imaging::Image::create(info.video[0]);
+                    io->readAt(imageOffset, out.image->getData(), imaging::getDataByteCount(info.video[0]));
+                }
+            }
             out.image->setTags(info.tags);
-            io->read(out.image->getData(), imaging::getDataByteCount(info.video[0]));
             return out;
         }
+
+        std::vector<avio::VideoFrame> Read::_readVideoFrames(
+            const std::vector<std::string>& fileNames,
+            const std::vector<otime::RationalTime>& times,
+            uint16_t proxyLevel)
+        {
+            TLR_PRIVATE_P();
+
+            // Proxies only read some of the rows, one frame at a time.
+            if (proxyLevel > 0)
+            {
+                return ISequenceRead::_readVideoFrames(fileNames, times, proxyLevel);
+            }
+
+            std::vector<avio::VideoFrame> out(fileNames.size());
+
+            // Read the headers, then read the image data for all of the
+            // frames with one submission. Memory-mapped frames are used
+            // directly without reading.
+            std::shared_ptr<file::ReadQueue> queue;
+            {
+                std::unique_lock<std::mutex> lock(p.readQueuesMutex);
+                if (!p.readQueues.empty())
+                {
+                    queue = p.readQueues.back();
+                    p.readQueues.pop_back();
+                }
+            }
+            if (!queue)
+            {
+                queue = file::ReadQueue::create(_threadPool);
+            }
+            std::map<uint64_t, size_t> ids;
+            for (size_t i = 0; i < fileNames.size(); ++i)
+            {
+                out[i].time = times[i];
+                try
+                {
+                    auto io = file::FileIO::create();
+                    io->open(fileNames[i], file::Mode::Read, _directIO);
+                    avio::Info info;
+                    size_t imageOffset = 0;
+                    _readHeader(io, info, imageOffset);
+
+                    out[i].image = _mapImage(io, info.video[0], imageOffset);
+                    if (!out[i].image)
+                    {
+                        out[i].image = imaging::Image::create(info.video[0]);
+                        const uint64_t id = queue->read(
+                            io,
+                            imageOffset,
+                            out[i].image->getData(),
+                            imaging::getDataByteCount(info.video[0]));
+                        ids[id] = i;
+                    }
+                    out[i].image->setTags(info.tags);
+                }
+                catch (const std::exception&)
+                {
+                    out[i].image.reset();
+                }
+            }
+            queue->submit();
+            for (const auto& result : queue->wait())
+            {
+                if (!result.error.empty())
+                {
+                    out[ids[result.id]].image.reset();
+                }
+            }
+            {
+                std::unique_lock<std::mutex> lock(p.readQueuesMutex);
+                p.readQueues.push_back(queue);
+            }
+            return out;
+        }
+
+        void Read::_readHeader(
+            const std::shared_ptr<file::FileIO>& io,
+            avio::Info& info,
+            size_t& imageOffset)
+        {
+            TLR_PRIVATE_P();
+
+            // Read the header in one read, and compare the file and image
+            // sections with the cached layout. The other sections hold the
+            // per-frame information (time code, etc.), so the tags are
+            // always parsed from them.
+            static_assert(
+                sizeof(Header) ==
+                    sizeof(Header::File) + sizeof(Header::Image) + sizeof(Header::Source) +
+                    sizeof(Header::Film),
+                "Unexpected header padding");
+            Header header;
+            io->readAt(0, &header, sizeof(Header));
+            const size_t ioSize = io->getSize();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (p.layout &&
+                    header.file.magic == p.layout->file.magic &&
+                    header.file.imageOffset == p.layout->file.imageOffset &&
+                    header.file.size == p.layout->file.size &&
+                    ioSize == p.layout->ioSize &&
+                    0 == memcmp(&header.image, &p.layout->image, sizeof(Header::Image)))
+                {
+                    info = p.layout->info;
+                    imageOffset = p.layout->imageOffset;
+                    lock.unlock();
+                    info.tags.clear();
+                    readTags(header, info);
+                    return;
+                }
+            }
+
+            // Parse the whole header and cache the layout.
+            read(io, info);
+            imageOffset = io->getPos();
+            auto layout = std::unique_ptr<Private::Layout>(new Private::Layout);
+            layout->file = header.file;
+            layout->image = header.image;
+            layout->ioSize = ioSize;
+            layout->imageOffset = imageOffset;
+            layout->info = info;
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.layout = std::move(layout);
+        }
     }
 }
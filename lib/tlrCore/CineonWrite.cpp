@@ -51,7 +51,7 @@ namespace tlr
             info.tags = image->getTags();
             write(io, info);
 
-            io->write(image->getData(), imaging::getDataByteCount(image->getInfo()));
+            io->write(imaging::pack(image)->getData(), imaging::getDataByteCount(image->getInfo()));
             finishWrite(io);
         }
     }
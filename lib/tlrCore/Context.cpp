@@ -5,6 +5,7 @@
 #include <tlrCore/Context.h>
 
 #include <tlrCore/AVIOSystem.h>
+#include <tlrCore/ThreadPool.h>
 
 namespace tlr
 {
@@ -25,6 +26,7 @@ namespace tlr
                     _p->logInit.push_back(value);
                 });
             _systems.push_back(_logSystem);
+            _systems.push_back(ThreadPool::create(shared_from_this()));
             _systems.push_back(avio::System::create(shared_from_this()));
         }
 
@@ -184,6 +184,216 @@ namespace tlr
                     *in > -_floatMax &&
                     *in < _floatMax;
             }
+
+            void getTags(const Header& out, avio::Info& info)
+            {
+                if (cineon::isValid(out.file.time, 24))
+                {
+                    info.tags["Time"] = cineon::toString(out.file.time, 24);
+                }
+                if (cineon::isValid(out.file.creator, 100))
+                {
+                    info.tags["Creator"] = cineon::toString(out.file.creator, 100);
+                }
+                if (cineon::isValid(out.file.project, 200))
+                {
+                    info.tags["Project"] = cineon::toString(out.file.project, 200);
+                }
+                if (cineon::isValid(out.file.copyright, 200))
+                {
+                    info.tags["Copyright"] = cineon::toString(out.file.copyright, 200);
+                }
+
+                if (isValid(&out.source.offset[0]) && isValid(&out.source.offset[1]))
+                {
+                    std::stringstream ss;
+                    ss << out.source.offset[0] << " " << out.source.offset[1];
+                    info.tags["Source Offset"] = ss.str();
+                }
+                if (isValid(&out.source.center[0]) && isValid(&out.source.center[1]))
+                {
+                    std::stringstream ss;
+                    ss << out.source.center[0] << " " << out.source.center[1];
+                    info.tags["Source Center"] = ss.str();
+                }
+                if (isValid(&out.source.size[0]) && isValid(&out.source.size[1]))
+                {
+                    std::stringstream ss;
+                    ss << out.source.size[0] << " " << out.source.size[1];
+                    info.tags["Source Size"] = ss.str();
+                }
+                if (cineon::isValid(out.source.file, 100))
+                {
+                    info.tags["Source File"] = cineon::toString(out.source.file, 100);
+                }
+                if (cineon::isValid(out.source.time, 24))
+                {
+                    info.tags["Source Time"] = cineon::toString(out.source.time, 24);
+                }
+                if (cineon::isValid(out.source.inputDevice, 32))
+                {
+                    info.tags["Source Input Device"] = cineon::toString(out.source.inputDevice, 32);
+                }
+                if (cineon::isValid(out.source.inputSerial, 32))
+                {
+                    info.tags["Source Input Serial"] = cineon::toString(out.source.inputSerial, 32);
+                }
+                if (isValid(&out.source.border[0]) && isValid(&out.source.border[1]) &&
+                    isValid(&out.source.border[2]) && isValid(&out.source.border[3]))
+                {
+                    std::stringstream ss;
+                    ss << out.source.border[0] << " ";
+                    ss << out.source.border[1] << " ";
+                    ss << out.source.border[2] << " ";
+                    ss << out.source.border[3];
+                    info.tags["Source Border"] = ss.str();
+                }
+                if (isValid(&out.source.pixelAspect[0]) && isValid(&out.source.pixelAspect[1]))
+                {
+                    std::stringstream ss;
+                    ss << out.source.pixelAspect[0] << " " << out.source.pixelAspect[1];
+                    info.tags["Source Pixel Aspect"] = ss.str();
+                }
+                if (isValid(&out.source.scanSize[0]) && isValid(&out.source.scanSize[1]))
+                {
+                    std::stringstream ss;
+                    ss << out.source.scanSize[0] << " " << out.source.scanSize[1];
+                    info.tags["Source Scan Size"] = ss.str();
+                }
+
+                if (cineon::isValid(out.film.id, 2) && cineon::isValid(out.film.type, 2) &&
+                    cineon::isValid(out.film.offset, 2) && cineon::isValid(out.film.prefix, 6) &&
+                    cineon::isValid(out.film.count, 4))
+                {
+                    info.tags["Keycode"] = time::keycodeToString(
+                        std::stoi(std::string(out.film.id, 2)),
+                        std::stoi(std::string(out.film.type, 2)),
+                        std::stoi(std::string(out.film.prefix, 6)),
+                        std::stoi(std::string(out.film.count, 4)),
+                        std::stoi(std::string(out.film.offset, 2)));
+                }
+                if (cineon::isValid(out.film.format, 32))
+                {
+                    info.tags["Film Format"] = cineon::toString(out.film.format, 32);
+                }
+                if (isValid(&out.film.frame))
+                {
+                    std::stringstream ss;
+                    ss << out.film.frame;
+                    info.tags["Film Frame"] = ss.str();
+                }
+                if (isValid(&out.film.sequence))
+                {
+                    std::stringstream ss;
+                    ss << out.film.sequence;
+                    info.tags["Film Sequence"] = ss.str();
+                }
+                if (isValid(&out.film.hold))
+                {
+                    std::stringstream ss;
+                    ss << out.film.hold;
+                    info.tags["Film Hold"] = ss.str();
+                }
+                if (isValid(&out.film.frameRate) && out.film.frameRate > _minSpeed)
+                {
+                    info.videoDuration = otime::RationalTime(1.0, out.film.frameRate);
+                    std::stringstream ss;
+                    ss << out.film.frameRate;
+                    info.tags["Film Frame Rate"] = ss.str();
+                }
+                if (isValid(&out.film.shutter))
+                {
+                    std::stringstream ss;
+                    ss << out.film.shutter;
+                    info.tags["Film Shutter"] = ss.str();
+                }
+                if (cineon::isValid(out.film.frameId, 32))
+                {
+                    info.tags["Film Frame ID"] = cineon::toString(out.film.frameId, 32);
+                }
+                if (cineon::isValid(out.film.slate, 100))
+                {
+                    info.tags["Film Slate"] = cineon::toString(out.film.slate, 100);
+                }
+
+                if (isValid(&out.tv.timecode))
+                {
+                    info.tags["Timecode"] = time::timecodeToString(out.tv.timecode);
+                }
+                if (isValid(&out.tv.interlace))
+                {
+                    std::stringstream ss;
+                    ss << static_cast<unsigned int>(out.tv.interlace);
+                    info.tags["TV Interlace"] = ss.str();
+                }
+                if (isValid(&out.tv.field))
+                {
+                    std::stringstream ss;
+                    ss << static_cast<unsigned int>(out.tv.field);
+                    info.tags["TV Field"] = ss.str();
+                }
+                if (isValid(&out.tv.videoSignal))
+                {
+                    std::stringstream ss;
+                    ss << static_cast<unsigned int>(out.tv.videoSignal);
+                    info.tags["TV Video Signal"] = ss.str();
+                }
+                if (isValid(&out.tv.sampleRate[0]) && isValid(&out.tv.sampleRate[1]))
+                {
+                    std::stringstream ss;
+                    ss << out.tv.sampleRate[0] << " " << out.tv.sampleRate[1];
+                    info.tags["TV Sample Rate"] = ss.str();
+                }
+                if (isValid(&out.tv.frameRate) && out.tv.frameRate > _minSpeed)
+                {
+                    info.videoDuration = otime::RationalTime(1.0, out.tv.frameRate);
+                    std::stringstream ss;
+                    ss << out.tv.frameRate;
+                    info.tags["TV Frame Rate"] = ss.str();
+                }
+                if (isValid(&out.tv.timeOffset))
+                {
+                    std::stringstream ss;
+                    ss << out.tv.timeOffset;
+                    info.tags["TV Time Offset"] = ss.str();
+                }
+                if (isValid(&out.tv.gamma))
+                {
+                    std::stringstream ss;
+                    ss << out.tv.gamma;
+                    info.tags["TV Gamma"] = ss.str();
+                }
+                if (isValid(&out.tv.blackLevel))
+                {
+                    std::stringstream ss;
+                    ss << out.tv.blackLevel;
+                    info.tags["TV Black Level"] = ss.str();
+                }
+                if (isValid(&out.tv.blackGain))
+                {
+                    std::stringstream ss;
+                    ss << out.tv.blackGain;
+                    info.tags["TV Black Gain"] = ss.str();
+                }
+                if (isValid(&out.tv.breakpoint))
+                {
+                    std::stringstream ss;
+                    ss << out.tv.breakpoint;
+                    info.tags["TV Breakpoint"] = ss.str();
+                }
+                if (isValid(&out.tv.whiteLevel))
+                {
+                    std::stringstream ss;
+                    ss << out.tv.whiteLevel;
+                    info.tags["TV White Level"] = ss.str();
+                }
+                if (isValid(&out.tv.integrationTimes))
+                {
+                    std::stringstream ss;
+                    ss << out.tv.integrationTimes;
+                    info.tags["TV Integration Times"] = ss.str();
+                }
+            }
         }
 
         Header read(
@@ -333,214 +543,7 @@ namespace tlr
             info.video.push_back(imageInfo);
 
             // Tags.
-            if (cineon::isValid(out.file.time, 24))
-            {
-                info.tags["Time"] = cineon::toString(out.file.time, 24);
-            }
-            if (cineon::isValid(out.file.creator, 100))
-            {
-                info.tags["Creator"] = cineon::toString(out.file.creator, 100);
-            }
-            if (cineon::isValid(out.file.project, 200))
-            {
-                info.tags["Project"] = cineon::toString(out.file.project, 200);
-            }
-            if (cineon::isValid(out.file.copyright, 200))
-            {
-                info.tags["Copyright"] = cineon::toString(out.file.copyright, 200);
-            }
-
-            if (isValid(&out.source.offset[0]) && isValid(&out.source.offset[1]))
-            {
-                std::stringstream ss;
-                ss << out.source.offset[0] << " " << out.source.offset[1];
-                info.tags["Source Offset"] = ss.str();
-            }
-            if (isValid(&out.source.center[0]) && isValid(&out.source.center[1]))
-            {
-                std::stringstream ss;
-                ss << out.source.center[0] << " " << out.source.center[1];
-                info.tags["Source Center"] = ss.str();
-            }
-            if (isValid(&out.source.size[0]) && isValid(&out.source.size[1]))
-            {
-                std::stringstream ss;
-                ss << out.source.size[0] << " " << out.source.size[1];
-                info.tags["Source Size"] = ss.str();
-            }
-            if (cineon::isValid(out.source.file, 100))
-            {
-                info.tags["Source File"] = cineon::toString(out.source.file, 100);
-            }
-            if (cineon::isValid(out.source.time, 24))
-            {
-                info.tags["Source Time"] = cineon::toString(out.source.time, 24);
-            }
-            if (cineon::isValid(out.source.inputDevice, 32))
-            {
-                info.tags["Source Input Device"] = cineon::toString(out.source.inputDevice, 32);
-            }
-            if (cineon::isValid(out.source.inputSerial, 32))
-            {
-                info.tags["Source Input Serial"] = cineon::toString(out.source.inputSerial, 32);
-            }
-            if (isValid(&out.source.border[0]) && isValid(&out.source.border[1]) &&
-                isValid(&out.source.border[2]) && isValid(&out.source.border[3]))
-            {
-                std::stringstream ss;
-                ss << out.source.border[0] << " ";
-                ss << out.source.border[1] << " ";
-                ss << out.source.border[2] << " ";
-                ss << out.source.border[3];
-                info.tags["Source Border"] = ss.str();
-            }
-            if (isValid(&out.source.pixelAspect[0]) && isValid(&out.source.pixelAspect[1]))
-            {
-                std::stringstream ss;
-                ss << out.source.pixelAspect[0] << " " << out.source.pixelAspect[1];
-                info.tags["Source Pixel Aspect"] = ss.str();
-            }
-            if (isValid(&out.source.scanSize[0]) && isValid(&out.source.scanSize[1]))
-            {
-                std::stringstream ss;
-                ss << out.source.scanSize[0] << " " << out.source.scanSize[1];
-                info.tags["Source Scan Size"] = ss.str();
-            }
-
-            if (cineon::isValid(out.film.id, 2) && cineon::isValid(out.film.type, 2) &&
-                cineon::isValid(out.film.offset, 2) && cineon::isValid(out.film.prefix, 6) &&
-                cineon::isValid(out.film.count, 4))
-            {
-                info.tags["Keycode"] = time::keycodeToString(
-                    std::stoi(std::string(out.film.id, 2)),
-                    std::stoi(std::string(out.film.type, 2)),
-                    std::stoi(std::string(out.film.prefix, 6)),
-                    std::stoi(std::string(out.film.count, 4)),
-                    std::stoi(std::string(out.film.offset, 2)));
-            }
-            if (cineon::isValid(out.film.format, 32))
-            {
-                info.tags["Film Format"] = cineon::toString(out.film.format, 32);
-            }
-            if (isValid(&out.film.frame))
-            {
-                std::stringstream ss;
-                ss << out.film.frame;
-                info.tags["Film Frame"] = ss.str();
-            }
-            if (isValid(&out.film.sequence))
-            {
-                std::stringstream ss;
-                ss << out.film.sequence;
-                info.tags["Film Sequence"] = ss.str();
-            }
-            if (isValid(&out.film.hold))
-            {
-                std::stringstream ss;
-                ss << out.film.hold;
-                info.tags["Film Hold"] = ss.str();
-            }
-            if (isValid(&out.film.frameRate) && out.film.frameRate > _minSpeed)
-            {
-                info.videoDuration = otime::RationalTime(1.0, out.film.frameRate);
-                std::stringstream ss;
-                ss << out.film.frameRate;
-                info.tags["Film Frame Rate"] = ss.str();
-            }
-            if (isValid(&out.film.shutter))
-            {
-                std::stringstream ss;
-                ss << out.film.shutter;
-                info.tags["Film Shutter"] = ss.str();
-            }
-            if (cineon::isValid(out.film.frameId, 32))
-            {
-                info.tags["Film Frame ID"] = cineon::toString(out.film.frameId, 32);
-            }
-            if (cineon::isValid(out.film.slate, 100))
-            {
-                info.tags["Film Slate"] = cineon::toString(out.film.slate, 100);
-            }
-
-            if (isValid(&out.tv.timecode))
-            {
-                std::stringstream ss;
-                ss << out.tv.timecode;
-                info.tags["Timecode"] = ss.str();
-            }
-            if (isValid(&out.tv.interlace))
-            {
-                std::stringstream ss;
-                ss << static_cast<unsigned int>(out.tv.interlace);
-                info.tags["TV Interlace"] = ss.str();
-            }
-            if (isValid(&out.tv.field))
-            {
-                std::stringstream ss;
-                ss << static_cast<unsigned int>(out.tv.field);
-                info.tags["TV Field"] = ss.str();
-            }
-            if (isValid(&out.tv.videoSignal))
-            {
-                std::stringstream ss;
-                ss << static_cast<unsigned int>(out.tv.videoSignal);
-                info.tags["TV Video Signal"] = ss.str();
-            }
-            if (isValid(&out.tv.sampleRate[0]) && isValid(&out.tv.sampleRate[1]))
-            {
-                std::stringstream ss;
-                ss << out.tv.sampleRate[0] << " " << out.tv.sampleRate[1];
-                info.tags["TV Sample Rate"] = ss.str();
-            }
-            if (isValid(&out.tv.frameRate) && out.tv.frameRate > _minSpeed)
-            {
-                info.videoDuration = otime::RationalTime(1.0, out.tv.frameRate);
-                std::stringstream ss;
-                ss << out.tv.frameRate;
-                info.tags["TV Frame Rate"] = ss.str();
-            }
-            if (isValid(&out.tv.timeOffset))
-            {
-                std::stringstream ss;
-                ss << out.tv.timeOffset;
-                info.tags["TV Time Offset"] = ss.str();
-            }
-            if (isValid(&out.tv.gamma))
-            {
-                std::stringstream ss;
-                ss << out.tv.gamma;
-                info.tags["TV Gamma"] = ss.str();
-            }
-            if (isValid(&out.tv.blackLevel))
-            {
-                std::stringstream ss;
-                ss << out.tv.blackLevel;
-                info.tags["TV Black Level"] = ss.str();
-            }
-            if (isValid(&out.tv.blackGain))
-            {
-                std::stringstream ss;
-                ss << out.tv.blackGain;
-                info.tags["TV Black Gain"] = ss.str();
-            }
-            if (isValid(&out.tv.breakpoint))
-            {
-                std::stringstream ss;
-                ss << out.tv.breakpoint;
-                info.tags["TV Breakpoint"] = ss.str();
-            }
-            if (isValid(&out.tv.whiteLevel))
-            {
-                std::stringstream ss;
-                ss << out.tv.whiteLevel;
-                info.tags["TV White Level"] = ss.str();
-            }
-            if (isValid(&out.tv.integrationTimes))
-            {
-                std::stringstream ss;
-                ss << out.tv.integrationTimes;
-                info.tags["TV Integration Times"] = ss.str();
-            }
+            getTags(out, info);
 
             // Set the file position.
             if (out.file.imageOffset)
@@ -551,6 +554,18 @@ namespace tlr
             return out;
         }
 
+        void readTags(Header header, avio::Info& info)
+        {
+            const memory::Endian fileEndian = 0 == memcmp(&header.file.magic, magic[0], 4) ?
+                memory::Endian::MSB :
+                memory::Endian::LSB;
+            if (fileEndian != memory::getEndian())
+            {
+                convertEndian(header);
+            }
+            getTags(header, info);
+        }
+
         void write(
             const std::shared_ptr<file::FileIO>& io,
             const avio::Info& info,
@@ -921,7 +936,7 @@ namespace tlr
             const file::Path& path,
             const avio::Options& options)
         {
-            return Read::create(path, avio::merge(options, _options), _logSystem);
+            return Read::create(path, avio::merge(options, _options), _cache, _threadPool, _logSystem);
         }
 
         std::vector<imaging::PixelType> Plugin::getWritePixelTypes() const
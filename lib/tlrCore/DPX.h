@@ -274,6 +274,10 @@ namespace tlr
             avio::Info&,
             Transfer&);
 
+        //! Get the tags and speed from a header that was read from a file
+        //! without converting the endian.
+        void readTags(Header, avio::Info&);
+
         //! Write a header.
         void write(
             const std::shared_ptr<file::FileIO>&,
@@ -286,12 +290,20 @@ namespace tlr
         void finishWrite(const std::shared_ptr<file::FileIO>&);
 
         //! DPX reader.
+        //!
+        //! The header layout of the last frame read is cached. Frames with
+        //! the same magic number, image offset, file size, and image header
+        //! reuse the cached image information, and only the per-frame
+        //! sections of the header are parsed for the tags. Other frames fall
+        //! back to parsing the whole header.
         class Read : public avio::ISequenceRead
         {
         protected:
             void _init(
                 const file::Path&,
                 const avio::Options&,
+                const std::shared_ptr<avio::Cache>&,
+                const std::shared_ptr<core::ThreadPool>&,
                 const std::shared_ptr<core::LogSystem>&);
             Read();
 
@@ -302,13 +314,28 @@ namespace tlr
             static std::shared_ptr<Read> create(
                 const file::Path&,
                 const avio::Options&,
+                const std::shared_ptr<avio::Cache>&,
+                const std::shared_ptr<core::ThreadPool>&,
                 const std::shared_ptr<core::LogSystem>&);
 
         protected:
             avio::Info _getInfo(const std::string& fileName) override;
             avio::VideoFrame _readVideoFrame(
                 const std::string& fileName,
-                const otime::RationalTime&) override;
+                const otime::RationalTime&,
+                uint16_t proxyLevel) override;
+            std::vector<avio::VideoFrame> _readVideoFrames(
+                const std::vector<std::string>& fileNames,
+                const std::vector<otime::RationalTime>&,
+                uint16_t proxyLevel) override;
+
+        private:
+            void _readHeader(
+                const std::shared_ptr<file::FileIO>&,
+                avio::Info&,
+                size_t& imageOffset);
+
+            TLR_PRIVATE();
         };
 
         //! DPX writer.
@@ -55,7 +55,7 @@ namespace tlr
             Transfer transfer = Transfer::FilmPrint;
             write(io, info, version, endian, transfer);
 
-            io->write(image->getData(), imaging::getDataByteCount(image->getInfo()));
+            io->write(imaging::pack(image)->getData(), imaging::getDataByteCount(image->getInfo()));
             finishWrite(io);
         }
     }
@@ -83,7 +83,7 @@ namespace tlr
             const file::Path& path,
             const avio::Options& options)
         {
-            return Read::create(path, avio::merge(options, _options), _logSystem);
+            return Read::create(path, avio::merge(options, _options), _cache, _threadPool, _logSystem);
         }
 
         std::vector<imaging::PixelType> Plugin::getWritePixelTypes() const
@@ -37,6 +37,21 @@ namespace tlr
         //! Number of threads.
         const size_t threadCount = 4;
 
+        //! Default number of frames kept for backward playback.
+        const size_t gopCacheSize = 60;
+
+        //! Default number of frames decoded ahead while the reader is idle.
+        const size_t readAheadFrames = 8;
+
+        //! Default maximum size of the frames decoded ahead.
+        const size_t readAheadByteCount = memory::megabyte * 256;
+
+        //! Default number of decoders for intra-only streams.
+        const size_t decoderCount = 4;
+
+        //! Default number of decoders for streams with key frames.
+        const size_t gopDecoderCount = 1;
+
         //! Timeout for frame requests.
         const std::chrono::microseconds requestTimeout(1000);
 
@@ -50,12 +65,39 @@ namespace tlr
         AVRational swap(AVRational);
 
         //! FFmpeg reader
+        //!
+        //! Unless the "ffmpeg/KeyFrameIndex" option is disabled, an index of
+        //! the key frames is built in the background after the file is
+        //! opened. Random access seeks to the key frame preceding the
+        //! requested frame, and requests ahead of the current frame in the
+        //! same GOP are decoded without seeking. Intra-only streams are not
+        //! indexed.
+        //!
+        //! When playing backward, the frames decoded on the way to the
+        //! requested frame are kept in a cache of "ffmpeg/GOPCacheSize"
+        //! frames, and the previous GOP is decoded while the reader is idle.
+        //! When playing forward, up to "ffmpeg/ReadAheadFrames" frames past
+        //! the last requested frame, and at most "ffmpeg/ReadAheadByteCount"
+        //! bytes, are decoded while the reader is idle. Setting either limit
+        //! to zero disables reading ahead.
+        //!
+        //! Intra-only streams are decoded by a pool of "ffmpeg/DecoderCount"
+        //! decoders, each with its own demuxer and thread. Streams with key
+        //! frames use "ffmpeg/GOPDecoderCount" decoders, which requires the
+        //! key frame index. Until the index is complete and has found no
+        //! open GOPs (frames that follow a key frame in decoding order but
+        //! are displayed before it), all of the requests are decoded by the
+        //! first decoder. Requests in the same GOP are decoded by the same
+        //! decoder. The GOP cache and reading ahead are only used with a
+        //! single decoder.
         class Read : public avio::IRead
         {
         protected:
             void _init(
                 const file::Path&,
                 const avio::Options&,
+                const std::shared_ptr<avio::Cache>&,
+                const std::shared_ptr<core::ThreadPool>&,
                 const std::shared_ptr<core::LogSystem>&);
             Read();
 
@@ -66,18 +108,28 @@ namespace tlr
             static std::shared_ptr<Read> create(
                 const file::Path&,
                 const avio::Options&,
+                const std::shared_ptr<avio::Cache>&,
+                const std::shared_ptr<core::ThreadPool>&,
                 const std::shared_ptr<core::LogSystem>&);
 
             std::future<avio::Info> getInfo() override;
-            std::future<avio::VideoFrame> readVideoFrame(const otime::RationalTime&) override;
+            std::future<avio::VideoFrame> readVideoFrame(
+                const otime::RationalTime&,
+                int64_t priority = 0,
+                const imaging::Size& size = imaging::Size()) override;
             bool hasVideoFrames() override;
             void cancelVideoFrames() override;
             void stop() override;
             bool hasStopped() const override;
 
+            //! Get the number of frames that were taken from the video frame
+            //! buffer without decoding, for example after reading ahead.
+            size_t getBufferedFrameCount() const;
+
         private:
             void _open(const std::string& fileName);
             void _run();
+            void _runDecoder(size_t index);
             void _close();
 
             TLR_PRIVATE();
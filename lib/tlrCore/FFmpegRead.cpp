@@ -4,6 +4,7 @@
 
 #include <tlrCore/FFmpeg.h>
 
+#include <tlrCore/AVIOCache.h>
 #include <tlrCore/Assert.h>
 #include <tlrCore/String.h>
 #include <tlrCore/StringFormat.h>
@@ -11,10 +12,11 @@
 extern "C"
 {
 #include <libavutil/dict.h>
-#include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
 
 } // extern "C"
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <cstring>
@@ -28,10 +30,125 @@ namespace tlr
 {
     namespace ffmpeg
     {
+        namespace
+        {
+            imaging::PixelType fromAVPixelFormat(AVPixelFormat value)
+            {
+                imaging::PixelType out = imaging::PixelType::None;
+                switch (value)
+                {
+                case AV_PIX_FMT_YUV420P: out = imaging::PixelType::YUV_420P; break;
+                case AV_PIX_FMT_YUV422P: out = imaging::PixelType::YUV_422P; break;
+                case AV_PIX_FMT_YUV444P: out = imaging::PixelType::YUV_444P; break;
+                case AV_PIX_FMT_YUV420P10: out = imaging::PixelType::YUV_420P_U10; break;
+                case AV_PIX_FMT_YUV422P10: out = imaging::PixelType::YUV_422P_U10; break;
+                case AV_PIX_FMT_YUV444P10: out = imaging::PixelType::YUV_444P_U10; break;
+                case AV_PIX_FMT_YUV420P16: out = imaging::PixelType::YUV_420P_U16; break;
+                case AV_PIX_FMT_YUV422P16: out = imaging::PixelType::YUV_422P_U16; break;
+                case AV_PIX_FMT_YUV444P16: out = imaging::PixelType::YUV_444P_U16; break;
+                case AV_PIX_FMT_RGB24: out = imaging::PixelType::RGB_U8; break;
+                case AV_PIX_FMT_GRAY8: out = imaging::PixelType::L_U8; break;
+                case AV_PIX_FMT_RGBA: out = imaging::PixelType::RGBA_U8; break;
+                default: break;
+                }
+                return out;
+            }
+
+            AVPixelFormat toAVPixelFormat(imaging::PixelType value)
+            {
+                AVPixelFormat out = AV_PIX_FMT_NONE;
+                switch (value)
+                {
+                case imaging::PixelType::YUV_420P: out = AV_PIX_FMT_YUV420P; break;
+                case imaging::PixelType::YUV_422P: out = AV_PIX_FMT_YUV422P; break;
+                case imaging::PixelType::YUV_444P: out = AV_PIX_FMT_YUV444P; break;
+                case imaging::PixelType::YUV_420P_U10: out = AV_PIX_FMT_YUV420P10; break;
+                case imaging::PixelType::YUV_422P_U10: out = AV_PIX_FMT_YUV422P10; break;
+                case imaging::PixelType::YUV_444P_U10: out = AV_PIX_FMT_YUV444P10; break;
+                case imaging::PixelType::YUV_420P_U16: out = AV_PIX_FMT_YUV420P16; break;
+                case imaging::PixelType::YUV_422P_U16: out = AV_PIX_FMT_YUV422P16; break;
+                case imaging::PixelType::YUV_444P_U16: out = AV_PIX_FMT_YUV444P16; break;
+                case imaging::PixelType::RGB_U8: out = AV_PIX_FMT_RGB24; break;
+                case imaging::PixelType::L_U8: out = AV_PIX_FMT_GRAY8; break;
+                case imaging::PixelType::RGBA_U8: out = AV_PIX_FMT_RGBA; break;
+                default: break;
+                }
+                return out;
+            }
+
+            imaging::YUVCoefficients fromAVColorSpace(AVColorSpace value, const imaging::Size& size)
+            {
+                imaging::YUVCoefficients out = imaging::YUVCoefficients::BT601;
+                switch (value)
+                {
+                case AVCOL_SPC_BT709: out = imaging::YUVCoefficients::BT709; break;
+                case AVCOL_SPC_BT2020_NCL:
+                case AVCOL_SPC_BT2020_CL: out = imaging::YUVCoefficients::BT2020; break;
+                case AVCOL_SPC_UNSPECIFIED:
+                    // Guess from the image size like most players do.
+                    out = size.w >= 1280 || size.h > 576 ?
+                        imaging::YUVCoefficients::BT709 :
+                        imaging::YUVCoefficients::BT601;
+                    break;
+                default: break;
+                }
+                return out;
+            }
+        }
+
+
         struct Read::Private
         {
-            int decodeVideo(AVPacket*, const otime::RationalTime& seek);
-            void copyVideo(const std::shared_ptr<imaging::Image>&);
+            //! A decoder with its own demuxer.
+            struct Decoder
+            {
+                ~Decoder();
+
+                AVFormatContext* avFormatContext = nullptr;
+                AVCodecContext* avCodecContext = nullptr;
+                AVFrame* avFrame = nullptr;
+                AVFrame* avFrame2 = nullptr;
+                SwsContext* swsContext = nullptr;
+                SwsContext* swsProxyContext = nullptr;
+
+                otime::RationalTime currentTime = time::invalidTime;
+                imaging::Size proxySize;
+                std::list<avio::VideoFrame> videoFrameBuffer;
+
+                // After seeking the video packets before this key frame are
+                // skipped.
+                int64_t seekKeyFrameDts = AV_NOPTS_VALUE;
+
+                // The key frame of the GOP this decoder is decoding, which is
+                // guarded by the request mutex.
+                int64_t keyFramePts = AV_NOPTS_VALUE;
+            };
+            std::vector<std::unique_ptr<Decoder> > decoders;
+            int openCodec(Decoder&);
+            bool openDecoder(const std::string& fileName, Decoder&);
+
+            imaging::Size getProxySize(uint16_t proxyLevel) const;
+            avio::VideoFrame decodeFrame(Decoder&, const otime::RationalTime&);
+            void seek(Decoder&, const otime::RationalTime&);
+            void decode(Decoder&, const otime::RationalTime&);
+            int decodeVideo(Decoder&, AVPacket*, const otime::RationalTime& seek);
+            std::shared_ptr<imaging::Image> createImage(Decoder&, const imaging::Info&);
+            void copyVideo(Decoder&, const std::shared_ptr<imaging::Image>&);
+            void addGOPCache(const avio::VideoFrame&);
+            void prefetchGOP();
+            bool isReadAhead() const;
+            void readAhead();
+
+            struct KeyFrame
+            {
+                int64_t pts = 0;
+                int64_t dts = 0;
+            };
+            void indexKeyFrames(const std::string& fileName);
+            bool findKeyFrame(int64_t pts, KeyFrame&);
+            int64_t getKeyFramePts(const otime::RationalTime&);
+            int64_t getPts(const otime::RationalTime&) const;
+            bool isGOPIndependent();
 
             avio::Info info;
             std::promise<avio::Info> infoPromise;
@@ -41,21 +158,53 @@ namespace tlr
                 VideoFrameRequest(VideoFrameRequest&&) = default;
 
                 otime::RationalTime time = time::invalidTime;
+                int64_t priority = 0;
+                imaging::Size size;
                 std::promise<avio::VideoFrame> promise;
             };
             std::list<VideoFrameRequest> videoFrameRequests;
+            std::list<VideoFrameRequest>::iterator findRequest(const Decoder&);
             std::condition_variable requestCV;
             std::mutex requestMutex;
-            otime::RationalTime currentTime = time::invalidTime;
-            std::list<std::shared_ptr<imaging::Image> > imageBuffer;
 
-            AVFormatContext* avFormatContext = nullptr;
+            // The key frame index is built by demuxing the file in another
+            // thread. Only the time stamps up to the end are indexed until
+            // the index is complete.
+            bool keyFrameIndexEnabled = true;
+            bool intraOnly = false;
+            struct KeyFrameIndex
+            {
+                std::vector<KeyFrame> keyFrames;
+                int64_t end = AV_NOPTS_VALUE;
+                bool complete = false;
+                bool openGOP = false;
+                std::mutex mutex;
+            };
+            KeyFrameIndex keyFrameIndex;
+            std::thread keyFrameIndexThread;
+
+            // When playing backward, the frames that are decoded before the
+            // requested frame are kept in the GOP cache.
+            std::map<otime::RationalTime, avio::VideoFrame> gopCache;
+            size_t gopCacheSize = ffmpeg::gopCacheSize;
+            otime::RationalTime lastTime = time::invalidTime;
+            bool backward = false;
+            otime::RationalTime prefetchTime = time::invalidTime;
+
+            // When playing forward, the frames after the last request are
+            // decoded into the video frame buffer while the reader is idle.
+            size_t readAheadFrames = ffmpeg::readAheadFrames;
+            size_t readAheadByteCount = ffmpeg::readAheadByteCount;
+            bool readAheadEnd = false;
+            std::atomic<size_t> bufferedFrameCount;
+
+            size_t decoderCount = ffmpeg::decoderCount;
+            size_t gopDecoderCount = ffmpeg::gopDecoderCount;
+
             int avVideoStream = -1;
             std::map<int, AVCodecParameters*> avCodecParameters;
-            std::map<int, AVCodecContext*> avCodecContext;
-            AVFrame* avFrame = nullptr;
-            AVFrame* avFrame2 = nullptr;
-            SwsContext* swsContext = nullptr;
+            AVRational avTimeBase = { 0, 1 };
+            AVRational avFrameRate = { 0, 1 };
 
             std::thread thread;
             std::atomic<bool> running;
@@ -63,22 +212,90 @@ namespace tlr
             size_t threadCount = ffmpeg::threadCount;
         };
 
+        Read::Private::Decoder::~Decoder()
+        {
+            if (swsContext)
+            {
+                sws_freeContext(swsContext);
+            }
+            if (swsProxyContext)
+            {
+                sws_freeContext(swsProxyContext);
+            }
+            if (avFrame2)
+            {
+                av_frame_free(&avFrame2);
+            }
+            if (avFrame)
+            {
+                av_frame_free(&avFrame);
+            }
+            if (avCodecContext)
+            {
+                avcodec_close(avCodecContext);
+                avcodec_free_context(&avCodecContext);
+            }
+            if (avFormatContext)
+            {
+                avformat_close_input(&avFormatContext);
+            }
+        }
+
         void Read::_init(
             const file::Path& path,
             const avio::Options& options,
+            const std::shared_ptr<avio::Cache>& cache,
+            const std::shared_ptr<core::ThreadPool>& threadPool,
             const std::shared_ptr<core::LogSystem>& logSystem)
         {
-            IRead::_init(path, options, logSystem);
+            IRead::_init(path, options, cache, threadPool, logSystem);
 
             TLR_PRIVATE_P();
 
-            const auto i = options.find("ffmpeg/ThreadCount");
+            auto i = options.find("ffmpeg/ThreadCount");
             if (i != options.end())
             {
                 std::stringstream ss(i->second);
                 ss >> p.threadCount;
             }
+            i = options.find("ffmpeg/KeyFrameIndex");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.keyFrameIndexEnabled;
+            }
+            i = options.find("ffmpeg/GOPCacheSize");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.gopCacheSize;
+            }
+            i = options.find("ffmpeg/ReadAheadFrames");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.readAheadFrames;
+            }
+            i = options.find("ffmpeg/ReadAheadByteCount");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.readAheadByteCount;
+            }
+            i = options.find("ffmpeg/DecoderCount");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.decoderCount;
+            }
+            i = options.find("ffmpeg/GOPDecoderCount");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.gopDecoderCount;
+            }
 
+            p.bufferedFrameCount = 0;
             p.running = true;
             p.stopped = false;
             p.thread = std::thread(
@@ -125,10 +342,12 @@ namespace tlr
         std::shared_ptr<Read> Read::create(
             const file::Path& path,
             const avio::Options& options,
+            const std::shared_ptr<avio::Cache>& cache,
+            const std::shared_ptr<core::ThreadPool>& threadPool,
             const std::shared_ptr<core::LogSystem>& logSystem)
         {
             auto out = std::shared_ptr<Read>(new Read);
-            out->_init(path, options, logSystem);
+            out->_init(path, options, cache, threadPool, logSystem);
             return out;
         }
 
@@ -137,19 +356,29 @@ namespace tlr
             return _p->infoPromise.get_future();
         }
 
-        std::future<avio::VideoFrame> Read::readVideoFrame(const otime::RationalTime& time)
+        std::future<avio::VideoFrame> Read::readVideoFrame(
+            const otime::RationalTime& time,
+            int64_t priority,
+            const imaging::Size& size)
         {
             TLR_PRIVATE_P();
             Private::VideoFrameRequest request;
             request.time = time;
+            request.priority = priority;
+            request.size = size;
             auto future = request.promise.get_future();
             if (!p.stopped)
             {
                 {
                     std::unique_lock<std::mutex> lock(p.requestMutex);
-                    p.videoFrameRequests.push_back(std::move(request));
+                    auto i = p.videoFrameRequests.begin();
+                    while (i != p.videoFrameRequests.end() && i->priority <= priority)
+                    {
+                        ++i;
+                    }
+                    p.videoFrameRequests.insert(i, std::move(request));
                 }
-                p.requestCV.notify_one();
+                p.requestCV.notify_all();
             }
             else
             {
@@ -182,11 +411,18 @@ namespace tlr
             return _p->stopped;
         }
 
+        size_t Read::getBufferedFrameCount() const
+        {
+            return _p->bufferedFrameCount;
+        }
+
         void Read::_open(const std::string& fileName)
         {
             TLR_PRIVATE_P();
+            p.decoders.push_back(std::unique_ptr<Private::Decoder>(new Private::Decoder));
+            auto& decoder = *p.decoders[0];
             int r = avformat_open_input(
-                &p.avFormatContext,
+                &decoder.avFormatContext,
                 fileName.c_str(),
                 nullptr,
                 nullptr);
@@ -194,16 +430,16 @@ namespace tlr
             {
                 throw std::runtime_error(string::Format("{0}: {1}").arg(fileName).arg(getErrorLabel(r)));
             }
-            r = avformat_find_stream_info(p.avFormatContext, 0);
+            r = avformat_find_stream_info(decoder.avFormatContext, 0);
             if (r < 0)
             {
                 throw std::runtime_error(string::Format("{0}: {1}").arg(fileName).arg(getErrorLabel(r)));
             }
-            //av_dump_format(p.avFormatContext, 0, fileName.c_str(), 0);
+            //av_dump_format(decoder.avFormatContext, 0, fileName.c_str(), 0);
 
-            for (unsigned int i = 0; i < p.avFormatContext->nb_streams; ++i)
+            for (unsigned int i = 0; i < decoder.avFormatContext->nb_streams; ++i)
             {
-                if (-1 == p.avVideoStream && p.avFormatContext->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
+                if (-1 == p.avVideoStream && decoder.avFormatContext->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
                 {
                     p.avVideoStream = i;
                 }
@@ -213,72 +449,61 @@ namespace tlr
                 throw std::runtime_error(string::Format("{0}: No video stream found").arg(fileName));
             }
 
-            p.avFrame = av_frame_alloc();
-
             std::size_t sequenceSize = 0;
             if (p.avVideoStream != -1)
             {
-                auto avVideoStream = p.avFormatContext->streams[p.avVideoStream];
+                auto avVideoStream = decoder.avFormatContext->streams[p.avVideoStream];
                 auto avVideoCodecParameters = avVideoStream->codecpar;
-                auto avVideoCodec = avcodec_find_decoder(avVideoCodecParameters->codec_id);
-                if (!avVideoCodec)
-                {
-                    throw std::runtime_error(string::Format("{0}: No video codec found").arg(fileName));
-                }
                 p.avCodecParameters[p.avVideoStream] = avcodec_parameters_alloc();
                 r = avcodec_parameters_copy(p.avCodecParameters[p.avVideoStream], avVideoCodecParameters);
                 if (r < 0)
                 {
                     throw std::runtime_error(string::Format("{0}: {1}").arg(fileName).arg(getErrorLabel(r)));
                 }
-                p.avCodecContext[p.avVideoStream] = avcodec_alloc_context3(avVideoCodec);
-                r = avcodec_parameters_to_context(p.avCodecContext[p.avVideoStream], p.avCodecParameters[p.avVideoStream]);
-                if (r < 0)
-                {
-                    throw std::runtime_error(string::Format("{0}: {1}").arg(fileName).arg(getErrorLabel(r)));
-                }
-                p.avCodecContext[p.avVideoStream]->thread_count = p.threadCount;
-                p.avCodecContext[p.avVideoStream]->thread_type = FF_THREAD_FRAME;
-                r = avcodec_open2(p.avCodecContext[p.avVideoStream], avVideoCodec, 0);
-                if (r < 0)
-                {
-                    throw std::runtime_error(string::Format("{0}: {1}").arg(fileName).arg(getErrorLabel(r)));
-                }
+                const AVCodecDescriptor* avCodecDescriptor = avcodec_descriptor_get(avVideoCodecParameters->codec_id);
+                p.intraOnly = avCodecDescriptor && (avCodecDescriptor->props & AV_CODEC_PROP_INTRA_ONLY);
+                p.avTimeBase = avVideoStream->time_base;
+                p.avFrameRate = avVideoStream->r_frame_rate;
 
                 imaging::Info videoInfo;
                 videoInfo.size.w = p.avCodecParameters[p.avVideoStream]->width;
                 videoInfo.size.h = p.avCodecParameters[p.avVideoStream]->height;
 
+                // Pixel formats without a matching pixel type are converted
+                // to 8-bit 4:2:0 YUV, or 16-bit 4:4:4 YUV if they have more
+                // than 8 bits per component.
                 const AVPixelFormat avPixelFormat = static_cast<AVPixelFormat>(p.avCodecParameters[p.avVideoStream]->format);
-                switch (avPixelFormat)
+                videoInfo.pixelType = fromAVPixelFormat(avPixelFormat);
+                if (imaging::PixelType::None == videoInfo.pixelType)
                 {
-                case AV_PIX_FMT_YUV420P:
-                    videoInfo.pixelType = imaging::PixelType::YUV_420P;
-                    break;
-                case AV_PIX_FMT_RGB24:
-                    videoInfo.pixelType = imaging::PixelType::RGB_U8;
-                    break;
-                case AV_PIX_FMT_GRAY8:
-                    videoInfo.pixelType = imaging::PixelType::L_U8;
-                    break;
-                case AV_PIX_FMT_RGBA:
-                    videoInfo.pixelType = imaging::PixelType::RGBA_U8;
-                    break;
-                default:
-                    videoInfo.pixelType = imaging::PixelType::YUV_420P;
-                    p.avFrame2 = av_frame_alloc();
-                    p.swsContext = sws_getContext(
-                        p.avCodecParameters[p.avVideoStream]->width,
-                        p.avCodecParameters[p.avVideoStream]->height,
-                        avPixelFormat,
-                        p.avCodecParameters[p.avVideoStream]->width,
-                        p.avCodecParameters[p.avVideoStream]->height,
-                        AV_PIX_FMT_YUV420P,
-                        swsScaleFlags,
-                        0,
-                        0,
-                        0);
-                    break;
+                    const AVPixFmtDescriptor* avPixFmtDescriptor = av_pix_fmt_desc_get(avPixelFormat);
+                    videoInfo.pixelType = avPixFmtDescriptor && avPixFmtDescriptor->comp[0].depth > 8 ?
+                        imaging::PixelType::YUV_444P_U16 :
+                        imaging::PixelType::YUV_420P;
+                }
+
+                // The YUV range and coefficients are taken from the codec
+                // parameters. Converted pixel formats are output by the
+                // software scaler in the limited range, and RGB pixel
+                // formats are converted with the BT.601 coefficients.
+                if (imaging::isYUV(videoInfo.pixelType))
+                {
+                    const auto avVideoCodecParameters = p.avCodecParameters[p.avVideoStream];
+                    const bool converted = fromAVPixelFormat(avPixelFormat) != videoInfo.pixelType;
+                    videoInfo.yuvRange = !converted && AVCOL_RANGE_JPEG == avVideoCodecParameters->color_range ?
+                        imaging::YUVRange::Full :
+                        imaging::YUVRange::Limited;
+                    const AVPixFmtDescriptor* avPixFmtDescriptor = av_pix_fmt_desc_get(avPixelFormat);
+                    if (avPixFmtDescriptor && (avPixFmtDescriptor->flags & AV_PIX_FMT_FLAG_RGB))
+                    {
+                        videoInfo.yuvCoefficients = imaging::YUVCoefficients::BT601;
+                    }
+                    else
+                    {
+                        videoInfo.yuvCoefficients = fromAVColorSpace(
+                            avVideoCodecParameters->color_space,
+                            videoInfo.size);
+                    }
                 }
 
                 if (avVideoStream->duration != AV_NOPTS_VALUE)
@@ -288,10 +513,10 @@ namespace tlr
                         avVideoStream->time_base,
                         swap(avVideoStream->r_frame_rate));
                 }
-                else if (p.avFormatContext->duration != AV_NOPTS_VALUE)
+                else if (decoder.avFormatContext->duration != AV_NOPTS_VALUE)
                 {
                     sequenceSize = av_rescale_q(
-                        p.avFormatContext->duration,
+                        decoder.avFormatContext->duration,
                         av_get_time_base_q(),
                         swap(avVideoStream->r_frame_rate));
                 }
@@ -300,30 +525,97 @@ namespace tlr
                     sequenceSize,
                     avVideoStream->r_frame_rate.num / double(avVideoStream->r_frame_rate.den));
 
-                p.currentTime = otime::RationalTime(0, p.info.videoDuration.rate());
+                r = p.openCodec(decoder);
+                if (r < 0)
+                {
+                    throw std::runtime_error(string::Format("{0}: {1}").arg(fileName).arg(getErrorLabel(r)));
+                }
+                decoder.currentTime = otime::RationalTime(0, p.info.videoDuration.rate());
             }
 
             AVDictionaryEntry* tag = nullptr;
-            while ((tag = av_dict_get(p.avFormatContext->metadata, "", tag, AV_DICT_IGNORE_SUFFIX)))
+            while ((tag = av_dict_get(decoder.avFormatContext->metadata, "", tag, AV_DICT_IGNORE_SUFFIX)))
             {
                 p.info.tags[tag->key] = tag->value;
             }
 
             p.infoPromise.set_value(p.info);
+
+            // Every frame of an intra-only stream is a key frame, so they do
+            // not need an index.
+            if (p.keyFrameIndexEnabled && !p.intraOnly)
+            {
+                p.keyFrameIndexThread = std::thread(
+                    [this, fileName]
+                    {
+                        _p->indexKeyFrames(fileName);
+                    });
+            }
         }
 
         void Read::_run()
         {
             TLR_PRIVATE_P();
+
+            // Open the other decoders of the pool. Streams with key frames
+            // need the index to find the GOP of each request.
+            const size_t decoderCount =
+                p.intraOnly ? p.decoderCount :
+                (p.keyFrameIndexEnabled ? p.gopDecoderCount : 1);
+            while (p.running && p.decoders.size() < decoderCount)
+            {
+                std::unique_ptr<Private::Decoder> decoder(new Private::Decoder);
+                if (!p.openDecoder(_path.get(), *decoder))
+                {
+                    break;
+                }
+                p.decoders.push_back(std::move(decoder));
+            }
+            if (p.decoders.size() > 1)
+            {
+                std::vector<std::thread> threads;
+                for (size_t i = 1; i < p.decoders.size(); ++i)
+                {
+                    threads.push_back(std::thread(
+                        [this, i]
+                        {
+                            try
+                            {
+                                _runDecoder(i);
+                            }
+                            catch (const std::exception&)
+                            {
+                                //! \todo How should this be handled?
+                            }
+                        }));
+                }
+                try
+                {
+                    _runDecoder(0);
+                }
+                catch (const std::exception&)
+                {
+                    p.running = false;
+                }
+                for (auto& i : threads)
+                {
+                    i.join();
+                }
+                return;
+            }
+
+            auto& decoder = *p.decoders[0];
             while (p.running)
             {
                 Private::VideoFrameRequest request;
                 bool requestValid = false;
                 {
+                    // Don't wait for requests while there are frames to
+                    // read ahead.
                     std::unique_lock<std::mutex> lock(p.requestMutex);
                     p.requestCV.wait_for(
                         lock,
-                        requestTimeout,
+                        p.isReadAhead() ? std::chrono::microseconds(0) : requestTimeout,
                         [this]
                         {
                             return !_p->videoFrameRequests.empty();
@@ -331,6 +623,7 @@ namespace tlr
                     if (!p.videoFrameRequests.empty())
                     {
                         request.time = p.videoFrameRequests.front().time;
+                        request.size = p.videoFrameRequests.front().size;
                         request.promise = std::move(p.videoFrameRequests.front().promise);
                         p.videoFrameRequests.pop_front();
                         requestValid = true;
@@ -339,95 +632,135 @@ namespace tlr
                 if (requestValid)
                 {
                     //std::cout << "request: " << request.time << std::endl;
+                    const uint16_t proxyLevel = imaging::getProxyLevel(p.info.video[0].size, request.size);
+                    const imaging::Size proxySize = p.getProxySize(proxyLevel);
+
+                    if (p.lastTime != time::invalidTime && request.time != p.lastTime)
+                    {
+                        p.backward = request.time < p.lastTime;
+                    }
+                    p.lastTime = request.time;
+                    p.readAheadEnd = false;
+
                     avio::VideoFrame videoFrame;
+                    const avio::CacheKey cacheKey(
+                        _path.get(),
+                        static_cast<int64_t>(request.time.value()),
+                        imaging::PixelType::None,
+                        proxyLevel);
+                    if (_cache && _cache->get(cacheKey, videoFrame))
+                    {
+                        request.promise.set_value(videoFrame);
+                        continue;
+                    }
 
-                    if (request.time != p.currentTime)
+                    // Frames that were decoded for a different proxy level
+                    // are decoded again.
+                    if (proxySize != decoder.proxySize)
                     {
-                        //std::cout << "seek: " << request.time << std::endl;
-                        p.currentTime = request.time;
-                        p.imageBuffer.clear();
-                        int64_t t = 0;
-                        int stream = -1;
-                        if (p.avVideoStream != -1)
+                        decoder.proxySize = proxySize;
+                        p.gopCache.clear();
+                        if (!decoder.videoFrameBuffer.empty())
                         {
-                            avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
-                            stream = p.avVideoStream;
-                            t = av_rescale_q(
-                                request.time.value(),
-                                swap(p.avFormatContext->streams[p.avVideoStream]->r_frame_rate),
-                                p.avFormatContext->streams[p.avVideoStream]->time_base);
+                            decoder.videoFrameBuffer.clear();
+                            decoder.currentTime = time::invalidTime;
                         }
-                        if (av_seek_frame(
-                            p.avFormatContext,
-                            stream,
-                            t,
-                            AVSEEK_FLAG_BACKWARD) < 0)
+                    }
+
+                    const auto gopCacheIt = p.gopCache.find(request.time);
+                    if (gopCacheIt != p.gopCache.end())
+                    {
+                        videoFrame.time = request.time;
+                        videoFrame.image = gopCacheIt->second.image;
+                        if (_cache)
                         {
-                            //! \todo How should this be handled?
+                            _cache->add(cacheKey, videoFrame);
                         }
+                        request.promise.set_value(videoFrame);
+                        continue;
                     }
 
-                    if (p.imageBuffer.empty())
+                    videoFrame = p.decodeFrame(decoder, request.time);
+                    if (_cache && videoFrame.image)
                     {
-                        int decoding = 0;
-                        AVPacket packet;
-                        AVPacket* packetP = &packet;
-                        while (0 == decoding)
+                        _cache->add(cacheKey, videoFrame);
+                    }
+                    request.promise.set_value(videoFrame);
+                }
+                else if (p.backward)
+                {
+                    p.prefetchGOP();
+                }
+                else if (p.isReadAhead())
+                {
+                    p.readAhead();
+                }
+            }
+        }
+
+        void Read::_runDecoder(size_t index)
+        {
+            TLR_PRIVATE_P();
+            auto& decoder = *p.decoders[index];
+            while (p.running)
+            {
+                Private::VideoFrameRequest request;
+                bool requestValid = false;
+                {
+                    std::unique_lock<std::mutex> lock(p.requestMutex);
+                    auto i = p.videoFrameRequests.end();
+                    p.requestCV.wait_for(
+                        lock,
+                        requestTimeout,
+                        [this, &decoder, &i]
                         {
-                            if (packetP)
-                            {
-                                decoding = av_read_frame(p.avFormatContext, packetP);
-                                if (AVERROR_EOF == decoding)
-                                {
-                                    //avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
-                                    decoding = 0;
-                                    packetP = nullptr;
-                                }
-                                else if (decoding < 0)
-                                {
-                                    //! \todo How should this be handled?
-                                    break;
-                                }
-                            }
-                            if (p.avVideoStream == packet.stream_index)
-                            {
-                                decoding = avcodec_send_packet(p.avCodecContext[p.avVideoStream], packetP);
-                                if (AVERROR_EOF == decoding)
-                                {
-                                    //! \todo How should this be handled?
-                                    decoding = 0;
-                                }
-                                else if (decoding < 0)
-                                {
-                                    break;
-                                }
-                                decoding = p.decodeVideo(packetP, request.time);
-                                if (AVERROR(EAGAIN) == decoding || AVERROR_EOF == decoding)
-                                {
-                                    decoding = 0;
-                                }
-                                else if (decoding < 0)
-                                {
-                                    //! \todo How should this be handled?
-                                    break;
-                                }
-                            }
-                            if (packetP)
-                            {
-                                av_packet_unref(packetP);
-                            }
-                        }
+                            i = _p->findRequest(decoder);
+                            return i != _p->videoFrameRequests.end();
+                        });
+                    if (i != p.videoFrameRequests.end())
+                    {
+                        request.time = i->time;
+                        request.size = i->size;
+                        request.promise = std::move(i->promise);
+                        p.videoFrameRequests.erase(i);
+                        requestValid = true;
+                        decoder.keyFramePts = p.getKeyFramePts(request.time);
                     }
+                }
+                if (requestValid)
+                {
+                    //std::cout << index << " request: " << request.time << std::endl;
+                    const uint16_t proxyLevel = imaging::getProxyLevel(p.info.video[0].size, request.size);
+                    const imaging::Size proxySize = p.getProxySize(proxyLevel);
 
-                    if (!p.imageBuffer.empty())
+                    avio::VideoFrame videoFrame;
+                    const avio::CacheKey cacheKey(
+                        _path.get(),
+                        static_cast<int64_t>(request.time.value()),
+                        imaging::PixelType::None,
+                        proxyLevel);
+                    if (_cache && _cache->get(cacheKey, videoFrame))
                     {
-                        videoFrame.time = request.time;
-                        videoFrame.image = *p.imageBuffer.begin();
-                        p.imageBuffer.pop_front();
+                        request.promise.set_value(videoFrame);
+                        continue;
                     }
 
+                    if (proxySize != decoder.proxySize)
+                    {
+                        decoder.proxySize = proxySize;
+                        if (!decoder.videoFrameBuffer.empty())
+                        {
+                            decoder.videoFrameBuffer.clear();
+                            decoder.currentTime = time::invalidTime;
+                        }
+                    }
+
+                    videoFrame = p.decodeFrame(decoder, request.time);
+                    if (_cache && videoFrame.image)
+                    {
+                        _cache->add(cacheKey, videoFrame);
+                    }
                     request.promise.set_value(videoFrame);
-                    p.currentTime = request.time + otime::RationalTime(1.0, p.currentTime.rate());
                 }
             }
         }
@@ -435,39 +768,210 @@ namespace tlr
         void Read::_close()
         {
             TLR_PRIVATE_P();
-            if (p.swsContext)
+            if (p.keyFrameIndexThread.joinable())
             {
-                sws_freeContext(p.swsContext);
+                p.keyFrameIndexThread.join();
             }
-            if (p.avFrame2)
+            p.decoders.clear();
+            for (auto i : p.avCodecParameters)
             {
-                av_frame_free(&p.avFrame2);
+                avcodec_parameters_free(&i.second);
             }
-            if (p.avFrame)
+        }
+
+        int Read::Private::openCodec(Decoder& decoder)
+        {
+            auto avVideoCodec = avcodec_find_decoder(avCodecParameters[avVideoStream]->codec_id);
+            if (!avVideoCodec)
             {
-                av_frame_free(&p.avFrame);
+                return AVERROR_DECODER_NOT_FOUND;
             }
-            for (auto i : p.avCodecContext)
+            decoder.avCodecContext = avcodec_alloc_context3(avVideoCodec);
+            if (!decoder.avCodecContext)
             {
-                avcodec_close(i.second);
-                avcodec_free_context(&i.second);
+                return AVERROR(ENOMEM);
             }
-            for (auto i : p.avCodecParameters)
+            int r = avcodec_parameters_to_context(decoder.avCodecContext, avCodecParameters[avVideoStream]);
+            if (r < 0)
             {
-                avcodec_parameters_free(&i.second);
+                return r;
+            }
+            decoder.avCodecContext->thread_count = threadCount;
+            decoder.avCodecContext->thread_type = FF_THREAD_FRAME;
+            r = avcodec_open2(decoder.avCodecContext, avVideoCodec, 0);
+            if (r < 0)
+            {
+                return r;
+            }
+
+            decoder.avFrame = av_frame_alloc();
+            decoder.avFrame2 = av_frame_alloc();
+            if (!decoder.avFrame || !decoder.avFrame2)
+            {
+                return AVERROR(ENOMEM);
+            }
+
+            const auto& videoInfo = info.video[0];
+            const AVPixelFormat avPixelFormat = static_cast<AVPixelFormat>(avCodecParameters[avVideoStream]->format);
+            if (fromAVPixelFormat(avPixelFormat) != videoInfo.pixelType)
+            {
+                decoder.swsContext = sws_getContext(
+                    avCodecParameters[avVideoStream]->width,
+                    avCodecParameters[avVideoStream]->height,
+                    avPixelFormat,
+                    avCodecParameters[avVideoStream]->width,
+                    avCodecParameters[avVideoStream]->height,
+                    toAVPixelFormat(videoInfo.pixelType),
+                    swsScaleFlags,
+                    0,
+                    0,
+                    0);
+            }
+            return 0;
+        }
+
+        bool Read::Private::openDecoder(const std::string& fileName, Decoder& decoder)
+        {
+            // Each decoder of the pool demuxes the file separately, and only
+            // reads the video packets.
+            if (avformat_open_input(&decoder.avFormatContext, fileName.c_str(), nullptr, nullptr) < 0 ||
+                avformat_find_stream_info(decoder.avFormatContext, nullptr) < 0 ||
+                avVideoStream >= static_cast<int>(decoder.avFormatContext->nb_streams))
+            {
+                return false;
+            }
+            for (unsigned int i = 0; i < decoder.avFormatContext->nb_streams; ++i)
+            {
+                decoder.avFormatContext->streams[i]->discard = avVideoStream == static_cast<int>(i) ?
+                    AVDISCARD_DEFAULT :
+                    AVDISCARD_ALL;
+            }
+            return openCodec(decoder) >= 0;
+        }
+
+        imaging::Size Read::Private::getProxySize(uint16_t proxyLevel) const
+        {
+            // Proxies are scaled down while converting the decoded frames.
+            // YUV proxies keep an even size for the chroma planes.
+            const auto& videoInfo = info.video[0];
+            imaging::Size out = imaging::getProxySize(videoInfo.size, proxyLevel);
+            if (proxyLevel > 0 && imaging::isYUV(videoInfo.pixelType))
+            {
+                out.w = static_cast<uint16_t>(std::max(out.w & ~1, 2));
+                out.h = static_cast<uint16_t>(std::max(out.h & ~1, 2));
+            }
+            return out;
+        }
+
+        std::list<Read::Private::VideoFrameRequest>::iterator Read::Private::findRequest(const Decoder& decoder)
+        {
+            // Until the GOPs are known to be decoded independently, all of
+            // the requests are decoded by the first decoder.
+            if (&decoder != decoders[0].get() && !isGOPIndependent())
+            {
+                return videoFrameRequests.end();
+            }
+
+            // Prefer the requests that continue from the current frame or
+            // are in the same GOP.
+            for (auto i = videoFrameRequests.begin(); i != videoFrameRequests.end(); ++i)
+            {
+                if (i->time == decoder.currentTime ||
+                    (decoder.keyFramePts != AV_NOPTS_VALUE && getKeyFramePts(i->time) == decoder.keyFramePts))
+                {
+                    return i;
+                }
+            }
+
+            // Otherwise take the first request in a GOP that is not being
+            // decoded by another decoder.
+            for (auto i = videoFrameRequests.begin(); i != videoFrameRequests.end(); ++i)
+            {
+                const int64_t pts = getKeyFramePts(i->time);
+                bool claimed = false;
+                if (pts != AV_NOPTS_VALUE)
+                {
+                    for (const auto& j : decoders)
+                    {
+                        if (j.get() != &decoder && j->keyFramePts == pts)
+                        {
+                            claimed = true;
+                            break;
+                        }
+                    }
+                }
+                if (!claimed)
+                {
+                    return i;
+                }
+            }
+            return videoFrameRequests.end();
+        }
+
+        avio::VideoFrame Read::Private::decodeFrame(Decoder& decoder, const otime::RationalTime& time)
+        {
+            avio::VideoFrame out;
+            if (time != decoder.currentTime)
+            {
+                // When the requested frame has already been read ahead, or
+                // is ahead of the current frame in the same GOP, the frames
+                // in between are skipped or decoded instead of seeking.
+                KeyFrame keyFrame;
+                KeyFrame currentKeyFrame;
+                const bool buffered =
+                    !decoder.videoFrameBuffer.empty() &&
+                    time >= decoder.videoFrameBuffer.front().time &&
+                    time <= decoder.videoFrameBuffer.back().time;
+                const bool seek = !buffered && (
+                    backward ||
+                    decoder.currentTime == time::invalidTime ||
+                    time < decoder.currentTime ||
+                    !findKeyFrame(getPts(time), keyFrame) ||
+                    !findKeyFrame(getPts(decoder.currentTime), currentKeyFrame) ||
+                    currentKeyFrame.pts != keyFrame.pts);
+
+                //std::cout << "seek: " << time << std::endl;
+                decoder.currentTime = time;
+                if (seek)
+                {
+                    this->seek(decoder, time);
+                }
+                else
+                {
+                    while (!decoder.videoFrameBuffer.empty() &&
+                        decoder.videoFrameBuffer.front().time < time)
+                    {
+                        decoder.videoFrameBuffer.pop_front();
+                    }
+                }
+            }
+
+            if (decoder.videoFrameBuffer.empty())
+            {
+                decode(decoder, time);
+            }
+            else
+            {
+                ++bufferedFrameCount;
             }
-            if (p.avFormatContext)
+
+            if (!decoder.videoFrameBuffer.empty())
             {
-                avformat_close_input(&p.avFormatContext);
+                out.time = time;
+                out.image = decoder.videoFrameBuffer.front().image;
+                decoder.videoFrameBuffer.pop_front();
             }
+
+            decoder.currentTime = time + otime::RationalTime(1.0, time.rate());
+            return out;
         }
 
-        int Read::Private::decodeVideo(AVPacket* packet, const otime::RationalTime& seek)
+        int Read::Private::decodeVideo(Decoder& decoder, AVPacket* packet, const otime::RationalTime& seek)
         {
             int out = 0;
             while (0 == out)
             {
-                out = avcodec_receive_frame(avCodecContext[avVideoStream], avFrame);
+                out = avcodec_receive_frame(decoder.avCodecContext, decoder.avFrame);
                 if (out < 0)
                 {
                     return out;
@@ -476,101 +980,452 @@ namespace tlr
                 const auto& videoInfo = info.video[0];
                 const auto t = otime::RationalTime(
                     av_rescale_q(
-                        avFrame->pts,
-                        avFormatContext->streams[avVideoStream]->time_base,
-                        swap(avFormatContext->streams[avVideoStream]->r_frame_rate)),
+                        decoder.avFrame->pts,
+                        avTimeBase,
+                        swap(avFrameRate)),
                     info.videoDuration.rate());
-                if (t >= seek)
+                // When playing backward the frames before the requested
+                // frame are kept in the GOP cache.
+                const bool cache = t < seek && backward && gopCacheSize > 0;
+                if (t >= seek || cache)
                 {
                     //std::cout << "frame: " << t << std::endl;
-                    auto image = imaging::Image::create(videoInfo);
+                    imaging::Info imageInfo = videoInfo;
+                    imageInfo.size = decoder.proxySize;
+                    auto image = createImage(decoder, imageInfo);
                     image->setTags(info.tags);
-                    copyVideo(image);
-                    imageBuffer.push_back(image);
-                    out = 1;
+                    avio::VideoFrame videoFrame;
+                    videoFrame.time = t;
+                    videoFrame.image = image;
+                    if (cache)
+                    {
+                        addGOPCache(videoFrame);
+                    }
+                    else
+                    {
+                        decoder.videoFrameBuffer.push_back(videoFrame);
+                        out = 1;
+                    }
                 }
             }
             return out;
         }
 
-        void Read::Private::copyVideo(const std::shared_ptr<imaging::Image>& image)
+        void Read::Private::seek(Decoder& decoder, const otime::RationalTime& time)
+        {
+            decoder.videoFrameBuffer.clear();
+            avcodec_flush_buffers(decoder.avCodecContext);
+
+            // Seek to the preceding key frame. The seek time is the earliest
+            // time stamp of the key frame so the demuxer does not stop after
+            // it, and the packets before it are skipped.
+            const int64_t pts = getPts(time);
+            KeyFrame keyFrame;
+            const bool hasKeyFrame = findKeyFrame(pts, keyFrame);
+            decoder.seekKeyFrameDts = hasKeyFrame ? keyFrame.dts : AV_NOPTS_VALUE;
+            if (av_seek_frame(
+                decoder.avFormatContext,
+                avVideoStream,
+                hasKeyFrame ? std::min(keyFrame.pts, keyFrame.dts) : pts,
+                AVSEEK_FLAG_BACKWARD) < 0)
+            {
+                //! \todo How should this be handled?
+            }
+        }
+
+        void Read::Private::decode(Decoder& decoder, const otime::RationalTime& time)
+        {
+            int decoding = 0;
+            AVPacket packet;
+            AVPacket* packetP = &packet;
+            while (0 == decoding)
+            {
+                if (packetP)
+                {
+                    decoding = av_read_frame(decoder.avFormatContext, packetP);
+                    if (AVERROR_EOF == decoding)
+                    {
+                        //avcodec_flush_buffers(decoder.avCodecContext);
+                        decoding = 0;
+                        packetP = nullptr;
+                    }
+                    else if (decoding < 0)
+                    {
+                        //! \todo How should this be handled?
+                        break;
+                    }
+                }
+                if (packetP &&
+                    avVideoStream == packet.stream_index &&
+                    decoder.seekKeyFrameDts != AV_NOPTS_VALUE)
+                {
+                    if (packet.dts != AV_NOPTS_VALUE && packet.dts < decoder.seekKeyFrameDts)
+                    {
+                        av_packet_unref(packetP);
+                        continue;
+                    }
+                    decoder.seekKeyFrameDts = AV_NOPTS_VALUE;
+                }
+                if (!packetP || avVideoStream == packet.stream_index)
+                {
+                    decoding = avcodec_send_packet(decoder.avCodecContext, packetP);
+                    if (AVERROR_EOF == decoding)
+                    {
+                        //! \todo How should this be handled?
+                        decoding = 0;
+                    }
+                    else if (decoding < 0)
+                    {
+                        break;
+                    }
+                    decoding = decodeVideo(decoder, packetP, time);
+                    if (!packetP && AVERROR_EOF == decoding)
+                    {
+                        // The decoder has been drained.
+                        break;
+                    }
+                    else if (AVERROR(EAGAIN) == decoding || AVERROR_EOF == decoding)
+                    {
+                        decoding = 0;
+                    }
+                    else if (decoding < 0)
+                    {
+                        //! \todo How should this be handled?
+                        break;
+                    }
+                }
+                if (packetP)
+                {
+                    av_packet_unref(packetP);
+                }
+            }
+        }
+
+        void Read::Private::addGOPCache(const avio::VideoFrame& videoFrame)
+        {
+            gopCache[videoFrame.time] = videoFrame;
+
+            // Remove the frames farthest from the last request.
+            while (gopCache.size() > gopCacheSize)
+            {
+                const auto first = gopCache.begin();
+                const auto last = std::prev(gopCache.end());
+                if ((lastTime - first->first).to_seconds() > (last->first - lastTime).to_seconds())
+                {
+                    gopCache.erase(first);
+                }
+                else
+                {
+                    gopCache.erase(last);
+                }
+            }
+        }
+
+        void Read::Private::prefetchGOP()
+        {
+            // The frames after the last request have already been played.
+            gopCache.erase(gopCache.upper_bound(lastTime), gopCache.end());
+            if (gopCache.empty() || gopCache.size() >= gopCacheSize)
+            {
+                return;
+            }
+
+            // Decode the GOP before the first cached frame. Each GOP is only
+            // tried once, in case it cannot be decoded.
+            const otime::RationalTime first = gopCache.begin()->first;
+            const otime::RationalTime time = first - otime::RationalTime(1.0, first.rate());
+            if (first.value() <= 0.0 || time == prefetchTime)
+            {
+                return;
+            }
+            prefetchTime = time;
+            //std::cout << "prefetch: " << time << std::endl;
+            auto& decoder = *decoders[0];
+            seek(decoder, time);
+            decode(decoder, time);
+            for (const auto& i : decoder.videoFrameBuffer)
+            {
+                addGOPCache(i);
+            }
+            decoder.videoFrameBuffer.clear();
+            decoder.currentTime = time::invalidTime;
+        }
+
+        bool Read::Private::isReadAhead() const
+        {
+            const auto& decoder = *decoders[0];
+            if (backward ||
+                readAheadEnd ||
+                decoder.currentTime == time::invalidTime ||
+                decoder.videoFrameBuffer.size() >= readAheadFrames)
+            {
+                return false;
+            }
+            const otime::RationalTime time = !decoder.videoFrameBuffer.empty() ?
+                (decoder.videoFrameBuffer.back().time + otime::RationalTime(1.0, decoder.currentTime.rate())) :
+                decoder.currentTime;
+            if (time.value() >= info.videoDuration.value())
+            {
+                return false;
+            }
+            size_t byteCount = 0;
+            for (const auto& i : decoder.videoFrameBuffer)
+            {
+                byteCount += i.image->getDataByteCount();
+            }
+            return byteCount < readAheadByteCount;
+        }
+
+        void Read::Private::readAhead()
+        {
+            // Decode the next frame, or the frames of the next packet, after
+            // the end of the buffer.
+            auto& decoder = *decoders[0];
+            const otime::RationalTime time = !decoder.videoFrameBuffer.empty() ?
+                (decoder.videoFrameBuffer.back().time + otime::RationalTime(1.0, decoder.currentTime.rate())) :
+                decoder.currentTime;
+            //std::cout << "read ahead: " << time << std::endl;
+            const size_t size = decoder.videoFrameBuffer.size();
+            decode(decoder, time);
+            if (decoder.videoFrameBuffer.size() == size)
+            {
+                // Nothing was decoded, stop reading ahead until the next
+                // request.
+                readAheadEnd = true;
+            }
+        }
+
+        void Read::Private::indexKeyFrames(const std::string& fileName)
+        {
+            // The index uses a separate demuxer that only reads the video
+            // packets, and does not decode them.
+            AVFormatContext* context = nullptr;
+            if (avformat_open_input(&context, fileName.c_str(), nullptr, nullptr) < 0)
+            {
+                return;
+            }
+            if (avformat_find_stream_info(context, nullptr) >= 0 &&
+                avVideoStream < static_cast<int>(context->nb_streams))
+            {
+                for (unsigned int i = 0; i < context->nb_streams; ++i)
+                {
+                    context->streams[i]->discard = avVideoStream == static_cast<int>(i) ?
+                        AVDISCARD_DEFAULT :
+                        AVDISCARD_ALL;
+                }
+                AVPacket packet;
+                int64_t keyFramePts = AV_NOPTS_VALUE;
+                while (running && av_read_frame(context, &packet) >= 0)
+                {
+                    if (avVideoStream == packet.stream_index)
+                    {
+                        const int64_t pts = packet.pts != AV_NOPTS_VALUE ? packet.pts : packet.dts;
+                        const int64_t dts = packet.dts != AV_NOPTS_VALUE ? packet.dts : packet.pts;
+                        std::unique_lock<std::mutex> lock(keyFrameIndex.mutex);
+
+                        // A GOP is open when a frame that follows the key
+                        // frame in decoding order is displayed before it,
+                        // since it may reference the previous GOP.
+                        if (!(packet.flags & AV_PKT_FLAG_KEY) &&
+                            keyFramePts != AV_NOPTS_VALUE &&
+                            pts != AV_NOPTS_VALUE &&
+                            pts < keyFramePts)
+                        {
+                            keyFrameIndex.openGOP = true;
+                        }
+
+                        if ((packet.flags & AV_PKT_FLAG_KEY) && pts != AV_NOPTS_VALUE)
+                        {
+                            keyFramePts = pts;
+                            KeyFrame keyFrame;
+                            keyFrame.pts = pts;
+                            keyFrame.dts = dts;
+                            auto& keyFrames = keyFrameIndex.keyFrames;
+                            keyFrames.insert(
+                                std::upper_bound(
+                                    keyFrames.begin(),
+                                    keyFrames.end(),
+                                    pts,
+                                    [](int64_t value, const KeyFrame& keyFrame)
+                                    {
+                                        return value < keyFrame.pts;
+                                    }),
+                                keyFrame);
+                        }
+
+                        // The packets are demuxed in decoding order, so no
+                        // packet that is not indexed yet can be displayed
+                        // before the last decoding time stamp.
+                        if (dts != AV_NOPTS_VALUE)
+                        {
+                            keyFrameIndex.end = std::max(keyFrameIndex.end, dts);
+                        }
+                    }
+                    av_packet_unref(&packet);
+                }
+                if (running)
+                {
+                    std::unique_lock<std::mutex> lock(keyFrameIndex.mutex);
+                    keyFrameIndex.complete = true;
+                }
+            }
+            avformat_close_input(&context);
+        }
+
+        bool Read::Private::findKeyFrame(int64_t pts, KeyFrame& out)
+        {
+            std::unique_lock<std::mutex> lock(keyFrameIndex.mutex);
+            if (!keyFrameIndex.complete &&
+                (AV_NOPTS_VALUE == keyFrameIndex.end || pts > keyFrameIndex.end))
+            {
+                return false;
+            }
+            const auto& keyFrames = keyFrameIndex.keyFrames;
+            const auto i = std::upper_bound(
+                keyFrames.begin(),
+                keyFrames.end(),
+                pts,
+                [](int64_t value, const KeyFrame& keyFrame)
+                {
+                    return value < keyFrame.pts;
+                });
+            if (i == keyFrames.begin())
+            {
+                return false;
+            }
+            out = *(i - 1);
+            return true;
+        }
+
+        int64_t Read::Private::getKeyFramePts(const otime::RationalTime& time)
+        {
+            int64_t out = AV_NOPTS_VALUE;
+            KeyFrame keyFrame;
+            if (intraOnly)
+            {
+                out = getPts(time);
+            }
+            else if (findKeyFrame(getPts(time), keyFrame))
+            {
+                out = keyFrame.pts;
+            }
+            return out;
+        }
+
+        bool Read::Private::isGOPIndependent()
+        {
+            if (intraOnly)
+            {
+                return true;
+            }
+            std::unique_lock<std::mutex> lock(keyFrameIndex.mutex);
+            return keyFrameIndex.complete && !keyFrameIndex.openGOP;
+        }
+
+        int64_t Read::Private::getPts(const otime::RationalTime& time) const
+        {
+            return av_rescale_q(
+                time.value(),
+                swap(avFrameRate),
+                avTimeBase);
+        }
+
+        std::shared_ptr<imaging::Image> Read::Private::createImage(Decoder& decoder, const imaging::Info& info)
+        {
+            // Frames that do not need to be converted or scaled reference the
+            // buffers of the decoded frame instead of being copied.
+            std::shared_ptr<imaging::Image> out;
+            const uint8_t planeCount = imaging::getPlaneCount(info.pixelType);
+            bool reference =
+                decoder.avFrame->format == toAVPixelFormat(info.pixelType) &&
+                decoder.avFrame->width == info.size.w &&
+                decoder.avFrame->height == info.size.h;
+            for (uint8_t i = 0; i < planeCount && reference; ++i)
+            {
+                reference = decoder.avFrame->data[i] && decoder.avFrame->linesize[i] > 0;
+            }
+            if (reference)
+            {
+                std::shared_ptr<AVFrame> frame(
+                    av_frame_alloc(),
+                    [](AVFrame* value)
+                    {
+                        av_frame_free(&value);
+                    });
+                if (frame && av_frame_ref(frame.get(), decoder.avFrame) >= 0)
+                {
+                    std::vector<const uint8_t*> planes;
+                    std::vector<size_t> strides;
+                    for (uint8_t i = 0; i < planeCount; ++i)
+                    {
+                        planes.push_back(frame->data[i]);
+                        strides.push_back(frame->linesize[i]);
+                    }
+                    out = imaging::Image::create(info, planes, strides, frame);
+                }
+            }
+            if (!out)
+            {
+                out = imaging::Image::create(info);
+                copyVideo(decoder, out);
+            }
+            return out;
+        }
+
+        void Read::Private::copyVideo(Decoder& decoder, const std::shared_ptr<imaging::Image>& image)
         {
             const auto& info = image->getInfo();
-            const std::size_t w = info.size.w;
-            const std::size_t h = info.size.h;
             const AVPixelFormat avPixelFormat = static_cast<AVPixelFormat>(avCodecParameters[avVideoStream]->format);
-            switch (avPixelFormat)
-            {
-            case AV_PIX_FMT_YUV420P:
-            {
-                const std::size_t w2 = w / 2;
-                const std::size_t h2 = h / 2;
-                for (std::size_t i = 0; i < h; ++i)
-                {
-                    std::memcpy(
-                        image->getData() + w * i,
-                        avFrame->data[0] + avFrame->linesize[0] * i,
-                        w);
-                }
-                for (std::size_t i = 0; i < h2; ++i)
-                {
-                    std::memcpy(
-                        image->getData() + (w * h) + w2 * i,
-                        avFrame->data[1] + avFrame->linesize[1] * i,
-                        w2);
-                    std::memcpy(
-                        image->getData() + (w * h) + (w2 * h2) + w2 * i,
-                        avFrame->data[2] + avFrame->linesize[2] * i,
-                        w2);
-                }
-                break;
-            }
-            case AV_PIX_FMT_RGB24:
-                for (std::size_t i = 0; i < h; ++i)
-                {
-                    std::memcpy(
-                        image->getData() + w * 3 * i,
-                        avFrame->data[0] + avFrame->linesize[0] * 3 * i,
-                        w * 3);
-                }
-                break;
-            case AV_PIX_FMT_GRAY8:
-                for (std::size_t i = 0; i < h; ++i)
-                {
-                    std::memcpy(
-                        image->getData() + w * i,
-                        avFrame->data[0] + avFrame->linesize[0] * i,
-                        w);
-                }
-                break;
-            case AV_PIX_FMT_RGBA:
-                for (std::size_t i = 0; i < h; ++i)
-                {
-                    std::memcpy(
-                        image->getData() + w * 4 * i,
-                        avFrame->data[0] + avFrame->linesize[0] * 4 * i,
-                        w * 4);
-                }
-                break;
-            default:
-                av_image_fill_arrays(
-                    avFrame2->data,
-                    avFrame2->linesize,
-                    image->getData(),
-                    AV_PIX_FMT_YUV420P,
-                    w,
-                    h,
-                    1);
-                sws_scale(
-                    swsContext,
-                    (uint8_t const* const*)avFrame->data,
-                    avFrame->linesize,
-                    0,
+            const AVPixelFormat avImageFormat = toAVPixelFormat(info.pixelType);
+            const uint8_t planeCount = image->getPlaneCount();
+            if (info.size == this->info.video[0].size && avPixelFormat == avImageFormat)
+            {
+                for (uint8_t i = 0; i < planeCount; ++i)
+                {
+                    const std::size_t rowByteCount = imaging::getPlaneRowByteCount(info, i);
+                    const std::size_t h = imaging::getPlaneSize(info, i).h;
+                    for (std::size_t y = 0; y < h; ++y)
+                    {
+                        std::memcpy(
+                            image->getPlaneData(i) + image->getPlaneStride(i) * y,
+                            decoder.avFrame->data[i] + decoder.avFrame->linesize[i] * static_cast<ptrdiff_t>(y),
+                            rowByteCount);
+                    }
+                }
+                return;
+            }
+
+            // Proxies are scaled while they are converted.
+            SwsContext* context = decoder.swsContext;
+            if (info.size != this->info.video[0].size)
+            {
+                decoder.swsProxyContext = sws_getCachedContext(
+                    decoder.swsProxyContext,
+                    avCodecParameters[avVideoStream]->width,
                     avCodecParameters[avVideoStream]->height,
-                    avFrame2->data,
-                    avFrame2->linesize);
-                break;
+                    avPixelFormat,
+                    info.size.w,
+                    info.size.h,
+                    avImageFormat,
+                    swsScaleFlags,
+                    0,
+                    0,
+                    0);
+                context = decoder.swsProxyContext;
+            }
+            for (uint8_t i = 0; i < planeCount; ++i)
+            {
+                decoder.avFrame2->data[i] = image->getPlaneData(i);
+                decoder.avFrame2->linesize[i] = static_cast<int>(image->getPlaneStride(i));
             }
+            sws_scale(
+                context,
+                (uint8_t const* const*)decoder.avFrame->data,
+                decoder.avFrame->linesize,
+                0,
+                avCodecParameters[avVideoStream]->height,
+                decoder.avFrame2->data,
+                decoder.avFrame2->linesize);
         }
     }
 }
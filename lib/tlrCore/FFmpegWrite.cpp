@@ -6,12 +6,6 @@
 
 #include <tlrCore/StringFormat.h>
 
-extern "C"
-{
-#include <libavutil/imgutils.h>
-
-} // extern "C"
-
 namespace tlr
 {
     namespace ffmpeg
@@ -249,15 +243,12 @@ namespace tlr
         {
             TLR_PRIVATE_P();
 
-            const auto& info = image->getInfo();
-            av_image_fill_arrays(
-                p.avFrame2->data,
-                p.avFrame2->linesize,
-                image->getData(),
-                p.avPixelFormatIn,
-                info.size.w,
-                info.size.h,
-                1);
+            // The image planes may have a row stride.
+            for (uint8_t i = 0; i < image->getPlaneCount(); ++i)
+            {
+                p.avFrame2->data[i] = image->getPlaneData(i);
+                p.avFrame2->linesize[i] = static_cast<int>(image->getPlaneStride(i));
+            }
             //! \bug This is wrong for flipping YUV data.
             //for (int i = 0; i < 4; i++)
             //{
@@ -19,5 +19,26 @@ namespace tlr
 
         // Create a temporary directory.
         std::string createTempDir();
+
+        //! Directory entry.
+        struct DirectoryEntry
+        {
+            std::string fileName;
+            uint64_t size = 0;
+        };
+
+        //! List the files in a directory. Sub-directories are not included.
+        //! Only the files whose names start with the prefix and end with the
+        //! extension are listed. The names are filtered before the files
+        //! are queried, which is much faster on network file systems.
+        std::vector<DirectoryEntry> listDirectory(
+            const std::string&,
+            const std::string& prefix = std::string(),
+            const std::string& extension = std::string());
+
+        //! Tell the operating system that a file will be read soon, so that
+        //! it can start reading it into the page cache. This does nothing
+        //! on Windows.
+        void prefetch(const std::string&);
     }
 }
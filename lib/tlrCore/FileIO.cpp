@@ -6,10 +6,23 @@
 
 #include <tlrCore/Assert.h>
 #include <tlrCore/Error.h>
+#include <tlrCore/StringFormat.h>
+#include <tlrCore/ThreadPool.h>
+#if defined(TLR_ENABLE_IO_URING)
+#include <tlrCore/IOUring.h>
+#endif // TLR_ENABLE_IO_URING
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <iostream>
+#include <list>
+#include <map>
+#include <mutex>
+#include <system_error>
+
+#include <errno.h>
 
 namespace tlr
 {
@@ -23,6 +36,13 @@ namespace tlr
             "Append");
         TLR_ENUM_SERIALIZE_IMPL(Mode);
 
+        TLR_ENUM_IMPL(
+            DirectIO,
+            "Off",
+            "DontNeed",
+            "Direct");
+        TLR_ENUM_SERIALIZE_IMPL(DirectIO);
+
         std::shared_ptr<FileIO> FileIO::create()
         {
             return std::shared_ptr<FileIO>(new FileIO);
@@ -138,6 +158,340 @@ namespace tlr
             write8(reinterpret_cast<const int8_t*>(value.c_str()), value.size());
         }
 
+        struct ReadQueue::Private
+        {
+            struct Request
+            {
+                uint64_t                id = 0;
+                std::shared_ptr<FileIO> io;
+                size_t                  offset = 0;
+                uint8_t*                data = nullptr;
+                size_t                  size = 0;
+                std::atomic<bool>       claimed;
+            };
+
+            static ReadResult readAt(Request&);
+
+            std::shared_ptr<core::ThreadPool> threadPool;
+            size_t depth = readQueueDepth;
+            uint64_t id = 0;
+            std::list<std::shared_ptr<Request> > queued;
+            size_t pending = 0;
+
+            // Reads performed with FileIO::readAt(). The requests are run by
+            // the thread pool, or by the thread that collects the results,
+            // whichever claims them first.
+            struct Results
+            {
+                std::vector<ReadResult> results;
+                std::condition_variable cv;
+                std::mutex mutex;
+            };
+            std::shared_ptr<Results> results;
+            std::list<std::shared_ptr<Request> > submitted;
+
+#if defined(TLR_ENABLE_IO_URING)
+            // Reads performed by the kernel.
+            std::unique_ptr<IOUring> ring;
+            std::list<std::shared_ptr<Request> > backlog;
+            std::map<uint64_t, std::shared_ptr<Request> > ringRequests;
+
+            void ringFill();
+            void ringCompletion(uint64_t, int, std::vector<ReadResult>&);
+#endif // TLR_ENABLE_IO_URING
+        };
+
+        ReadResult ReadQueue::Private::readAt(Request& request)
+        {
+            ReadResult out;
+            out.id = request.id;
+            try
+            {
+                request.io->readAt(request.offset, request.data, request.size);
+            }
+            catch (const std::exception& e)
+            {
+                out.error = e.what();
+            }
+            return out;
+        }
+
+#if defined(TLR_ENABLE_IO_URING)
+        void ReadQueue::Private::ringFill()
+        {
+            while (!backlog.empty() && ringRequests.size() < depth)
+            {
+                const auto& request = backlog.front();
+                if (!ring->read(
+                    request->io->_getDescriptor(),
+                    request->data,
+                    request->size,
+                    request->offset,
+                    request->id))
+                {
+                    break;
+                }
+                ringRequests[request->id] = request;
+                backlog.pop_front();
+            }
+        }
+
+        void ReadQueue::Private::ringCompletion(uint64_t id, int result, std::vector<ReadResult>& out)
+        {
+            const auto i = ringRequests.find(id);
+            if (i != ringRequests.end())
+            {
+                auto request = i->second;
+                ringRequests.erase(i);
+                if (-EINVAL == result || -EOPNOTSUPP == result)
+                {
+                    // The kernel does not support the read operation.
+                    out.push_back(readAt(*request));
+                }
+                else if (result < 0)
+                {
+                    ReadResult readResult;
+                    readResult.id = id;
+                    readResult.error = string::Format("{0}: Cannot read: {1}").
+                        arg(request->io->getFileName()).
+                        arg(std::system_category().message(-result));
+                    out.push_back(readResult);
+                }
+                else if (static_cast<size_t>(result) < request->size)
+                {
+                    // Finish a short read.
+                    request->offset += result;
+                    request->data += result;
+                    request->size -= result;
+                    out.push_back(readAt(*request));
+                }
+                else
+                {
+                    ReadResult readResult;
+                    readResult.id = id;
+                    out.push_back(readResult);
+                }
+                --pending;
+            }
+        }
+#endif // TLR_ENABLE_IO_URING
+
+        void ReadQueue::_init(const std::shared_ptr<core::ThreadPool>& threadPool, size_t depth)
+        {
+            TLR_PRIVATE_P();
+            p.threadPool = threadPool;
+            p.depth = std::max(depth, static_cast<size_t>(1));
+            p.results = std::make_shared<Private::Results>();
+#if defined(TLR_ENABLE_IO_URING)
+            p.ring = IOUring::create(p.depth);
+#endif // TLR_ENABLE_IO_URING
+        }
+
+        ReadQueue::ReadQueue() :
+            _p(new Private)
+        {}
+
+        ReadQueue::~ReadQueue()
+        {
+            TLR_PRIVATE_P();
+
+            // Drop the reads that have not been started, and wait for the
+            // others to finish.
+            p.queued.clear();
+            for (const auto& i : p.submitted)
+            {
+                if (!i->claimed.exchange(true))
+                {
+                    --p.pending;
+                }
+            }
+            p.submitted.clear();
+#if defined(TLR_ENABLE_IO_URING)
+            p.pending -= p.backlog.size();
+            p.backlog.clear();
+#endif // TLR_ENABLE_IO_URING
+            wait();
+        }
+
+        std::shared_ptr<ReadQueue> ReadQueue::create(
+            const std::shared_ptr<core::ThreadPool>& threadPool,
+            size_t depth)
+        {
+            auto out = std::shared_ptr<ReadQueue>(new ReadQueue);
+            out->_init(threadPool, depth);
+            return out;
+        }
+
+        bool ReadQueue::isAsync() const
+        {
+#if defined(TLR_ENABLE_IO_URING)
+            return _p->ring.get() != nullptr;
+#else // TLR_ENABLE_IO_URING
+            return false;
+#endif // TLR_ENABLE_IO_URING
+        }
+
+        uint64_t ReadQueue::read(
+            const std::shared_ptr<FileIO>& io,
+            size_t offset,
+            void* data,
+            size_t size)
+        {
+            TLR_PRIVATE_P();
+            auto request = std::make_shared<Private::Request>();
+            request->id = p.id++;
+            request->io = io;
+            request->offset = offset;
+            request->data = reinterpret_cast<uint8_t*>(data);
+            request->size = size;
+            request->claimed = false;
+            p.queued.push_back(request);
+            return request->id;
+        }
+
+        void ReadQueue::submit()
+        {
+            TLR_PRIVATE_P();
+            p.pending += p.queued.size();
+#if defined(TLR_ENABLE_IO_URING)
+            if (p.ring)
+            {
+                p.backlog.splice(p.backlog.end(), p.queued);
+                p.ringFill();
+                p.ring->submit();
+                return;
+            }
+#endif // TLR_ENABLE_IO_URING
+            for (const auto& request : p.queued)
+            {
+                p.submitted.push_back(request);
+                if (p.threadPool)
+                {
+                    auto results = p.results;
+                    p.threadPool->run(
+                        [request, results]
+                        {
+                            if (!request->claimed.exchange(true))
+                            {
+                                const ReadResult result = Private::readAt(*request);
+                                {
+                                    std::unique_lock<std::mutex> lock(results->mutex);
+                                    results->results.push_back(result);
+                                }
+                                results->cv.notify_all();
+                            }
+                        });
+                }
+            }
+            p.queued.clear();
+        }
+
+        size_t ReadQueue::getPending() const
+        {
+            return _p->pending;
+        }
+
+        std::vector<ReadResult> ReadQueue::reap(size_t minCount)
+        {
+            TLR_PRIVATE_P();
+            std::vector<ReadResult> out;
+            minCount = std::min(minCount, p.pending);
+#if defined(TLR_ENABLE_IO_URING)
+            if (p.ring)
+            {
+                uint64_t id = 0;
+                int result = 0;
+                while (true)
+                {
+                    while (p.ring->getCompletion(id, result, false))
+                    {
+                        p.ringCompletion(id, result, out);
+                    }
+                    p.ringFill();
+                    if (out.size() >= minCount)
+                    {
+                        p.ring->submit();
+                        break;
+                    }
+                    if (p.ring->submit() && p.ring->getCompletion(id, result, true))
+                    {
+                        p.ringCompletion(id, result, out);
+                    }
+                    else
+                    {
+                        // The ring has failed, finish the reads here.
+                        for (const auto& i : p.ringRequests)
+                        {
+                            out.push_back(Private::readAt(*i.second));
+                        }
+                        for (const auto& i : p.backlog)
+                        {
+                            out.push_back(Private::readAt(*i));
+                        }
+                        p.pending -= p.ringRequests.size() + p.backlog.size();
+                        p.ringRequests.clear();
+                        p.backlog.clear();
+                        p.ring.reset();
+                        break;
+                    }
+                }
+                return out;
+            }
+#endif // TLR_ENABLE_IO_URING
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(p.results->mutex);
+                    if (p.results->results.size() >= minCount)
+                    {
+                        out.swap(p.results->results);
+                        break;
+                    }
+                }
+
+                // Run a read that has not been started yet.
+                std::shared_ptr<Private::Request> request;
+                while (!p.submitted.empty() && !request)
+                {
+                    if (!p.submitted.front()->claimed.exchange(true))
+                    {
+                        request = p.submitted.front();
+                    }
+                    p.submitted.pop_front();
+                }
+                if (request)
+                {
+                    const ReadResult result = Private::readAt(*request);
+                    std::unique_lock<std::mutex> lock(p.results->mutex);
+                    p.results->results.push_back(result);
+                }
+                else
+                {
+                    // Wait for the reads that are running on the thread pool.
+                    std::unique_lock<std::mutex> lock(p.results->mutex);
+                    p.results->cv.wait(
+                        lock,
+                        [this, minCount]
+                        {
+                            return _p->results->results.size() >= minCount;
+                        });
+                }
+            }
+            p.pending -= out.size();
+            if (0 == p.pending)
+            {
+                // Release the files of the finished reads, the queue may be
+                // re-used.
+                p.submitted.clear();
+            }
+            return out;
+        }
+
+        std::vector<ReadResult> ReadQueue::wait()
+        {
+            return reap(_p->pending);
+        }
+
         std::string readContents(const std::shared_ptr<FileIO>& io)
         {
 #ifdef TLR_ENABLE_MMAP
@@ -11,6 +11,11 @@
 
 namespace tlr
 {
+    namespace core
+    {
+        class ThreadPool;
+    }
+
     namespace file
     {
         //! File I/O modes.
@@ -27,6 +32,36 @@ namespace tlr
         TLR_ENUM(Mode);
         TLR_ENUM_SERIALIZE(Mode);
 
+        //! File read caching.
+        //!
+        //! The operating system caches file reads in the page cache. When
+        //! streaming large files that are only read once, such as the
+        //! frames of an image sequence, this evicts more useful data and
+        //! adds memory traffic.
+        enum class DirectIO
+        {
+            Off,      //!< Reads go through the page cache
+            DontNeed, //!< Reads go through the page cache, which is told to drop them afterwards (Linux only)
+            Direct,   //!< Reads bypass the page cache (Linux and macOS only)
+
+            Count,
+            First = Off
+        };
+        TLR_ENUM(DirectIO);
+        TLR_ENUM_SERIALIZE(DirectIO);
+
+        //! Alignment of the buffers, offsets, and sizes used for direct I/O.
+        const size_t directIOAlignment = 4096;
+
+        //! Size of the buffer used for direct I/O reads that are not
+        //! aligned.
+        const size_t directIOBufferSize = 8 * 1024 * 1024;
+
+        //! Minimum number of bytes read for small direct I/O reads that are
+        //! not aligned. The bytes are kept in a buffer, so that headers that
+        //! are parsed with many small reads only read from the file once.
+        const size_t directIOHeaderSize = 64 * 1024;
+
         //! File I/O.
         class FileIO
         {
@@ -44,8 +79,11 @@ namespace tlr
             //! \name Open and Close
             ///@{
 
-            //! Open the file.
-            void open(const std::string& fileName, Mode);
+            //! Open the file. The direct I/O setting only applies to files
+            //! opened for reading, and memory mapping is not used with
+            //! DirectIO::Direct. If the file system does not support direct
+            //! I/O, DirectIO::DontNeed is used instead.
+            void open(const std::string& fileName, Mode, DirectIO = DirectIO::Off);
 
             //! Open a temporary file.
             void openTemp();
@@ -99,6 +137,11 @@ namespace tlr
             void readU32(uint32_t*, size_t = 1);
             void readF32(float*, size_t = 1);
 
+            //! Read data from the given offset without changing the current
+            //! file position. No endian conversion is performed. This
+            //! function is thread safe.
+            void readAt(size_t offset, void*, size_t);
+
             ///@}
 
             //! \name Write
@@ -135,6 +178,11 @@ namespace tlr
 
             //! Get a pointer to the end of the memory-map.
             const uint8_t* mmapEnd() const;
+
+            //! Get a reference to the start of the memory-map. The
+            //! memory-map stays valid while the reference is held, even
+            //! after the file is closed. The memory is read-only.
+            std::shared_ptr<uint8_t> mmapRef() const;
 #endif // TLR_ENABLE_MMAP
 
             ///@}
@@ -151,6 +199,81 @@ namespace tlr
             ///@}
 
         private:
+#if defined(TLR_ENABLE_IO_URING)
+            int _getDescriptor() const;
+#endif // TLR_ENABLE_IO_URING
+
+            friend class ReadQueue;
+
+            TLR_PRIVATE();
+        };
+
+        //! Default maximum number of reads the kernel works on at the same
+        //! time.
+        const size_t readQueueDepth = 64;
+
+        //! Asynchronous read result.
+        struct ReadResult
+        {
+            uint64_t    id = 0;
+            std::string error;
+        };
+
+        //! Asynchronous file reads.
+        //!
+        //! Reads are added to the queue, submitted together, and their
+        //! results are collected as they complete. On Linux the reads are
+        //! performed by the kernel with io_uring when it is available.
+        //! Otherwise they are performed with FileIO::readAt() on the
+        //! thread pool, or on the calling thread if there is no thread
+        //! pool.
+        //!
+        //! The files and the data buffers must stay valid until the results
+        //! are collected. When the queue is destroyed, reads that have not
+        //! been started are dropped and the others are waited for. The queue
+        //! itself is not thread safe.
+        class ReadQueue
+        {
+            TLR_NON_COPYABLE(ReadQueue);
+
+        protected:
+            void _init(const std::shared_ptr<core::ThreadPool>&, size_t depth);
+            ReadQueue();
+
+        public:
+            ~ReadQueue();
+
+            //! Create a new read queue.
+            static std::shared_ptr<ReadQueue> create(
+                const std::shared_ptr<core::ThreadPool>& = nullptr,
+                size_t depth = readQueueDepth);
+
+            //! Get whether the reads are performed by the kernel (io_uring).
+            bool isAsync() const;
+
+            //! Add a read to the queue. Returns the ID of the read.
+            uint64_t read(
+                const std::shared_ptr<FileIO>&,
+                size_t offset,
+                void*,
+                size_t);
+
+            //! Submit the queued reads.
+            void submit();
+
+            //! Get the number of reads that have been submitted and whose
+            //! results have not been collected.
+            size_t getPending() const;
+
+            //! Collect the results of the completed reads, waiting until at
+            //! least the given number have completed.
+            std::vector<ReadResult> reap(size_t minCount = 0);
+
+            //! Wait for all of the submitted reads to complete and collect
+            //! the results.
+            std::vector<ReadResult> wait();
+
+        private:
             TLR_PRIVATE();
         };
 
@@ -19,6 +19,8 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <mutex>
+
 #define _STAT     struct stat
 #define _STAT_FNC stat
 
@@ -107,15 +109,29 @@ namespace tlr
         struct FileIO::Private
         {
             void setPos(size_t, bool seek);
+            void readAt(size_t offset, void*, size_t);
+            void readAtDirect(size_t offset, uint8_t*, size_t);
+            void readAtDirectHeader(size_t offset, uint8_t*, size_t);
             
             std::string    fileName;
             Mode           mode = Mode::First;
+            DirectIO       directIO = DirectIO::Off;
+            bool           direct = false;
             size_t         pos = 0;
             size_t         size = 0;
             bool           endianConversion = false;
             int            f = -1;
+
+            // Small unaligned direct reads are copied from this buffer,
+            // which holds the region of the file that was last read.
+            std::unique_ptr<uint8_t, void(*)(void*)> headerBuf =
+                std::unique_ptr<uint8_t, void(*)(void*)>(nullptr, memory::alignedFree);
+            size_t         headerOffset = 0;
+            size_t         headerSize = 0;
+            std::mutex     headerMutex;
 #if defined(TLR_ENABLE_MMAP)
             void*          mmap = reinterpret_cast<void*>(-1);
+            std::shared_ptr<uint8_t> mmapRef;
             const uint8_t* mmapStart = nullptr;
             const uint8_t* mmapEnd = nullptr;
             const uint8_t* mmapP = nullptr;
@@ -131,7 +147,7 @@ namespace tlr
             close();
         }
                     
-        void FileIO::open(const std::string& fileName, Mode mode)
+        void FileIO::open(const std::string& fileName, Mode mode, DirectIO directIO)
         {
             TLR_PRIVATE_P();
             
@@ -159,11 +175,46 @@ namespace tlr
                 break;
             default: break;
             }
+            if (mode != Mode::Read)
+            {
+                directIO = DirectIO::Off;
+            }
+            p.direct = false;
+#if defined(__linux__)
+            if (DirectIO::Direct == directIO)
+            {
+                p.f = ::open(fileName.c_str(), openFlags | O_DIRECT, openMode);
+                if (p.f != -1)
+                {
+                    p.direct = true;
+                }
+                else if (EINVAL == errno)
+                {
+                    // The file system does not support direct I/O.
+                    directIO = DirectIO::DontNeed;
+                }
+            }
+            if (!p.direct)
+            {
+                p.f = ::open(fileName.c_str(), openFlags, openMode);
+            }
+#else // __linux__
+            if (DirectIO::DontNeed == directIO)
+            {
+                directIO = DirectIO::Off;
+            }
             p.f = ::open(fileName.c_str(), openFlags, openMode);
+#endif // __linux__
             if (-1 == p.f)
             {
                 throw std::runtime_error(getErrorMessage(ErrorType::Open, fileName, getErrorString()));
             }
+#if defined(__APPLE__)
+            if (DirectIO::Direct == directIO)
+            {
+                fcntl(p.f, F_NOCACHE, 1);
+            }
+#endif // __APPLE__
 
             // Stat the file.
             _STAT info;
@@ -174,12 +225,13 @@ namespace tlr
             }
             p.fileName = fileName;
             p.mode     = mode;
+            p.directIO = directIO;
             p.pos      = 0;
             p.size     = info.st_size;
 
 #if defined(TLR_ENABLE_MMAP)
             // Memory mapping.
-            if (Mode::Read == p.mode && p.size > 0)
+            if (Mode::Read == p.mode && p.size > 0 && directIO != DirectIO::Direct)
             {
                 p.mmap = mmap(0, p.size, PROT_READ, MAP_SHARED, p.f, 0);
                 madvise(p.mmap, p.size, MADV_SEQUENTIAL | MADV_SEQUENTIAL);
@@ -187,6 +239,15 @@ namespace tlr
                 {
                     throw std::runtime_error(getErrorMessage(ErrorType::MemoryMap, fileName, getErrorString()));
                 }
+                // The memory-map is unmapped when the last reference is
+                // released, which may be after the file is closed.
+                const size_t size = p.size;
+                p.mmapRef = std::shared_ptr<uint8_t>(
+                    reinterpret_cast<uint8_t*>(p.mmap),
+                    [size](uint8_t* value)
+                    {
+                        munmap(value, size);
+                    });
                 p.mmapStart = reinterpret_cast<const uint8_t*>(p.mmap);
                 p.mmapEnd   = p.mmapStart + p.size;
                 p.mmapP     = p.mmapStart;
@@ -233,22 +294,17 @@ namespace tlr
             
             p.fileName = std::string();
 #if defined(TLR_ENABLE_MMAP)
-            if (p.mmap != (void*)-1)
-            {
-                int r = munmap(p.mmap, p.size);
-                if (-1 == r)
-                {
-                    out = false;
-                    if (error)
-                    {
-                        *error = getErrorMessage(ErrorType::CloseMemoryMap, p.fileName, getErrorString());
-                    }
-                }
-                p.mmap = (void*)-1;
-            }
+            p.mmapRef.reset();
+            p.mmap = (void*)-1;
             p.mmapStart = 0;
             p.mmapEnd   = 0;
 #endif // TLR_ENABLE_MMAP
+#if defined(__linux__)
+            if (p.f != -1 && DirectIO::DontNeed == p.directIO)
+            {
+                posix_fadvise(p.f, 0, 0, POSIX_FADV_DONTNEED);
+            }
+#endif // __linux__
             if (p.f != -1)
             {
                 int r = ::close(p.f);
@@ -263,9 +319,12 @@ namespace tlr
                 p.f = -1;
             }
 
-            p.mode = Mode::First;
-            p.pos  = 0;
-            p.size = 0;
+            p.mode     = Mode::First;
+            p.directIO = DirectIO::Off;
+            p.direct   = false;
+            p.headerSize = 0;
+            p.pos      = 0;
+            p.size     = 0;
             
             return out;
         }
@@ -310,6 +369,11 @@ namespace tlr
         {
             return _p->mmapEnd;
         }
+
+        std::shared_ptr<uint8_t> FileIO::mmapRef() const
+        {
+            return _p->mmapRef;
+        }
 #endif // TLR_ENABLE_MMAP
 
         bool FileIO::hasEndianConversion() const
@@ -344,35 +408,30 @@ namespace tlr
             case Mode::Read:
             {
 #if defined(TLR_ENABLE_MMAP)
-                const uint8_t* mmapP = p.mmapP + size * wordSize;
-                if (mmapP > p.mmapEnd)
-                {
-                    throw std::runtime_error(getErrorMessage(ErrorType::ReadMemoryMap, p.fileName));
-                }
-                if (p.endianConversion && wordSize > 1)
-                {
-                    memory::endian(p.mmapP, in, size, wordSize);
-                }
-                else
+                if (p.mmapStart)
                 {
-                    memcpy(in, p.mmapP, size * wordSize);
-                }
-                p.mmapP = mmapP;
-#else // TLR_ENABLE_MMAP
-                const ssize_t r = ::read(p.f, in, size * wordSize);
-                if (-1 == r)
-                {
-                    throw std::runtime_error(getErrorMessage(ErrorType::Read, p.fileName, getErrorString()));
-                }
-                else if (r != size * wordSize)
-                {
-                    throw std::runtime_error(getErrorMessage(ErrorType::Read, p.fileName));
+                    const uint8_t* mmapP = p.mmapP + size * wordSize;
+                    if (mmapP > p.mmapEnd)
+                    {
+                        throw std::runtime_error(getErrorMessage(ErrorType::ReadMemoryMap, p.fileName));
+                    }
+                    if (p.endianConversion && wordSize > 1)
+                    {
+                        memory::endian(p.mmapP, in, size, wordSize);
+                    }
+                    else
+                    {
+                        memcpy(in, p.mmapP, size * wordSize);
+                    }
+                    p.mmapP = mmapP;
+                    break;
                 }
+#endif // TLR_ENABLE_MMAP
+                p.readAt(p.pos, in, size * wordSize);
                 if (p.endianConversion && wordSize > 1)
                 {
                     memory::endian(in, size, wordSize);
                 }
-#endif // TLR_ENABLE_MMAP
                 break;
             }
             case Mode::ReadWrite:
@@ -397,6 +456,37 @@ namespace tlr
             p.pos += size * wordSize;
         }
 
+        void FileIO::readAt(size_t offset, void* in, size_t size)
+        {
+            TLR_PRIVATE_P();
+
+            if (-1 == p.f)
+            {
+                throw std::runtime_error(getErrorMessage(ErrorType::Read, p.fileName));
+            }
+
+#if defined(TLR_ENABLE_MMAP)
+            if (p.mmapStart)
+            {
+                if (offset + size > p.size)
+                {
+                    throw std::runtime_error(getErrorMessage(ErrorType::ReadMemoryMap, p.fileName));
+                }
+                memcpy(in, p.mmapStart + offset, size);
+                return;
+            }
+#endif // TLR_ENABLE_MMAP
+
+            p.readAt(offset, in, size);
+        }
+
+#if defined(TLR_ENABLE_IO_URING)
+        int FileIO::_getDescriptor() const
+        {
+            return _p->f;
+        }
+#endif // TLR_ENABLE_IO_URING
+
         void FileIO::write(const void* in, size_t size, size_t wordSize)
         {
             TLR_PRIVATE_P();
@@ -422,31 +512,187 @@ namespace tlr
             p.size = std::max(p.pos, p.size);
         }
 
-        void FileIO::Private::setPos(size_t in, bool seek)
+        void FileIO::Private::readAt(size_t offset, void* in, size_t size)
         {
-            switch (mode)
+            if (direct)
             {
-            case Mode::Read:
+                readAtDirect(offset, reinterpret_cast<uint8_t*>(in), size);
+            }
+            else
             {
-#if defined(TLR_ENABLE_MMAP)
-                if (!seek)
+                uint8_t* inP = reinterpret_cast<uint8_t*>(in);
+                size_t inOffset = offset;
+                size_t inSize = size;
+                while (inSize > 0)
                 {
-                    mmapP = reinterpret_cast<const uint8_t*>(mmapStart) + in;
+                    const ssize_t r = ::pread(f, inP, inSize, inOffset);
+                    if (-1 == r)
+                    {
+                        if (EINTR == errno)
+                        {
+                            continue;
+                        }
+                        throw std::runtime_error(getErrorMessage(ErrorType::Read, fileName, getErrorString()));
+                    }
+                    else if (0 == r)
+                    {
+                        throw std::runtime_error(getErrorMessage(ErrorType::Read, fileName));
+                    }
+                    inP += r;
+                    inOffset += r;
+                    inSize -= r;
                 }
-                else
+            }
+#if defined(__linux__)
+            if (DirectIO::DontNeed == directIO)
+            {
+                posix_fadvise(f, offset, size, POSIX_FADV_DONTNEED);
+            }
+#endif // __linux__
+        }
+
+        void FileIO::Private::readAtDirect(size_t offset, uint8_t* in, size_t size)
+        {
+            // Direct I/O requires the buffer, offset, and size to be
+            // aligned. Reads that are not aligned go through an aligned
+            // buffer.
+            const size_t a = directIOAlignment;
+            const bool aligned =
+                0 == reinterpret_cast<uintptr_t>(in) % a &&
+                0 == offset % a &&
+                0 == size % a;
+            if (!aligned && size <= directIOHeaderSize)
+            {
+                readAtDirectHeader(offset, in, size);
+                return;
+            }
+            std::unique_ptr<uint8_t, void(*)(void*)> buf(nullptr, memory::alignedFree);
+            const size_t bufSize = std::min(directIOBufferSize, (size / a + 2) * a);
+            if (!aligned)
+            {
+                buf.reset(reinterpret_cast<uint8_t*>(memory::alignedAlloc(bufSize, a)));
+                if (!buf)
                 {
-                    mmapP += in;
+                    throw std::runtime_error(getErrorMessage(ErrorType::Read, fileName));
                 }
-                if (mmapP > mmapEnd)
+            }
+            while (size > 0)
+            {
+                const size_t start = offset / a * a;
+                const size_t skip = offset - start;
+                const size_t count = aligned ? size : std::min(size, bufSize - skip - a);
+                const size_t length = aligned ? size : ((skip + count + a - 1) / a * a);
+                uint8_t* out = aligned ? in : buf.get();
+                size_t total = 0;
+                while (total < skip + count)
                 {
-                    throw std::runtime_error(getErrorMessage(ErrorType::SeekMemoryMap, fileName));
+                    const ssize_t r = ::pread(f, out + total, length - total, start + total);
+                    if (-1 == r)
+                    {
+                        if (EINTR == errno)
+                        {
+                            continue;
+                        }
+                        throw std::runtime_error(getErrorMessage(ErrorType::Read, fileName, getErrorString()));
+                    }
+                    else if (0 == r)
+                    {
+                        throw std::runtime_error(getErrorMessage(ErrorType::Read, fileName));
+                    }
+                    total += r;
                 }
-#else // TLR_ENABLE_MMAP
-                if (::lseek(f, in, ! seek ? SEEK_SET : SEEK_CUR) == (off_t)-1)
+                if (!aligned)
                 {
-                    throw std::runtime_error(getErrorMessage(ErrorType::Seek, fileName, getErrorString()));
+                    memcpy(in, out + skip, count);
+                }
+                in += count;
+                offset += count;
+                size -= count;
+            }
+        }
+
+        void FileIO::Private::readAtDirectHeader(size_t offset, uint8_t* in, size_t size)
+        {
+            std::unique_lock<std::mutex> lock(headerMutex);
+            if (offset < headerOffset || offset + size > headerOffset + headerSize)
+            {
+                // Read the aligned region around the data, at least
+                // directIOHeaderSize bytes or up to the end of the file.
+                const size_t a = directIOAlignment;
+                if (!headerBuf)
+                {
+                    headerBuf.reset(reinterpret_cast<uint8_t*>(
+                        memory::alignedAlloc(directIOHeaderSize + a, a)));
+                    if (!headerBuf)
+                    {
+                        throw std::runtime_error(getErrorMessage(ErrorType::Read, fileName));
+                    }
+                }
+                headerOffset = offset / a * a;
+                headerSize = 0;
+                const size_t length = std::max(
+                    directIOHeaderSize,
+                    (offset + size - headerOffset + a - 1) / a * a);
+                while (headerSize < length)
+                {
+                    const ssize_t r = ::pread(
+                        f,
+                        headerBuf.get() + headerSize,
+                        length - headerSize,
+                        headerOffset + headerSize);
+                    if (-1 == r)
+                    {
+                        if (EINTR == errno)
+                        {
+                            continue;
+                        }
+                        headerSize = 0;
+                        throw std::runtime_error(getErrorMessage(ErrorType::Read, fileName, getErrorString()));
+                    }
+                    else if (0 == r)
+                    {
+                        break;
+                    }
+                    headerSize += r;
+                }
+                if (offset + size > headerOffset + headerSize)
+                {
+                    throw std::runtime_error(getErrorMessage(ErrorType::Read, fileName));
+                }
+            }
+            memcpy(in, headerBuf.get() + offset - headerOffset, size);
+        }
+
+        void FileIO::Private::setPos(size_t in, bool seek)
+        {
+            switch (mode)
+            {
+            case Mode::Read:
+            {
+#if defined(TLR_ENABLE_MMAP)
+                if (mmapStart)
+                {
+                    if (!seek)
+                    {
+                        mmapP = reinterpret_cast<const uint8_t*>(mmapStart) + in;
+                    }
+                    else
+                    {
+                        mmapP += in;
+                    }
+                    if (mmapP > mmapEnd)
+                    {
+                        throw std::runtime_error(getErrorMessage(ErrorType::SeekMemoryMap, fileName));
+                    }
+                    break;
                 }
 #endif // TLR_ENABLE_MMAP
+                // Reads use the file position directly, so there is nothing
+                // to seek.
+                if (-1 == f)
+                {
+                    throw std::runtime_error(getErrorMessage(ErrorType::Seek, fileName));
+                }
                 break;
             }
             case Mode::Write:
@@ -10,6 +10,7 @@
 
 #include <codecvt>
 #include <locale>
+#include <mutex>
 #include <exception>
 
 #if defined(TLR_ENABLE_MMAP)
@@ -111,10 +112,12 @@ namespace tlr
 #endif // TLR_ENABLE_MMAP
 #if defined(TLR_ENABLE_MMAP)
             void*          mmap = nullptr;
+            std::shared_ptr<uint8_t> mmapRef;
             const uint8_t* mmapStart = nullptr;
             const uint8_t* mmapEnd = nullptr;
             const uint8_t* mmapP = nullptr;
 #endif // TLR_ENABLE_MMAP
+            std::mutex     readAtMutex;
         };
 
         FileIO::FileIO() :
@@ -126,7 +129,7 @@ namespace tlr
             close();
         }
 
-        void FileIO::open(const std::string& fileName, Mode mode)
+        void FileIO::open(const std::string& fileName, Mode mode, DirectIO)
         {
             TLR_PRIVATE_P();
 
@@ -195,6 +198,15 @@ namespace tlr
                     throw std::runtime_error(getErrorMessage(ErrorType::MemoryMap, fileName));
                 }
 
+                // The view is unmapped when the last reference is released,
+                // which may be after the file is closed. The view keeps the
+                // file mapping object alive.
+                p.mmapRef = std::shared_ptr<uint8_t>(
+                    const_cast<uint8_t*>(p.mmapStart),
+                    [](uint8_t* value)
+                    {
+                        ::UnmapViewOfFile(value);
+                    });
                 p.mmapEnd = p.mmapStart + p.size;
                 p.mmapP = p.mmapStart;
             }
@@ -274,18 +286,8 @@ namespace tlr
             p.fileName = std::string();
 
 #if defined(TLR_ENABLE_MMAP)
-            if (p.mmapStart != 0)
-            {
-                if (!::UnmapViewOfFile((void*)p.mmapStart))
-                {
-                    out = false;
-                    if (error)
-                    {
-                        *error = getErrorMessage(ErrorType::CloseMemoryMap, p.fileName, getLastError());
-                    }
-                }
-                p.mmapStart = 0;
-            }
+            p.mmapRef.reset();
+            p.mmapStart = 0;
             if (p.mmap != 0)
             {
                 if (!::CloseHandle(p.mmap))
@@ -365,6 +367,11 @@ namespace tlr
         {
             return _p->mmapEnd;
         }
+
+        std::shared_ptr<uint8_t> FileIO::mmapRef() const
+        {
+            return _p->mmapRef;
+        }
 #endif // TLR_ENABLE_MMAP
 
         bool FileIO::hasEndianConversion() const
@@ -463,6 +470,43 @@ namespace tlr
             p.pos += size * wordSize;
         }
 
+        void FileIO::readAt(size_t offset, void* in, size_t size)
+        {
+            TLR_PRIVATE_P();
+
+#if defined(TLR_ENABLE_MMAP)
+            if (p.mmapStart)
+            {
+                if (offset + size > p.size)
+                {
+                    throw std::runtime_error(getErrorMessage(ErrorType::ReadMemoryMap, p.fileName));
+                }
+                memcpy(in, p.mmapStart + offset, size);
+                return;
+            }
+#endif // TLR_ENABLE_MMAP
+
+            // Without a memory map the read goes through the file position,
+            // so save and restore it.
+            std::unique_lock<std::mutex> lock(p.readAtMutex);
+            const size_t pos = p.pos;
+            const bool endianConversion = p.endianConversion;
+            p.endianConversion = false;
+            try
+            {
+                p.setPos(offset, false);
+                read(in, size);
+            }
+            catch (const std::exception&)
+            {
+                p.endianConversion = endianConversion;
+                p.setPos(pos, false);
+                throw;
+            }
+            p.endianConversion = endianConversion;
+            p.setPos(pos, false);
+        }
+
         void FileIO::write(const void* in, size_t size, size_t wordSize)
         {
             TLR_PRIVATE_P();
@@ -4,8 +4,12 @@
 
 #include <tlrCore/File.h>
 
+#include <algorithm>
 #include <cstring>
+#include <limits>
 
+#include <dirent.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -22,6 +26,21 @@ namespace tlr
 {
     namespace file
     {
+        namespace
+        {
+            bool matchFileName(
+                const std::string& fileName,
+                const std::string& prefix,
+                const std::string& extension)
+            {
+                const size_t size = fileName.size();
+                return
+                    size >= prefix.size() + extension.size() &&
+                    0 == fileName.compare(0, prefix.size(), prefix) &&
+                    0 == fileName.compare(size - extension.size(), extension.size(), extension);
+            }
+        }
+
         bool exists(const std::string& fileName)
         {
             _STAT info;
@@ -88,5 +107,67 @@ namespace tlr
             buf[size] = 0;
             return mkdtemp(buf.data());
         }
+
+        void prefetch(const std::string& fileName)
+        {
+            const int fd = ::open(fileName.c_str(), O_RDONLY);
+            if (fd != -1)
+            {
+#if defined(__APPLE__)
+                struct stat info;
+                if (0 == fstat(fd, &info))
+                {
+                    struct radvisory advisory;
+                    advisory.ra_offset = 0;
+                    advisory.ra_count = static_cast<int>(std::min(
+                        info.st_size,
+                        static_cast<off_t>(std::numeric_limits<int>::max())));
+                    fcntl(fd, F_RDADVISE, &advisory);
+                }
+#else // __APPLE__
+                posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#endif // __APPLE__
+                ::close(fd);
+            }
+        }
+
+        std::vector<DirectoryEntry> listDirectory(
+            const std::string& path,
+            const std::string& prefix,
+            const std::string& extension)
+        {
+            std::vector<DirectoryEntry> out;
+            DIR* dir = opendir(!path.empty() ? path.c_str() : ".");
+            if (dir)
+            {
+                const int fd = dirfd(dir);
+                while (struct dirent* de = readdir(dir))
+                {
+                    // Only the matching files are queried for their size.
+                    // Entries that are known not to be files or links are
+                    // skipped without querying them.
+                    if (!matchFileName(de->d_name, prefix, extension))
+                    {
+                        continue;
+                    }
+#if defined(_DIRENT_HAVE_D_TYPE) || defined(__APPLE__)
+                    if (de->d_type != DT_REG && de->d_type != DT_LNK && de->d_type != DT_UNKNOWN)
+                    {
+                        continue;
+                    }
+#endif // _DIRENT_HAVE_D_TYPE
+                    struct stat info;
+                    if (0 == fstatat(fd, de->d_name, &info, 0) && S_ISREG(info.st_mode))
+                    {
+                        DirectoryEntry entry;
+                        entry.fileName = de->d_name;
+                        entry.size = info.st_size;
+                        out.push_back(entry);
+                    }
+                }
+                closedir(dir);
+            }
+            return out;
+        }
     }
 }
@@ -19,6 +19,21 @@ namespace tlr
 {
     namespace file
     {
+        namespace
+        {
+            bool matchFileName(
+                const std::string& fileName,
+                const std::string& prefix,
+                const std::string& extension)
+            {
+                const size_t size = fileName.size();
+                return
+                    size >= prefix.size() + extension.size() &&
+                    0 == fileName.compare(0, prefix.size(), prefix) &&
+                    0 == fileName.compare(size - extension.size(), extension.size(), extension);
+            }
+        }
+
         bool exists(const std::string& fileName)
         {
             _STAT info;
@@ -66,5 +81,41 @@ namespace tlr
 
             return out;
         }
+
+        void prefetch(const std::string&)
+        {}
+
+        std::vector<DirectoryEntry> listDirectory(
+            const std::string& path,
+            const std::string& prefix,
+            const std::string& extension)
+        {
+            std::vector<DirectoryEntry> out;
+            std::string glob = !path.empty() ? path : ".";
+            if (glob[glob.size() - 1] != '/' && glob[glob.size() - 1] != '\\')
+            {
+                glob += '\\';
+            }
+            glob += '*';
+            WIN32_FIND_DATAW data;
+            HANDLE handle = FindFirstFileW(string::toWide(glob).c_str(), &data);
+            if (handle != INVALID_HANDLE_VALUE)
+            {
+                do
+                {
+                    const std::string fileName = string::fromWide(data.cFileName);
+                    if (!(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) &&
+                        matchFileName(fileName, prefix, extension))
+                    {
+                        DirectoryEntry entry;
+                        entry.fileName = fileName;
+                        entry.size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) + data.nFileSizeLow;
+                        out.push_back(entry);
+                    }
+                } while (FindNextFileW(handle, &data));
+                FindClose(handle);
+            }
+            return out;
+        }
     }
 }
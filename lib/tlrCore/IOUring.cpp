@@ -0,0 +1,227 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCore/IOUring.h>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+namespace tlr
+{
+    namespace file
+    {
+        namespace
+        {
+            //! The largest read that is submitted at once; the kernel returns
+            //! a short read for anything larger.
+            const size_t readMax = 0x7ffff000;
+        }
+
+        struct IOUring::Private
+        {
+            int fd = -1;
+
+            void* sqRing = MAP_FAILED;
+            size_t sqRingSize = 0;
+            unsigned* sqHead = nullptr;
+            unsigned* sqTail = nullptr;
+            unsigned* sqMask = nullptr;
+            unsigned* sqEntries = nullptr;
+            unsigned* sqArray = nullptr;
+            io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+            size_t sqesSize = 0;
+            unsigned toSubmit = 0;
+
+            void* cqRing = MAP_FAILED;
+            size_t cqRingSize = 0;
+            unsigned* cqHead = nullptr;
+            unsigned* cqTail = nullptr;
+            unsigned* cqMask = nullptr;
+            io_uring_cqe* cqes = nullptr;
+        };
+
+        bool IOUring::_init(size_t entries)
+        {
+            TLR_PRIVATE_P();
+
+            io_uring_params params;
+            memset(&params, 0, sizeof(io_uring_params));
+            p.fd = syscall(__NR_io_uring_setup, static_cast<unsigned>(entries), &params);
+            if (p.fd < 0)
+            {
+                return false;
+            }
+
+            // Map the rings.
+            p.sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            p.cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+            if (singleMmap)
+            {
+                p.sqRingSize = p.cqRingSize = std::max(p.sqRingSize, p.cqRingSize);
+            }
+            p.sqRing = mmap(0, p.sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, p.fd, IORING_OFF_SQ_RING);
+            if (MAP_FAILED == p.sqRing)
+            {
+                return false;
+            }
+            if (singleMmap)
+            {
+                p.cqRing = p.sqRing;
+            }
+            else
+            {
+                p.cqRing = mmap(0, p.cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, p.fd, IORING_OFF_CQ_RING);
+                if (MAP_FAILED == p.cqRing)
+                {
+                    return false;
+                }
+            }
+            p.sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+            p.sqes = static_cast<io_uring_sqe*>(mmap(0, p.sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, p.fd, IORING_OFF_SQES));
+            if (MAP_FAILED == p.sqes)
+            {
+                return false;
+            }
+
+            uint8_t* sq = static_cast<uint8_t*>(p.sqRing);
+            p.sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+            p.sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            p.sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            p.sqEntries = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_entries);
+            p.sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+            uint8_t* cq = static_cast<uint8_t*>(p.cqRing);
+            p.cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            p.cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            p.cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            p.cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+            return true;
+        }
+
+        IOUring::IOUring() :
+            _p(new Private)
+        {}
+
+        IOUring::~IOUring()
+        {
+            TLR_PRIVATE_P();
+            if (p.sqes != MAP_FAILED)
+            {
+                munmap(p.sqes, p.sqesSize);
+            }
+            if (p.cqRing != MAP_FAILED && p.cqRing != p.sqRing)
+            {
+                munmap(p.cqRing, p.cqRingSize);
+            }
+            if (p.sqRing != MAP_FAILED)
+            {
+                munmap(p.sqRing, p.sqRingSize);
+            }
+            if (p.fd != -1)
+            {
+                close(p.fd);
+            }
+        }
+
+        std::unique_ptr<IOUring> IOUring::create(size_t entries)
+        {
+            std::unique_ptr<IOUring> out(new IOUring);
+            if (!out->_init(entries))
+            {
+                out.reset();
+            }
+            return out;
+        }
+
+        bool IOUring::read(int fd, void* data, size_t size, size_t offset, uint64_t userData)
+        {
+            TLR_PRIVATE_P();
+            const unsigned tail = *p.sqTail;
+            const unsigned head = __atomic_load_n(p.sqHead, __ATOMIC_ACQUIRE);
+            if (tail - head >= *p.sqEntries)
+            {
+                return false;
+            }
+            const unsigned index = tail & *p.sqMask;
+            io_uring_sqe* sqe = &p.sqes[index];
+            memset(sqe, 0, sizeof(io_uring_sqe));
+            sqe->opcode = IORING_OP_READ;
+            sqe->fd = fd;
+            sqe->addr = reinterpret_cast<uint64_t>(data);
+            sqe->len = static_cast<uint32_t>(std::min(size, readMax));
+            sqe->off = offset;
+            sqe->user_data = userData;
+            p.sqArray[index] = index;
+            __atomic_store_n(p.sqTail, tail + 1, __ATOMIC_RELEASE);
+            ++p.toSubmit;
+            return true;
+        }
+
+        bool IOUring::submit()
+        {
+            return _p->toSubmit > 0 ? _enter(0) : true;
+        }
+
+        bool IOUring::getCompletion(uint64_t& userData, int& result, bool wait)
+        {
+            TLR_PRIVATE_P();
+            while (true)
+            {
+                const unsigned head = *p.cqHead;
+                const unsigned tail = __atomic_load_n(p.cqTail, __ATOMIC_ACQUIRE);
+                if (head != tail)
+                {
+                    const io_uring_cqe& cqe = p.cqes[head & *p.cqMask];
+                    userData = cqe.user_data;
+                    result = cqe.res;
+                    __atomic_store_n(p.cqHead, head + 1, __ATOMIC_RELEASE);
+                    return true;
+                }
+                if (!wait || !_enter(1))
+                {
+                    break;
+                }
+            }
+            return false;
+        }
+
+        bool IOUring::_enter(unsigned minComplete)
+        {
+            TLR_PRIVATE_P();
+            while (true)
+            {
+                const int r = syscall(
+                    __NR_io_uring_enter,
+                    p.fd,
+                    p.toSubmit,
+                    minComplete,
+                    minComplete > 0 ? IORING_ENTER_GETEVENTS : 0,
+                    nullptr,
+                    0);
+                if (r >= 0)
+                {
+                    p.toSubmit -= std::min(static_cast<unsigned>(r), p.toSubmit);
+                    return true;
+                }
+                else if (EAGAIN == errno || EBUSY == errno)
+                {
+                    // The kernel is busy; the caller will try again after
+                    // collecting completions.
+                    return true;
+                }
+                else if (errno != EINTR)
+                {
+                    break;
+                }
+            }
+            return false;
+        }
+    }
+}
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlrCore/Util.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace tlr
+{
+    namespace file
+    {
+        //! Linux io_uring submission and completion rings.
+        //!
+        //! This is a minimal wrapper around the io_uring system calls that
+        //! only supports reads. It is not thread safe.
+        class IOUring
+        {
+            TLR_NON_COPYABLE(IOUring);
+
+        protected:
+            bool _init(size_t entries);
+            IOUring();
+
+        public:
+            ~IOUring();
+
+            //! Create new rings. Returns null if io_uring is not available.
+            static std::unique_ptr<IOUring> create(size_t entries);
+
+            //! Add a read to the submission ring. Returns false if the ring
+            //! is full.
+            bool read(int fd, void*, size_t, size_t offset, uint64_t userData);
+
+            //! Submit the reads that have been added.
+            bool submit();
+
+            //! Get a completion. If the wait flag is set this blocks until
+            //! a completion is available. The result is the number of bytes
+            //! read, or a negated errno value.
+            bool getCompletion(uint64_t& userData, int& result, bool wait);
+
+        private:
+            bool _enter(unsigned minComplete);
+
+            TLR_PRIVATE();
+        };
+    }
+}
@@ -6,12 +6,14 @@
 
 #include <tlrCore/Assert.h>
 #include <tlrCore/Error.h>
+#include <tlrCore/ImagePool.h>
 #include <tlrCore/String.h>
 
 #include <algorithm>
 #include <array>
 #include <cstring>
 #include <iostream>
+#include <type_traits>
 
 using namespace tlr::core;
 
@@ -92,7 +94,15 @@ namespace tlr
             "RGBA_F16",
             "RGBA_F32",
             
-            "YUV_420P");
+            "YUV_420P",
+            "YUV_422P",
+            "YUV_444P",
+            "YUV_420P_U10",
+            "YUV_422P_U10",
+            "YUV_444P_U10",
+            "YUV_420P_U16",
+            "YUV_422P_U16",
+            "YUV_444P_U16");
         TLR_ENUM_SERIALIZE_IMPL(PixelType);
 
         uint8_t getChannelCount(PixelType value)
@@ -104,7 +114,7 @@ namespace tlr
                 2, 2, 2, 2, 2,
                 3, 3, 3, 3, 3, 3,
                 4, 4, 4, 4, 4,
-                3
+                3, 3, 3, 3, 3, 3, 3, 3, 3
             };
             return values[static_cast<size_t>(value)];
         }
@@ -118,7 +128,7 @@ namespace tlr
                 8, 16, 32, 16, 32,
                 8, 10, 16, 32, 16, 32,
                 8, 16, 32, 16, 32,
-                0
+                8, 8, 8, 10, 10, 10, 16, 16, 16
             };
             return values[static_cast<size_t>(value)];
         }
@@ -202,6 +212,11 @@ namespace tlr
             return out;
         }
 
+        bool isYUV(PixelType value)
+        {
+            return value >= PixelType::YUV_420P && value <= PixelType::YUV_444P_U16;
+        }
+
         PixelType getClosest(PixelType value, const std::vector<PixelType>& types)
         {
             std::map<size_t, PixelType> diff;
@@ -213,6 +228,19 @@ namespace tlr
             return !diff.empty() ? diff.begin()->second : PixelType::None;
         }
 
+        TLR_ENUM_IMPL(
+            YUVRange,
+            "Full",
+            "Limited");
+        TLR_ENUM_SERIALIZE_IMPL(YUVRange);
+
+        TLR_ENUM_IMPL(
+            YUVCoefficients,
+            "BT601",
+            "BT709",
+            "BT2020");
+        TLR_ENUM_SERIALIZE_IMPL(YUVCoefficients);
+
         std::size_t getDataByteCount(const Info& info)
         {
             std::size_t out = 0;
@@ -246,9 +274,75 @@ namespace tlr
                 w * h * 4 * 2,
                 w * h * 4 * 4,
 
-                w * h + (w / 2 * h / 2) * 2
+                0, 0, 0,
+                0, 0, 0,
+                0, 0, 0
             };
-            return values[static_cast<size_t>(info.pixelType)];
+            if (isYUV(info.pixelType))
+            {
+                for (uint8_t i = 0; i < 3; ++i)
+                {
+                    out += getPlaneRowByteCount(info, i) * getPlaneSize(info, i).h;
+                }
+            }
+            else
+            {
+                out = values[static_cast<size_t>(info.pixelType)];
+            }
+            return out;
+        }
+
+        uint8_t getPlaneCount(PixelType value)
+        {
+            uint8_t out = 0;
+            if (isYUV(value))
+            {
+                out = 3;
+            }
+            else if (value != PixelType::None)
+            {
+                out = 1;
+            }
+            return out;
+        }
+
+        Size getPlaneSize(const Info& info, uint8_t plane)
+        {
+            Size out = info.size;
+            if (plane > 0)
+            {
+                switch (info.pixelType)
+                {
+                case PixelType::YUV_420P:
+                case PixelType::YUV_420P_U10:
+                case PixelType::YUV_420P_U16:
+                    out.w /= 2;
+                    out.h /= 2;
+                    break;
+                case PixelType::YUV_422P:
+                case PixelType::YUV_422P_U10:
+                case PixelType::YUV_422P_U16:
+                    out.w /= 2;
+                    break;
+                default: break;
+                }
+            }
+            return out;
+        }
+
+        std::size_t getPlaneRowByteCount(const Info& info, uint8_t plane)
+        {
+            std::size_t out = 0;
+            if (isYUV(info.pixelType))
+            {
+                // Samples of more than 8 bits are stored in 16 bits.
+                out = getPlaneSize(info, plane).w * (getBitDepth(info.pixelType) > 8 ? 2 : 1);
+            }
+            else
+            {
+                out = getDataByteCount(Info(info.size.w, 1, info.pixelType));
+            }
+            return out;
         }
 
         std::ostream& operator << (std::ostream& os, const imaging::Info& value)
@@ -257,23 +351,118 @@ namespace tlr
             return os;
         }
 
-        void Image::_init(const Info& info)
+        void Image::_init(const Info& info, const std::shared_ptr<ImagePool>& pool)
+        {
+            _info = info;
+            _dataByteCount = imaging::getDataByteCount(info);
+            if (_dataByteCount > 0)
+            {
+                _pool = pool;
+                _data = _pool->acquire(_dataByteCount);
+            }
+            _initPlanes();
+        }
+
+        void Image::_init(const Info& info, const uint8_t* data, const std::shared_ptr<void>& owner)
         {
             _info = info;
             _dataByteCount = imaging::getDataByteCount(info);
-            _data.resize(_dataByteCount);
+            _owner = owner;
+            _data = const_cast<uint8_t*>(data);
+            _readOnly = true;
+            _initPlanes();
+        }
+
+        void Image::_init(
+            const Info& info,
+            const std::vector<const uint8_t*>& planes,
+            const std::vector<size_t>& strides,
+            const std::shared_ptr<void>& owner)
+        {
+            TLR_ASSERT(planes.size() == imaging::getPlaneCount(info.pixelType));
+            TLR_ASSERT(strides.size() == planes.size());
+            _info = info;
+            _owner = owner;
+            for (const auto& i : planes)
+            {
+                _planes.push_back(const_cast<uint8_t*>(i));
+            }
+            _strides = strides;
+            _readOnly = true;
+            _data = !_planes.empty() ? _planes[0] : nullptr;
+            uint8_t* end = _data;
+            for (uint8_t i = 0; i < _planes.size(); ++i)
+            {
+                const size_t rowByteCount = getPlaneRowByteCount(info, i);
+                const size_t h = getPlaneSize(info, i).h;
+                if (_planes[i] != end || _strides[i] != rowByteCount)
+                {
+                    _packed = false;
+                }
+                end = _planes[i] + rowByteCount * h;
+                _dataByteCount += _strides[i] * h;
+            }
+        }
+
+        void Image::_initPlanes()
+        {
+            uint8_t* data = _data;
+            const uint8_t planeCount = imaging::getPlaneCount(_info.pixelType);
+            for (uint8_t i = 0; i < planeCount; ++i)
+            {
+                const size_t rowByteCount = getPlaneRowByteCount(_info, i);
+                _planes.push_back(data);
+                _strides.push_back(rowByteCount);
+                if (data)
+                {
+                    data += rowByteCount * getPlaneSize(_info, i).h;
+                }
+            }
         }
 
         Image::Image()
         {}
 
         Image::~Image()
-        {}
+        {
+            if (_data && _pool)
+            {
+                _pool->release(_dataByteCount, _data);
+            }
+        }
 
         std::shared_ptr<Image> Image::create(const Info& info)
+        {
+            return create(info, ImagePool::getGlobal());
+        }
+
+        std::shared_ptr<Image> Image::create(
+            const Info& info,
+            const std::shared_ptr<ImagePool>& pool)
+        {
+            auto out = std::shared_ptr<Image>(new Image);
+            out->_init(info, pool);
+            return out;
+        }
+
+        std::shared_ptr<Image> Image::create(
+            const Info& info,
+            const uint8_t* data,
+            const std::shared_ptr<void>& owner)
+        {
+            auto out = std::shared_ptr<Image>(new Image);
+            out->_init(info, data, owner);
+            return out;
+        }
+
+        std::shared_ptr<Image> Image::create(
+            const Info& info,
+            const std::vector<const uint8_t*>& planes,
+            const std::vector<size_t>& strides,
+            const std::shared_ptr<void>& owner)
         {
             auto out = std::shared_ptr<Image>(new Image);
-            out->_init(info);
+            out->_init(info, planes, strides, owner);
             return out;
         }
 
@@ -284,10 +473,246 @@ namespace tlr
 
         void Image::zero()
         {
-            if (!_data.empty())
+            TLR_ASSERT(!_readOnly);
+            if (_data)
+            {
+                std::memset(_data, 0, _dataByteCount);
+            }
+        }
+
+        std::shared_ptr<Image> pack(const std::shared_ptr<Image>& image)
+        {
+            if (image->isPacked())
+            {
+                return image;
+            }
+            const Info& info = image->getInfo();
+            auto out = Image::create(info);
+            out->setTags(image->getTags());
+            for (uint8_t i = 0; i < image->getPlaneCount(); ++i)
+            {
+                const uint8_t* in = image->getPlaneData(i);
+                const size_t inStride = image->getPlaneStride(i);
+                uint8_t* outP = out->getPlaneData(i);
+                const size_t rowByteCount = getPlaneRowByteCount(info, i);
+                const size_t h = getPlaneSize(info, i).h;
+                for (size_t y = 0; y < h; ++y, in += inStride, outP += rowByteCount)
+                {
+                    std::memcpy(outP, in, rowByteCount);
+                }
+            }
+            return out;
+        }
+
+        uint16_t getProxyLevel(const Size& size, const Size& target)
+        {
+            uint16_t out = 0;
+            if (size.isValid() && target.isValid())
             {
-                std::memset(&_data[0], 0, _dataByteCount);
+                // The image covers the target size when fitted to it as long
+                // as either dimension is at least as large as the target.
+                Size proxySize = size;
+                while (true)
+                {
+                    const Size next = getProxySize(size, out + 1);
+                    if (next == proxySize ||
+                        (next.w < target.w && next.h < target.h))
+                    {
+                        break;
+                    }
+                    proxySize = next;
+                    ++out;
+                }
             }
+            return out;
+        }
+
+        Size getProxySize(const Size& size, uint16_t level)
+        {
+            const uint32_t d = level < 16 ? (1U << level) : 0x10000U;
+            return Size(
+                size.w > 0 ? static_cast<uint16_t>((size.w + d - 1) / d) : 0,
+                size.h > 0 ? static_cast<uint16_t>((size.h + d - 1) / d) : 0);
+        }
+
+        namespace
+        {
+            template<typename A>
+            inline A average(A sum, A count, std::true_type)
+            {
+                return (sum + count / 2) / count;
+            }
+
+            template<typename A>
+            inline A average(A sum, A count, std::false_type)
+            {
+                return sum / count;
+            }
+
+            // Average the boxes of source pixels that map to each
+            // destination pixel.
+            template<typename T, typename A>
+            void downscaleBox(
+                const uint8_t* inData,
+                const Size& inSize,
+                size_t inStride,
+                uint8_t* outData,
+                const Size& outSize,
+                size_t channelCount)
+            {
+                T* out = reinterpret_cast<T*>(outData);
+                std::vector<size_t> xs(outSize.w + 1);
+                for (size_t x = 0; x <= outSize.w; ++x)
+                {
+                    xs[x] = x * inSize.w / outSize.w;
+                }
+                std::vector<A> sums(outSize.w * channelCount);
+                for (size_t y = 0; y < outSize.h; ++y)
+                {
+                    const size_t y0 = y * inSize.h / outSize.h;
+                    const size_t y1 = (y + 1) * inSize.h / outSize.h;
+                    std::fill(sums.begin(), sums.end(), A(0));
+                    for (size_t sy = y0; sy < y1; ++sy)
+                    {
+                        const T* inRow = reinterpret_cast<const T*>(inData + sy * inStride);
+                        A* sum = sums.data();
+                        for (size_t x = 0; x < outSize.w; ++x, sum += channelCount)
+                        {
+                            for (size_t sx = xs[x]; sx < xs[x + 1]; ++sx)
+                            {
+                                for (size_t c = 0; c < channelCount; ++c)
+                                {
+                                    sum[c] += static_cast<A>(inRow[sx * channelCount + c]);
+                                }
+                            }
+                        }
+                    }
+                    T* outRow = out + y * outSize.w * channelCount;
+                    for (size_t x = 0; x < outSize.w; ++x)
+                    {
+                        const A count = static_cast<A>((xs[x + 1] - xs[x]) * (y1 - y0));
+                        for (size_t c = 0; c < channelCount; ++c)
+                        {
+                            outRow[x * channelCount + c] = static_cast<T>(average(
+                                sums[x * channelCount + c],
+                                count,
+                                std::is_integral<A>()));
+                        }
+                    }
+                }
+            }
+
+            // Copy the first source pixel of each box.
+            void downscalePoint(
+                const uint8_t* in,
+                const Size& inSize,
+                size_t inStride,
+                uint8_t* out,
+                const Size& outSize,
+                size_t pixelByteCount)
+            {
+                for (size_t y = 0; y < outSize.h; ++y)
+                {
+                    const uint8_t* inRow = in + (y * inSize.h / outSize.h) * inStride;
+                    for (size_t x = 0; x < outSize.w; ++x, out += pixelByteCount)
+                    {
+                        std::memcpy(out, inRow + (x * inSize.w / outSize.w) * pixelByteCount, pixelByteCount);
+                    }
+                }
+            }
+        }
+
+        std::shared_ptr<Image> downscale(const std::shared_ptr<Image>& image, const Size& size)
+        {
+            const Info& info = image->getInfo();
+            if (!size.isValid() ||
+                !info.isValid() ||
+                (size.w >= info.size.w && size.h >= info.size.h))
+            {
+                return image;
+            }
+
+            Info outInfo = info;
+            outInfo.size = Size(std::min(size.w, info.size.w), std::min(size.h, info.size.h));
+            auto out = Image::create(outInfo);
+            out->setTags(image->getTags());
+
+            const uint8_t* in = image->getData();
+            const size_t inStride = image->getPlaneStride(0);
+            uint8_t* outData = out->getData();
+            const size_t channelCount = getChannelCount(info.pixelType);
+            const bool nativeEndian =
+                info.layout.endian == memory::getEndian() ||
+                8 == getBitDepth(info.pixelType);
+            if (isYUV(info.pixelType))
+            {
+                for (uint8_t i = 0; i < 3; ++i)
+                {
+                    const Size inPlaneSize = getPlaneSize(info, i);
+                    const Size outPlaneSize = getPlaneSize(outInfo, i);
+                    if (!inPlaneSize.isValid() || !outPlaneSize.isValid())
+                    {
+                        continue;
+                    }
+                    const uint8_t* inPlane = image->getPlaneData(i);
+                    const size_t inPlaneStride = image->getPlaneStride(i);
+                    uint8_t* outPlane = out->getPlaneData(i);
+                    if (8 == getBitDepth(info.pixelType))
+                    {
+                        downscaleBox<U8_T, uint32_t>(inPlane, inPlaneSize, inPlaneStride, outPlane, outPlaneSize, 1);
+                    }
+                    else if (nativeEndian)
+                    {
+                        downscaleBox<U16_T, uint64_t>(inPlane, inPlaneSize, inPlaneStride, outPlane, outPlaneSize, 1);
+                    }
+                    else
+                    {
+                        downscalePoint(inPlane, inPlaneSize, inPlaneStride, outPlane, outPlaneSize, 2);
+                    }
+                }
+            }
+            else if (PixelType::RGB_U10 == info.pixelType || !nativeEndian)
+            {
+                downscalePoint(in, info.size, inStride, outData, outInfo.size, getDataByteCount(Info(1, 1, info.pixelType)));
+            }
+            else
+            {
+                switch (info.pixelType)
+                {
+                case PixelType::L_U8:
+                case PixelType::LA_U8:
+                case PixelType::RGB_U8:
+                case PixelType::RGBA_U8:
+                    downscaleBox<U8_T, uint32_t>(in, info.size, inStride, outData, outInfo.size, channelCount);
+                    break;
+                case PixelType::L_U16:
+                case PixelType::LA_U16:
+                case PixelType::RGB_U16:
+                case PixelType::RGBA_U16:
+                    downscaleBox<U16_T, uint64_t>(in, info.size, inStride, outData, outInfo.size, channelCount);
+                    break;
+                case PixelType::L_U32:
+                case PixelType::LA_U32:
+                case PixelType::RGB_U32:
+                case PixelType::RGBA_U32:
+                    downscaleBox<U32_T, uint64_t>(in, info.size, inStride, outData, outInfo.size, channelCount);
+                    break;
+                case PixelType::L_F16:
+                case PixelType::LA_F16:
+                case PixelType::RGB_F16:
+                case PixelType::RGBA_F16:
+                    downscaleBox<F16_T, float>(in, info.size, inStride, outData, outInfo.size, channelCount);
+                    break;
+                case PixelType::L_F32:
+                case PixelType::LA_F32:
+                case PixelType::RGB_F32:
+                case PixelType::RGBA_F32:
+                    downscaleBox<F32_T, float>(in, info.size, inStride, outData, outInfo.size, channelCount);
+                    break;
+                default: break;
+                }
+            }
+            return out;
         }
     }
 }
@@ -89,6 +89,14 @@ namespace tlr
             RGBA_F32,
             
             YUV_420P,
+            YUV_422P,
+            YUV_444P,
+            YUV_420P_U10,
+            YUV_422P_U10,
+            YUV_444P_U10,
+            YUV_420P_U16,
+            YUV_422P_U16,
+            YUV_444P_U16,
 
             Count,
             First = None
@@ -153,9 +161,37 @@ namespace tlr
         //! Determine the floating point pixel type for a given channel count and bit depth.
         PixelType getFloatType(std::size_t channelCount, std::size_t bitDepth);
 
+        //! Is the given pixel type planar YUV?
+        bool isYUV(PixelType);
+
         //! Get the closest pixel type for the given pixel type.
         PixelType getClosest(PixelType, const std::vector<PixelType>&);
 
+        //! YUV value ranges.
+        enum class YUVRange
+        {
+            Full,
+            Limited,
+
+            Count,
+            First = Full
+        };
+        TLR_ENUM(YUVRange);
+        TLR_ENUM_SERIALIZE(YUVRange);
+
+        //! YUV to RGB conversion coefficients.
+        enum class YUVCoefficients
+        {
+            BT601,
+            BT709,
+            BT2020,
+
+            Count,
+            First = BT601
+        };
+        TLR_ENUM(YUVCoefficients);
+        TLR_ENUM_SERIALIZE(YUVCoefficients);
+
         ///@}
 
         //! Image mirroring.
@@ -198,10 +234,12 @@ namespace tlr
             explicit Info(const Size&, PixelType);
             explicit Info(uint16_t w, uint16_t h, PixelType);
 
-            Size      size;
-            float     pixelAspectRatio;
-            PixelType pixelType;
-            Layout    layout;
+            Size            size;
+            float           pixelAspectRatio;
+            PixelType       pixelType;
+            YUVRange        yuvRange;
+            YUVCoefficients yuvCoefficients;
+            Layout          layout;
 
             //! Is the information valid?
             bool isValid() const;
@@ -213,23 +251,72 @@ namespace tlr
         //! Get the number of bytes used to store the image data.
         std::size_t getDataByteCount(const Info&);
 
+        //! Get the number of planes used to store the image data.
+        uint8_t getPlaneCount(PixelType);
+
+        //! Get the size of an image plane.
+        Size getPlaneSize(const Info&, uint8_t plane);
+
+        //! Get the number of bytes in a row of a tightly packed image plane.
+        std::size_t getPlaneRowByteCount(const Info&, uint8_t plane);
+
         std::ostream& operator << (std::ostream&, const imaging::Info&);
 
+        class ImagePool;
+
         //! Image.
+        //!
+        //! The image data is allocated from an image pool and is not
+        //! initialized. Images can also wrap external memory, such as a
+        //! memory-mapped file, which is kept alive by an owner.
+        //!
+        //! The planes of images that wrap external memory may have a row
+        //! stride, and are not necessarily stored one after the other. The
+        //! image data of these images is the first plane, and the other
+        //! planes are accessed with getPlaneData().
         class Image : public std::enable_shared_from_this<Image>
         {
             TLR_NON_COPYABLE(Image);
 
         protected:
-            void _init(const Info&);
+            void _init(const Info&, const std::shared_ptr<ImagePool>&);
+            void _init(const Info&, const uint8_t*, const std::shared_ptr<void>&);
+            void _init(
+                const Info&,
+                const std::vector<const uint8_t*>&,
+                const std::vector<size_t>&,
+                const std::shared_ptr<void>&);
             Image();
 
         public:
             ~Image();
 
-            //! Create a new image.
+            //! Create a new image using the global image pool.
             static std::shared_ptr<Image> create(const Info&);
 
+            //! Create a new image using the given image pool.
+            static std::shared_ptr<Image> create(
+                const Info&,
+                const std::shared_ptr<ImagePool>&);
+
+            //! Create a new read-only image that uses external memory, such
+            //! as a memory-mapped file or a decoder buffer. The owner is held
+            //! until the image is destroyed.
+            static std::shared_ptr<Image> create(
+                const Info&,
+                const uint8_t* data,
+                const std::shared_ptr<void>& owner);
+
+            //! Create a new read-only image that uses external memory for
+            //! each plane, with the given number of bytes between the rows
+            //! of each plane. The owner is held until the image is
+            //! destroyed.
+            static std::shared_ptr<Image> create(
+                const Info&,
+                const std::vector<const uint8_t*>& planes,
+                const std::vector<size_t>& strides,
+                const std::shared_ptr<void>& owner);
+
             //! Get the image information.
             const Info& getInfo() const;
 
@@ -263,18 +350,73 @@ namespace tlr
             //! Get the image data.
             const uint8_t* getData() const;
 
-            //! Get the image data.
+            //! Get the image data. The data of read-only images must not be
+            //! modified.
             uint8_t* getData();
 
-            //! Zero the image data.
+            //! Get the number of image planes.
+            uint8_t getPlaneCount() const;
+
+            //! Get the data of an image plane.
+            const uint8_t* getPlaneData(uint8_t) const;
+
+            //! Get the data of an image plane. The data of read-only images
+            //! must not be modified.
+            uint8_t* getPlaneData(uint8_t);
+
+            //! Get the number of bytes between the rows of an image plane.
+            size_t getPlaneStride(uint8_t) const;
+
+            //! Are the image planes tightly packed one after the other?
+            bool isPacked() const;
+
+            //! Is the image data read-only?
+            bool isReadOnly() const;
+
+            //! Zero the image data. The image must not be read-only.
             void zero();
 
         private:
+            void _initPlanes();
+
             Info _info;
             std::map<std::string, std::string> _tags;
             size_t _dataByteCount = 0;
-            std::vector<uint8_t> _data;
+            std::vector<uint8_t*> _planes;
+            std::vector<size_t> _strides;
+            bool _packed = true;
+            bool _readOnly = false;
+            std::shared_ptr<ImagePool> _pool;
+            std::shared_ptr<void> _owner;
+            uint8_t* _data = nullptr;
         };
+
+        //! Get an image with the planes tightly packed one after the other,
+        //! copying the data if necessary. Packed images are returned
+        //! unchanged.
+        std::shared_ptr<Image> pack(const std::shared_ptr<Image>&);
+
+        //! \name Proxies
+        ///@{
+
+        //! Get the proxy level for reading an image of the given size for
+        //! display at the target size. Each level halves the image size,
+        //! and the highest level is chosen where the image still covers the
+        //! target size when fitted to it. Level zero is the full size, which
+        //! is also returned when the target size is not valid.
+        uint16_t getProxyLevel(const Size& size, const Size& target);
+
+        //! Get the image size for the given proxy level. Odd sizes are
+        //! rounded up.
+        Size getProxySize(const Size&, uint16_t level);
+
+        //! Scale an image down to the given size. The pixels are averaged
+        //! with a box filter, except for packed and byte-swapped pixel data
+        //! which is point sampled. The image is returned unchanged if it is
+        //! not larger than the given size.
+        std::shared_ptr<Image> downscale(const std::shared_ptr<Image>&, const Size&);
+
+        ///@}
     }
 }
 
@@ -108,19 +108,25 @@ namespace tlr
 
         inline Info::Info() :
             pixelAspectRatio(1.F),
-            pixelType(PixelType::None)
+            pixelType(PixelType::None),
+            yuvRange(YUVRange::Full),
+            yuvCoefficients(YUVCoefficients::BT601)
         {}
 
         inline Info::Info(const Size& size, PixelType pixelType) :
             size(size),
             pixelAspectRatio(1.F),
-            pixelType(pixelType)
+            pixelType(pixelType),
+            yuvRange(YUVRange::Full),
+            yuvCoefficients(YUVCoefficients::BT601)
         {}
 
         inline Info::Info(uint16_t w, uint16_t h, PixelType pixelType) :
             size(w, h),
             pixelAspectRatio(1.F),
-            pixelType(pixelType)
+            pixelType(pixelType),
+            yuvRange(YUVRange::Full),
+            yuvCoefficients(YUVCoefficients::BT601)
         {}
 
         inline bool Info::isValid() const
@@ -133,6 +139,8 @@ namespace tlr
             return size == other.size &&
                 pixelAspectRatio == other.pixelAspectRatio &&
                 pixelType == other.pixelType &&
+                yuvRange == other.yuvRange &&
+                yuvCoefficients == other.yuvCoefficients &&
                 layout == other.layout;
         }
 
@@ -188,12 +196,42 @@ namespace tlr
 
         inline const uint8_t* Image::getData() const
         {
-            return _data.data();
+            return _data;
         }
 
         inline uint8_t* Image::getData()
         {
-            return _data.data();
+            return _data;
+        }
+
+        inline uint8_t Image::getPlaneCount() const
+        {
+            return static_cast<uint8_t>(_planes.size());
+        }
+
+        inline const uint8_t* Image::getPlaneData(uint8_t index) const
+        {
+            return _planes[index];
+        }
+
+        inline uint8_t* Image::getPlaneData(uint8_t index)
+        {
+            return _planes[index];
+        }
+
+        inline size_t Image::getPlaneStride(uint8_t index) const
+        {
+            return _strides[index];
+        }
+
+        inline bool Image::isPacked() const
+        {
+            return _packed;
+        }
+
+        inline bool Image::isReadOnly() const
+        {
+            return _readOnly;
         }
     }
 }
@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCore/ImagePool.h>
+
+#include <map>
+#include <mutex>
+#include <new>
+
+namespace tlr
+{
+    namespace imaging
+    {
+        struct ImagePool::Private
+        {
+            std::size_t max = imagePoolMaxByteCount;
+            ImagePoolStats stats;
+            std::map<std::size_t, std::vector<uint8_t*> > buffers;
+            mutable std::mutex mutex;
+        };
+
+        void ImagePool::_init()
+        {}
+
+        ImagePool::ImagePool() :
+            _p(new Private)
+        {}
+
+        ImagePool::~ImagePool()
+        {
+            _trim(0);
+        }
+
+        std::shared_ptr<ImagePool> ImagePool::create()
+        {
+            auto out = std::shared_ptr<ImagePool>(new ImagePool);
+            out->_init();
+            return out;
+        }
+
+        const std::shared_ptr<ImagePool>& ImagePool::getGlobal()
+        {
+            static const std::shared_ptr<ImagePool> pool = ImagePool::create();
+            return pool;
+        }
+
+        std::size_t ImagePool::getMax() const
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.max;
+        }
+
+        void ImagePool::setMax(std::size_t value)
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.max = value;
+            _trim(p.max);
+        }
+
+        ImagePoolStats ImagePool::getStats() const
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.stats;
+        }
+
+        void ImagePool::trim(std::size_t byteCount)
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            _trim(byteCount);
+        }
+
+        uint8_t* ImagePool::acquire(std::size_t byteCount)
+        {
+            TLR_PRIVATE_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                const auto i = p.buffers.find(byteCount);
+                if (i != p.buffers.end() && !i->second.empty())
+                {
+                    uint8_t* out = i->second.back();
+                    i->second.pop_back();
+                    --p.stats.count;
+                    p.stats.byteCount -= byteCount;
+                    ++p.stats.hits;
+                    return out;
+                }
+                ++p.stats.misses;
+            }
+            uint8_t* out = reinterpret_cast<uint8_t*>(memory::alignedAlloc(byteCount));
+            if (!out)
+            {
+                throw std::bad_alloc();
+            }
+            return out;
+        }
+
+        void ImagePool::release(std::size_t byteCount, uint8_t* value)
+        {
+            TLR_PRIVATE_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (p.stats.byteCount + byteCount <= p.max)
+                {
+                    p.buffers[byteCount].push_back(value);
+                    ++p.stats.count;
+                    p.stats.byteCount += byteCount;
+                    return;
+                }
+            }
+            memory::alignedFree(value);
+        }
+
+        void ImagePool::_trim(std::size_t byteCount)
+        {
+            TLR_PRIVATE_P();
+            auto i = p.buffers.rbegin();
+            while (p.stats.byteCount > byteCount && i != p.buffers.rend())
+            {
+                while (p.stats.byteCount > byteCount && !i->second.empty())
+                {
+                    memory::alignedFree(i->second.back());
+                    i->second.pop_back();
+                    --p.stats.count;
+                    p.stats.byteCount -= i->first;
+                }
+                ++i;
+            }
+        }
+    }
+}
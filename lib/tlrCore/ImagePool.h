@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlrCore/Image.h>
+
+namespace tlr
+{
+    namespace imaging
+    {
+        //! Default maximum number of bytes held by an image pool.
+        const std::size_t imagePoolMaxByteCount = memory::gigabyte;
+
+        //! Image pool statistics.
+        struct ImagePoolStats
+        {
+            //! Number of buffers that were re-used.
+            std::size_t hits = 0;
+
+            //! Number of buffers that were allocated.
+            std::size_t misses = 0;
+
+            //! Number of free buffers held by the pool.
+            std::size_t count = 0;
+
+            //! Number of bytes held by the pool's free buffers.
+            std::size_t byteCount = 0;
+
+            bool operator == (const ImagePoolStats&) const;
+            bool operator != (const ImagePoolStats&) const;
+        };
+
+        //! Image data pool.
+        //!
+        //! The pool hands out uninitialized buffers aligned to
+        //! memory::defaultAlignment. Buffers go back to the pool when the
+        //! image that owns them is destroyed, and are re-used by the next
+        //! image with the same number of data bytes. This avoids allocating
+        //! and zero filling the image data for every frame during playback.
+        //!
+        //! The pool is thread safe.
+        class ImagePool : public std::enable_shared_from_this<ImagePool>
+        {
+            TLR_NON_COPYABLE(ImagePool);
+
+        protected:
+            void _init();
+            ImagePool();
+
+        public:
+            ~ImagePool();
+
+            //! Create a new image pool.
+            static std::shared_ptr<ImagePool> create();
+
+            //! Get the global image pool, used by Image::create().
+            static const std::shared_ptr<ImagePool>& getGlobal();
+
+            //! Get the maximum number of bytes held by free buffers.
+            std::size_t getMax() const;
+
+            //! Set the maximum number of bytes held by free buffers. Buffers
+            //! that are released while the pool is full are freed.
+            void setMax(std::size_t);
+
+            //! Get the statistics.
+            ImagePoolStats getStats() const;
+
+            //! Free buffers until the pool holds no more than the given
+            //! number of bytes.
+            void trim(std::size_t byteCount = 0);
+
+            //! Get a buffer from the pool. The buffer is uninitialized.
+            uint8_t* acquire(std::size_t byteCount);
+
+            //! Return a buffer to the pool.
+            void release(std::size_t byteCount, uint8_t*);
+
+        private:
+            void _trim(std::size_t);
+
+            TLR_PRIVATE();
+        };
+    }
+}
+
+#include <tlrCore/ImagePoolInline.h>
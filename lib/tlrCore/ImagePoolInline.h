@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+namespace tlr
+{
+    namespace imaging
+    {
+        inline bool ImagePoolStats::operator == (const ImagePoolStats& other) const
+        {
+            return
+                hits == other.hits &&
+                misses == other.misses &&
+                count == other.count &&
+                byteCount == other.byteCount;
+        }
+
+        inline bool ImagePoolStats::operator != (const ImagePoolStats& other) const
+        {
+            return !(*this == other);
+        }
+    }
+}
@@ -34,12 +34,18 @@ namespace tlr
         void warningFunc(j_common_ptr, int level);
 
         //! JPEG reader.
+        //!
+        //! When the "JPEG/YUV" option is set, YCbCr files are decoded to
+        //! YUV_420P images without color conversion or chroma upsampling,
+        //! and are converted to RGB by the renderer instead.
         class Read : public avio::ISequenceRead
         {
         protected:
             void _init(
                 const file::Path&,
                 const avio::Options&,
+                const std::shared_ptr<avio::Cache>&,
+                const std::shared_ptr<core::ThreadPool>&,
                 const std::shared_ptr<core::LogSystem>&);
             Read();
 
@@ -50,13 +56,20 @@ namespace tlr
             static std::shared_ptr<Read> create(
                 const file::Path&,
                 const avio::Options&,
+                const std::shared_ptr<avio::Cache>&,
+                const std::shared_ptr<core::ThreadPool>&,
                 const std::shared_ptr<core::LogSystem>&);
 
         protected:
             avio::Info _getInfo(const std::string& fileName) override;
             avio::VideoFrame _readVideoFrame(
                 const std::string& fileName,
-                const otime::RationalTime&) override;
+                const otime::RationalTime&,
+                uint16_t proxyLevel) override;
+            std::string _getCacheOptions() const override;
+
+        private:
+            TLR_PRIVATE();
         };
 
         //! JPEG writer.
@@ -6,7 +6,9 @@
 
 #include <tlrCore/StringFormat.h>
 
+#include <algorithm>
 #include <cstring>
+#include <sstream>
 
 namespace tlr
 {
@@ -14,6 +16,63 @@ namespace tlr
     {
         namespace
         {
+#if JPEG_LIB_VERSION >= 70
+            int getHScaledSize(const jpeg_component_info& component)
+            {
+                return component.DCT_h_scaled_size;
+            }
+
+            int getVScaledSize(const jpeg_component_info& component)
+            {
+                return component.DCT_v_scaled_size;
+            }
+#else // JPEG_LIB_VERSION
+            int getHScaledSize(const jpeg_component_info& component)
+            {
+                return component.DCT_scaled_size;
+            }
+
+            int getVScaledSize(const jpeg_component_info& component)
+            {
+                return component.DCT_scaled_size;
+            }
+#endif // JPEG_LIB_VERSION
+
+            //! Get how many luma samples each sample of the component
+            //! covers horizontally and vertically.
+            void getSubsampling(
+                const jpeg_decompress_struct* decompress,
+                const jpeg_component_info& component,
+                int& x,
+                int& y)
+            {
+                const auto& luma = decompress->comp_info[0];
+                x = (decompress->max_h_samp_factor * getHScaledSize(luma)) /
+                    (component.h_samp_factor * getHScaledSize(component));
+                y = (decompress->max_v_samp_factor * getVScaledSize(luma)) /
+                    (component.v_samp_factor * getVScaledSize(component));
+            }
+
+            //! Can the file be decoded as raw YCbCr data into a YUV_420P
+            //! image? The luma must be full resolution, and the chroma
+            //! either full resolution or subsampled by two.
+            bool isRawYUV(const jpeg_decompress_struct* decompress)
+            {
+                bool out =
+                    JCS_YCbCr == decompress->jpeg_color_space &&
+                    3 == decompress->num_components &&
+                    decompress->comp_info[0].h_samp_factor == decompress->max_h_samp_factor &&
+                    decompress->comp_info[0].v_samp_factor == decompress->max_v_samp_factor;
+                for (int i = 1; i < 3 && out; ++i)
+                {
+                    int x = 0;
+                    int y = 0;
+                    getSubsampling(decompress, decompress->comp_info[i], x, y);
+                    out = (1 == x || 2 == x) && (1 == y || 2 == y);
+                }
+                return out;
+            }
+
             bool jpegCreate(
                 jpeg_decompress_struct* decompress,
                 ErrorStruct* error)
@@ -29,6 +88,8 @@ namespace tlr
             bool jpegOpen(
                 FILE* f,
                 jpeg_decompress_struct* decompress,
+                unsigned int scaleDenom,
+                bool yuv,
                 ErrorStruct* error)
             {
                 if (::setjmp(error->jump))
@@ -41,6 +102,15 @@ namespace tlr
                 {
                     return false;
                 }
+                decompress->scale_num = 1;
+                decompress->scale_denom = scaleDenom;
+                if (yuv)
+                {
+                    // The component sizes are needed to check whether the
+                    // raw data fits the image layout.
+                    jpeg_calc_output_dimensions(decompress);
+                    decompress->raw_data_out = static_cast<boolean>(isRawYUV(decompress));
+                }
                 if (!jpeg_start_decompress(decompress))
                 {
                     return false;
@@ -48,21 +118,32 @@ namespace tlr
                 return true;
             }
 
-            bool jpegScanline(
+            bool jpegScanlines(
                 jpeg_decompress_struct* decompress,
-                uint8_t* out,
+                JSAMPARRAY rows,
+                JDIMENSION count,
+                JDIMENSION& read,
                 ErrorStruct* error)
             {
                 if (::setjmp(error->jump))
                 {
                     return false;
                 }
-                JSAMPROW p[] = { (JSAMPLE*)(out) };
-                if (!jpeg_read_scanlines(decompress, p, 1))
+                read = jpeg_read_scanlines(decompress, rows, count);
+                return read > 0;
+            }
+
+            bool jpegRawData(
+                jpeg_decompress_struct* decompress,
+                JSAMPIMAGE planes,
+                JDIMENSION count,
+                ErrorStruct* error)
+            {
+                if (::setjmp(error->jump))
                 {
                     return false;
                 }
-                return true;
+                return jpeg_read_raw_data(decompress, planes, count) > 0;
             }
 
             bool jpegEnd(
@@ -80,7 +161,7 @@ namespace tlr
             class File
             {
             public:
-                File(const std::string& fileName)
+                File(const std::string& fileName, bool yuv, uint16_t proxyLevel = 0)
                 {
                     std::memset(&_decompress, 0, sizeof(jpeg_decompress_struct));
 
@@ -97,12 +178,18 @@ namespace tlr
                     {
                         throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
                     }
-                    if (!jpegOpen(_f, &_decompress, &_error))
+
+                    // Proxies are decoded at a reduced size by scaling the
+                    // DCT, which supports scales down to 1/8.
+                    const unsigned int scaleDenom = 1U << std::min(proxyLevel, static_cast<uint16_t>(3));
+                    if (!jpegOpen(_f, &_decompress, scaleDenom, yuv, &_error))
                     {
                         throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
                     }
 
-                    imaging::PixelType pixelType = imaging::getIntType(_decompress.out_color_components, 8);
+                    imaging::PixelType pixelType = _decompress.raw_data_out ?
+                        imaging::PixelType::YUV_420P :
+                        imaging::getIntType(_decompress.out_color_components, 8);
                     if (imaging::PixelType::None == pixelType)
                     {
                         throw std::runtime_error(string::Format("{0}: File not supported").arg(fileName));
@@ -144,22 +231,33 @@ namespace tlr
                     out.image = imaging::Image::create(info);
                     out.image->setTags(_info.tags);
 
-                    std::size_t scanlineByteCount = 0;
-                    switch (info.pixelType)
+                    if (_decompress.raw_data_out)
                     {
-                    case imaging::PixelType::L_U8:
-                        scanlineByteCount = info.size.w;
-                        break;
-                    case imaging::PixelType::RGB_U8:
-                        scanlineByteCount = info.size.w * 3;
-                        break;
-                    default: break;
+                        _readRaw(out.image);
                     }
-                    for (uint16_t y = 0; y < info.size.h; ++y)
+                    else
                     {
-                        if (!jpegScanline(&_decompress, out.image->getData() + scanlineByteCount * y, &_error))
+                        // Decode as many scanlines as the library can
+                        // provide with each call.
+                        const size_t scanlineByteCount =
+                            static_cast<size_t>(info.size.w) * _decompress.out_color_components;
+                        std::vector<JSAMPROW> rows(info.size.h);
+                        for (uint16_t y = 0; y < info.size.h; ++y)
                         {
-                            break;
+                            rows[y] = out.image->getData() + scanlineByteCount * y;
+                        }
+                        while (_decompress.output_scanline < _decompress.output_height)
+                        {
+                            JDIMENSION read = 0;
+                            if (!jpegScanlines(
+                                &_decompress,
+                                rows.data() + _decompress.output_scanline,
+                                _decompress.output_height - _decompress.output_scanline,
+                                read,
+                                &_error))
+                            {
+                                break;
+                            }
                         }
                     }
 
@@ -169,6 +267,84 @@ namespace tlr
                 }
 
             private:
+                void _readRaw(const std::shared_ptr<imaging::Image>& image)
+                {
+                    const size_t w = image->getWidth();
+                    const size_t h = image->getHeight();
+                    const size_t w2 = w / 2;
+                    const size_t h2 = h / 2;
+
+                    // Each call decodes one row of MCUs into buffers that
+                    // are padded to whole DCT blocks, which are then copied
+                    // into the image planes. Full resolution chroma is
+                    // subsampled by two.
+                    std::vector<uint8_t> buffers[3];
+                    std::vector<JSAMPROW> rows[3];
+                    size_t rowCounts[3] = { 0, 0, 0 };
+                    int subsampling[3][2] = { { 1, 1 }, { 1, 1 }, { 1, 1 } };
+                    JSAMPARRAY planes[3];
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        const auto& component = _decompress.comp_info[i];
+                        getSubsampling(&_decompress, component, subsampling[i][0], subsampling[i][1]);
+                        const size_t rowByteCount = component.width_in_blocks * getHScaledSize(component);
+                        rowCounts[i] = component.v_samp_factor * getVScaledSize(component);
+                        buffers[i].resize(rowByteCount * rowCounts[i]);
+                        for (size_t j = 0; j < rowCounts[i]; ++j)
+                        {
+                            rows[i].push_back(buffers[i].data() + rowByteCount * j);
+                        }
+                        planes[i] = rows[i].data();
+                    }
+
+                    const JDIMENSION lines = static_cast<JDIMENSION>(rowCounts[0]);
+                    uint8_t* yPlane = image->getData();
+                    uint8_t* chromaPlanes[2] = { yPlane + w * h, yPlane + w * h + w2 * h2 };
+                    while (_decompress.output_scanline < _decompress.output_height)
+                    {
+                        const size_t line = _decompress.output_scanline;
+                        if (!jpegRawData(&_decompress, planes, lines, &_error))
+                        {
+                            break;
+                        }
+                        for (size_t j = 0; j < rowCounts[0] && line + j < h; ++j)
+                        {
+                            std::memcpy(yPlane + (line + j) * w, rows[0][j], w);
+                        }
+                        for (int i = 1; i < 3; ++i)
+                        {
+                            const int xStep = 2 / subsampling[i][0];
+                            const int yStep = 2 / subsampling[i][1];
+                            const size_t componentLine = line / subsampling[i][1];
+                            for (size_t j = 0; j < rowCounts[i]; ++j)
+                            {
+                                if ((componentLine + j) % yStep != 0)
+                                {
+                                    continue;
+                                }
+                                const size_t y = (componentLine + j) / yStep;
+                                if (y >= h2)
+                                {
+                                    break;
+                                }
+                                uint8_t* outP = chromaPlanes[i - 1] + y * w2;
+                                const uint8_t* inP = rows[i][j];
+                                if (1 == xStep)
+                                {
+                                    std::memcpy(outP, inP, w2);
+                                }
+                                else
+                                {
+                                    for (size_t x = 0; x < w2; ++x, inP += 2)
+                                    {
+                                        outP[x] = *inP;
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+
                 FILE*                  _f = nullptr;
                 jpeg_decompress_struct _decompress;
                 bool                   _init = false;
@@ -177,42 +353,69 @@ namespace tlr
             };
         }
 
+        struct Read::Private
+        {
+            bool yuv = false;
+        };
+
         void Read::_init(
             const file::Path& path,
             const avio::Options& options,
+            const std::shared_ptr<avio::Cache>& cache,
+            const std::shared_ptr<core::ThreadPool>& threadPool,
             const std::shared_ptr<core::LogSystem>& logSystem)
         {
-            ISequenceRead::_init(path, options, logSystem);
+            TLR_PRIVATE_P();
+
+            const auto i = options.find("JPEG/YUV");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.yuv;
+            }
+
+            ISequenceRead::_init(path, options, cache, threadPool, logSystem);
         }
 
-        Read::Read()
+        Read::Read() :
+            _p(new Private)
         {}
 
         Read::~Read()
-        {}
+        {
+            _finish();
+        }
 
         std::shared_ptr<Read> Read::create(
             const file::Path& path,
             const avio::Options& options,
+            const std::shared_ptr<avio::Cache>& cache,
+            const std::shared_ptr<core::ThreadPool>& threadPool,
             const std::shared_ptr<core::LogSystem>& logSystem)
         {
             auto out = std::shared_ptr<Read>(new Read);
-            out->_init(path, options, logSystem);
+            out->_init(path, options, cache, threadPool, logSystem);
             return out;
         }
 
+        std::string Read::_getCacheOptions() const
+        {
+            return _p->yuv ? "YUV" : std::string();
+        }
+
         avio::Info Read::_getInfo(const std::string& fileName)
         {
-            avio::Info out = std::unique_ptr<File>(new File(fileName))->getInfo();
+            avio::Info out = std::unique_ptr<File>(new File(fileName, _p->yuv))->getInfo();
             out.videoDuration = otime::RationalTime(1.0, _defaultSpeed);
             return out;
         }
 
         avio::VideoFrame Read::_readVideoFrame(
             const std::string& fileName,
-            const otime::RationalTime& time)
+            const otime::RationalTime& time,
+            uint16_t proxyLevel)
         {
-            return std::unique_ptr<File>(new File(fileName))->read(fileName, time);
+            return std::unique_ptr<File>(new File(fileName, _p->yuv, proxyLevel))->read(fileName, time);
         }
     }
 }
@@ -118,16 +118,10 @@ namespace tlr
                         throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
                     }
 
-                    size_t scanlineSize = 0;
-                    switch (info.pixelType)
-                    {
-                    case imaging::PixelType::L_U8: scanlineSize = info.size.w; break;
-                    case imaging::PixelType::RGB_U8: scanlineSize = info.size.w * 3; break;
-                    default: break;
-                    }
+                    const size_t stride = image->getPlaneStride(0);
                     for (uint16_t y = 0; y < info.size.h; ++y)
                     {
-                        uint8_t* p = image->getData() + (y * scanlineSize);
+                        uint8_t* p = image->getPlaneData(0) + y * stride;
                         if (!jpegScanline(&_jpeg, p, &_error))
                         {
                             throw std::runtime_error(string::Format("{0}: Cannot write scanline: {1}").arg(fileName).arg(y));
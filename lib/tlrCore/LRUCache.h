@@ -5,7 +5,8 @@
 #pragma once
 
 #include <cstdint>
-#include <map>
+#include <list>
+#include <unordered_map>
 #include <vector>
 
 namespace tlr
@@ -13,6 +14,15 @@ namespace tlr
     namespace memory
     {
         //! LRU (Least Recently Used) cache.
+        //!
+        //! Entries are stored in a recency list indexed by a hash map, so
+        //! getting, adding, and evicting entries are constant time. Each
+        //! entry has a size (for example the number of bytes in an image),
+        //! and the maximum applies to the total size of the entries. The
+        //! default entry size is one, which makes the maximum an entry
+        //! count.
+        //!
+        //! The key type requires a std::hash specialization.
         template<typename T, typename U>
         class LRUCache
         {
@@ -22,6 +32,7 @@ namespace tlr
 
             std::size_t getMax() const;
             std::size_t getSize() const;
+            std::size_t getCount() const;
             float getPercentageUsed() const;
 
             void setMax(std::size_t);
@@ -32,13 +43,18 @@ namespace tlr
             ///@{
 
             bool contains(const T& key) const;
-            bool get(const T& key, U& value) const;
+            bool get(const T& key, U& value);
 
-            void add(const T& key, const U& value);
+            void add(const T& key, const U& value, std::size_t size = 1);
             void remove(const T& key);
             void clear();
 
+            //! Get the keys, from the most recently used to the least
+            //! recently used.
             std::vector<T> getKeys() const;
+
+            //! Get the values, from the most recently used to the least
+            //! recently used.
             std::vector<U> getValues() const;
 
             ///@}
@@ -46,10 +62,18 @@ namespace tlr
         private:
             void _maxUpdate();
 
+            struct Item
+            {
+                T key;
+                U value;
+                std::size_t size;
+            };
+            typedef std::list<Item> List;
+
             std::size_t _max = 10000;
-            std::map<T, U> _map;
-            mutable std::map<T, int64_t> _counts;
-            mutable int64_t _counter = 0;
+            std::size_t _size = 0;
+            List _list;
+            std::unordered_map<T, typename List::iterator> _map;
         };
     }
 }
@@ -2,8 +2,6 @@
 // Copyright (c) 2021 Darby Johnston
 // All rights reserved.
 
-#include <algorithm>
-
 namespace tlr
 {
     namespace memory
@@ -16,6 +14,12 @@ namespace tlr
 
         template<typename T, typename U>
         inline std::size_t LRUCache<T, U>::getSize() const
+        {
+            return _size;
+        }
+
+        template<typename T, typename U>
+        inline std::size_t LRUCache<T, U>::getCount() const
         {
             return _map.size();
         }
@@ -23,7 +27,7 @@ namespace tlr
         template<typename T, typename U>
         inline float LRUCache<T, U>::getPercentageUsed() const
         {
-            return _map.size() / static_cast<float>(_max) * 100.F;
+            return _size / static_cast<float>(_max) * 100.F;
         }
 
         template<typename T, typename U>
@@ -40,29 +44,35 @@ namespace tlr
         }
 
         template<typename T, typename U>
-        inline bool LRUCache<T, U>::get(const T& key, U& value) const
+        inline bool LRUCache<T, U>::get(const T& key, U& value)
         {
-            auto i = _map.find(key);
+            const auto i = _map.find(key);
             if (i != _map.end())
             {
-                value = i->second;
-                auto j = _counts.find(key);
-                if (j != _counts.end())
-                {
-                    ++_counter;
-                    j->second = _counter;
-                }
+                _list.splice(_list.begin(), _list, i->second);
+                value = i->second->value;
                 return true;
             }
-            return i != _map.end();
+            return false;
         }
 
         template<typename T, typename U>
-        inline void LRUCache<T, U>::add(const T& key, const U& value)
+        inline void LRUCache<T, U>::add(const T& key, const U& value, std::size_t size)
         {
-            _map[key] = value;
-            ++_counter;
-            _counts[key] = _counter;
+            const auto i = _map.find(key);
+            if (i != _map.end())
+            {
+                _size -= i->second->size;
+                i->second->value = value;
+                i->second->size = size;
+                _list.splice(_list.begin(), _list, i->second);
+            }
+            else
+            {
+                _list.push_front(Item({ key, value, size }));
+                _map[key] = _list.begin();
+            }
+            _size += size;
             _maxUpdate();
         }
 
@@ -72,29 +82,28 @@ namespace tlr
             const auto i = _map.find(key);
             if (i != _map.end())
             {
+                _size -= i->second->size;
+                _list.erase(i->second);
                 _map.erase(i);
             }
-            const auto j = _counts.find(key);
-            if (j != _counts.end())
-            {
-                _counts.erase(j);
-            }
-            _maxUpdate();
         }
             
         template<typename T, typename U>
         inline void LRUCache<T, U>::clear()
         {
+            _list.clear();
             _map.clear();
+            _size = 0;
         }
 
         template<typename T, typename U>
         inline std::vector<T> LRUCache<T, U>::getKeys() const
         {
             std::vector<T> out;
-            for (const auto& i : _map)
+            out.reserve(_list.size());
+            for (const auto& i : _list)
             {
-                out.push_back(i.first);
+                out.push_back(i.key);
             }
             return out;
         }
@@ -103,9 +112,10 @@ namespace tlr
         inline std::vector<U> LRUCache<T, U>::getValues() const
         {
             std::vector<U> out;
-            for (const auto& i : _map)
+            out.reserve(_list.size());
+            for (const auto& i : _list)
             {
-                out.push_back(i.second);
+                out.push_back(i.value);
             }
             return out;
         }
@@ -113,28 +123,12 @@ namespace tlr
         template<typename T, typename U>
         inline void LRUCache<T, U>::_maxUpdate()
         {
-            if (_map.size() > _max)
+            while (_size > _max && !_list.empty())
             {
-                std::map<int64_t, T> sorted;
-                for (const auto& i : _counts)
-                {
-                    sorted[i.second] = i.first;
-                }
-                while (_map.size() > _max)
-                {
-                    auto begin = sorted.begin();
-                    auto i = _map.find(begin->second);
-                    if (i != _map.end())
-                    {
-                        _map.erase(i);
-                    }
-                    auto j = _counts.find(begin->second);
-                    if (j != _counts.end())
-                    {
-                        _counts.erase(j);
-                    }
-                    sorted.erase(begin);
-                }
+                const auto& back = _list.back();
+                _size -= back.size;
+                _map.erase(back.key);
+                _list.pop_back();
             }
         }
     }
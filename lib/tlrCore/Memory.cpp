@@ -9,8 +9,28 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TLR_SIMD_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif // _MSC_VER
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define TLR_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+// The x86 SIMD functions are compiled for their instruction set with a
+// target attribute, so the rest of the library does not require it.
+#if defined(TLR_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TLR_SIMD_TARGET(value) __attribute__((target(value)))
+#else
+#define TLR_SIMD_TARGET(value)
+#endif
+
 namespace tlr
 {
     namespace memory
@@ -21,54 +41,198 @@ namespace tlr
             "LSB");
         TLR_ENUM_SERIALIZE_IMPL(Endian);
 
-        void endian(
-            void*  in,
-            size_t size,
-            size_t wordSize) noexcept
+        TLR_ENUM_IMPL(
+            SIMD,
+            "None",
+            "SSE4",
+            "AVX2",
+            "NEON");
+        TLR_ENUM_SERIALIZE_IMPL(SIMD);
+
+        namespace
         {
-            uint8_t* p = reinterpret_cast<uint8_t*>(in);
-            uint8_t tmp;
-            switch (wordSize)
+            SIMD getBestSIMD() noexcept
             {
-            case 2:
-                while (size--)
+                SIMD out = SIMD::None;
+#if defined(TLR_SIMD_X86)
+#if defined(_MSC_VER)
+                int info[4];
+                __cpuid(info, 1);
+                const bool sse4 = info[2] & (1 << 19);
+                const bool avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && 6 == (_xgetbv(0) & 6);
+                __cpuidex(info, 7, 0);
+                const bool avx2 = avx && (info[1] & (1 << 5));
+#else // _MSC_VER
+                __builtin_cpu_init();
+                const bool sse4 = __builtin_cpu_supports("sse4.1");
+                const bool avx2 = __builtin_cpu_supports("avx2");
+#endif // _MSC_VER
+                if (avx2)
                 {
-                    tmp = p[0];
-                    p[0] = p[1];
-                    p[1] = tmp;
-                    p += 2;
+                    out = SIMD::AVX2;
                 }
-                break;
-            case 4:
-                while (size--)
+                else if (sse4)
                 {
-                    tmp = p[0];
-                    p[0] = p[3];
-                    p[3] = tmp;
-                    tmp = p[1];
-                    p[1] = p[2];
-                    p[2] = tmp;
-                    p += 4;
+                    out = SIMD::SSE4;
                 }
-                break;
-            case 8:
-                while (size--)
+#elif defined(TLR_SIMD_NEON)
+                out = SIMD::NEON;
+#endif
+                return out;
+            }
+
+            const SIMD bestSIMD = getBestSIMD();
+
+            std::atomic<SIMD> currentSIMD(bestSIMD);
+
+            inline uint16_t byteSwap(uint16_t value) noexcept
+            {
+                return static_cast<uint16_t>((value >> 8) | (value << 8));
+            }
+
+            inline uint32_t byteSwap(uint32_t value) noexcept
+            {
+                return
+                    (value >> 24) |
+                    ((value >> 8) & 0xff00) |
+                    ((value << 8) & 0xff0000) |
+                    (value << 24);
+            }
+
+            inline uint64_t byteSwap(uint64_t value) noexcept
+            {
+                return
+                    (static_cast<uint64_t>(byteSwap(static_cast<uint32_t>(value))) << 32) |
+                    byteSwap(static_cast<uint32_t>(value >> 32));
+            }
+
+            // The scalar functions also handle the words left over by the
+            // SIMD functions. The input and output may be the same.
+            template<typename T>
+            void endianScalar(const uint8_t* in, uint8_t* out, size_t size) noexcept
+            {
+                T value;
+                for (size_t i = 0; i < size; ++i, in += sizeof(T), out += sizeof(T))
                 {
-                    tmp = p[0];
-                    p[0] = p[7];
-                    p[7] = tmp;
-                    tmp = p[1];
-                    p[1] = p[6];
-                    p[6] = tmp;
-                    tmp = p[2];
-                    p[2] = p[5];
-                    p[5] = tmp;
-                    tmp = p[3];
-                    p[3] = p[4];
-                    p[4] = tmp;
-                    p += 8;
+                    memcpy(&value, in, sizeof(T));
+                    value = byteSwap(value);
+                    memcpy(out, &value, sizeof(T));
                 }
-                break;
+            }
+
+#if defined(TLR_SIMD_X86)
+            template<typename T>
+            TLR_SIMD_TARGET("sse4.1")
+            void endianSSE4(const uint8_t* in, uint8_t* out, size_t size) noexcept
+            {
+                const __m128i mask =
+                    2 == sizeof(T) ? _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14) :
+                    4 == sizeof(T) ? _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12) :
+                    _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+                const size_t vectorSize = size * sizeof(T) / 16;
+                for (size_t i = 0; i < vectorSize; ++i, in += 16, out += 16)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(v, mask));
+                }
+                endianScalar<T>(in, out, size - vectorSize * 16 / sizeof(T));
+            }
+
+            template<typename T>
+            TLR_SIMD_TARGET("avx2")
+            void endianAVX2(const uint8_t* in, uint8_t* out, size_t size) noexcept
+            {
+                // The shuffle works within each 128-bit lane, so the mask
+                // is repeated for both lanes.
+                const __m256i mask =
+                    2 == sizeof(T) ? _mm256_setr_epi8(
+                        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14) :
+                    4 == sizeof(T) ? _mm256_setr_epi8(
+                        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12) :
+                    _mm256_setr_epi8(
+                        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+                const size_t vectorSize = size * sizeof(T) / 32;
+                for (size_t i = 0; i < vectorSize; ++i, in += 32, out += 32)
+                {
+                    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_shuffle_epi8(v, mask));
+                }
+                endianScalar<T>(in, out, size - vectorSize * 32 / sizeof(T));
+            }
+#endif // TLR_SIMD_X86
+
+#if defined(TLR_SIMD_NEON)
+            template<typename T>
+            void endianNEON(const uint8_t* in, uint8_t* out, size_t size) noexcept
+            {
+                const size_t vectorSize = size * sizeof(T) / 16;
+                for (size_t i = 0; i < vectorSize; ++i, in += 16, out += 16)
+                {
+                    const uint8x16_t v = vld1q_u8(in);
+                    vst1q_u8(out, 2 == sizeof(T) ? vrev16q_u8(v) : (4 == sizeof(T) ? vrev32q_u8(v) : vrev64q_u8(v)));
+                }
+                endianScalar<T>(in, out, size - vectorSize * 16 / sizeof(T));
+            }
+#endif // TLR_SIMD_NEON
+
+            template<typename T>
+            void endian(const uint8_t* in, uint8_t* out, size_t size) noexcept
+            {
+                switch (currentSIMD.load(std::memory_order_relaxed))
+                {
+#if defined(TLR_SIMD_X86)
+                case SIMD::SSE4: endianSSE4<T>(in, out, size); break;
+                case SIMD::AVX2: endianAVX2<T>(in, out, size); break;
+#endif // TLR_SIMD_X86
+#if defined(TLR_SIMD_NEON)
+                case SIMD::NEON: endianNEON<T>(in, out, size); break;
+#endif // TLR_SIMD_NEON
+                default: endianScalar<T>(in, out, size); break;
+                }
+            }
+        }
+
+        bool isSupported(SIMD value) noexcept
+        {
+            bool out = false;
+            switch (value)
+            {
+            case SIMD::None: out = true; break;
+            case SIMD::SSE4: out = SIMD::SSE4 == bestSIMD || SIMD::AVX2 == bestSIMD; break;
+            case SIMD::AVX2: out = SIMD::AVX2 == bestSIMD; break;
+            case SIMD::NEON: out = SIMD::NEON == bestSIMD; break;
+            default: break;
+            }
+            return out;
+        }
+
+        SIMD getSIMD() noexcept
+        {
+            return currentSIMD;
+        }
+
+        void setSIMD(SIMD value) noexcept
+        {
+            if (isSupported(value))
+            {
+                currentSIMD = value;
+            }
+        }
+
+        void endian(
+            void*  in,
+            size_t size,
+            size_t wordSize) noexcept
+        {
+            uint8_t* p = reinterpret_cast<uint8_t*>(in);
+            switch (wordSize)
+            {
+            case 2: endian<uint16_t>(p, p, size); break;
+            case 4: endian<uint32_t>(p, p, size); break;
+            case 8: endian<uint64_t>(p, p, size); break;
             default: break;
             }
         }
@@ -83,44 +247,9 @@ namespace tlr
             uint8_t* outP = reinterpret_cast<uint8_t*>(out);
             switch (wordSize)
             {
-            case 2:
-                while (size--)
-                {
-                    outP[0] = inP[1];
-                    outP[1] = inP[0];
-
-                    inP += 2;
-                    outP += 2;
-                }
-                break;
-            case 4:
-                while (size--)
-                {
-                    outP[0] = inP[3];
-                    outP[1] = inP[2];
-                    outP[2] = inP[1];
-                    outP[3] = inP[0];
-
-                    inP += 4;
-                    outP += 4;
-                }
-                break;
-            case 8:
-                while (size--)
-                {
-                    outP[0] = inP[7];
-                    outP[1] = inP[6];
-                    outP[2] = inP[5];
-                    outP[3] = inP[4];
-                    outP[4] = inP[3];
-                    outP[5] = inP[2];
-                    outP[6] = inP[1];
-                    outP[7] = inP[0];
-
-                    inP += 8;
-                    outP += 8;
-                }
-                break;
+            case 2: endian<uint16_t>(inP, outP, size); break;
+            case 4: endian<uint32_t>(inP, outP, size); break;
+            case 8: endian<uint64_t>(inP, outP, size); break;
             default:
                 memcpy(out, in, size * wordSize);
                 break;
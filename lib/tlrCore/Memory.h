@@ -15,6 +15,31 @@ namespace tlr
     //! Memory.
     namespace memory
     {
+        //! \name Sizes
+        ///@{
+
+        const size_t kilobyte = 1024;
+        const size_t megabyte = kilobyte * 1024;
+        const size_t gigabyte = megabyte * 1024;
+
+        ///@}
+
+        //! \name Aligned Memory
+        ///@{
+
+        //! Default alignment for large buffers, matching the cache line size.
+        const size_t defaultAlignment = 64;
+
+        //! Allocate a block of uninitialized memory with the given alignment.
+        //! The alignment must be a power of two and a multiple of
+        //! sizeof(void*). Returns nullptr if the allocation fails.
+        void* alignedAlloc(size_t size, size_t alignment = defaultAlignment) noexcept;
+
+        //! Free a block of memory allocated with alignedAlloc().
+        void alignedFree(void*) noexcept;
+
+        ///@}
+
         //! Endian type.
         enum class Endian
         {
@@ -33,13 +58,47 @@ namespace tlr
         //! Get the opposite of the given endian.
         constexpr Endian opposite(Endian) noexcept;
 
-        //! Convert the endianness of a block of memory in place.
+        //! \name SIMD
+        ///@{
+
+        //! SIMD instruction sets.
+        enum class SIMD
+        {
+            None, //!< Scalar code
+            SSE4,
+            AVX2,
+            NEON,
+
+            Count,
+            First = None
+        };
+        TLR_ENUM(SIMD);
+        TLR_ENUM_SERIALIZE(SIMD);
+
+        //! Get whether the current machine supports the given instruction
+        //! set.
+        bool isSupported(SIMD) noexcept;
+
+        //! Get the instruction set used by the optimized functions. This
+        //! defaults to the best instruction set supported by the current
+        //! machine.
+        SIMD getSIMD() noexcept;
+
+        //! Set the instruction set used by the optimized functions.
+        //! Instruction sets that are not supported are ignored.
+        void setSIMD(SIMD) noexcept;
+
+        ///@}
+
+        //! Convert the endianness of a block of memory in place. This
+        //! function is SIMD optimized.
         void endian(
             void*  in,
             size_t size,
             size_t wordSize) noexcept;
 
-        //! Convert the endianness of a block of memory.
+        //! Convert the endianness of a block of memory. This function is
+        //! SIMD optimized.
         void endian(
             const void* in,
             void*       out,
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCore/Memory.h>
+
+#include <stdlib.h>
+
+namespace tlr
+{
+    namespace memory
+    {
+        void* alignedAlloc(size_t size, size_t alignment) noexcept
+        {
+            void* out = nullptr;
+            if (posix_memalign(&out, alignment, size) != 0)
+            {
+                out = nullptr;
+            }
+            return out;
+        }
+
+        void alignedFree(void* value) noexcept
+        {
+            free(value);
+        }
+    }
+}
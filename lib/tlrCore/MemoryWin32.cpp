@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCore/Memory.h>
+
+#include <malloc.h>
+
+namespace tlr
+{
+    namespace memory
+    {
+        void* alignedAlloc(size_t size, size_t alignment) noexcept
+        {
+            return _aligned_malloc(size, alignment);
+        }
+
+        void alignedFree(void* value) noexcept
+        {
+            _aligned_free(value);
+        }
+    }
+}
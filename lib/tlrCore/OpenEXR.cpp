@@ -4,8 +4,10 @@
 
 #include <tlrCore/OpenEXR.h>
 
+#include <tlrCore/Error.h>
 #include <tlrCore/String.h>
 
+#include <Iex.h>
 #include <ImfChannelList.h>
 #include <ImfDoubleAttribute.h>
 #include <ImfFloatVectorAttribute.h>
@@ -17,6 +19,18 @@ namespace tlr
 {
     namespace exr
     {
+        TLR_ENUM_IMPL(
+            Channels,
+            "All",
+            "Color");
+        TLR_ENUM_SERIALIZE_IMPL(Channels);
+
+        TLR_ENUM_IMPL(
+            Precision,
+            "Half",
+            "Native");
+        TLR_ENUM_SERIALIZE_IMPL(Precision);
+
         namespace
         {
             const std::vector<std::string> knownAttributes =
@@ -232,6 +246,77 @@ namespace tlr
 
         } // namespace
 
+        struct IStream::Private
+        {
+            std::shared_ptr<file::FileIO> io;
+        };
+
+        IStream::IStream(const std::string& fileName, file::DirectIO directIO) :
+            Imf::IStream(fileName.c_str()),
+            _p(new Private)
+        {
+            TLR_PRIVATE_P();
+            p.io = file::FileIO::create();
+            p.io->open(fileName, file::Mode::Read, directIO);
+        }
+
+        IStream::~IStream()
+        {}
+
+        bool IStream::isMemoryMapped() const
+        {
+#if defined(TLR_ENABLE_MMAP)
+            return _p->io->mmapP() != nullptr;
+#else // TLR_ENABLE_MMAP
+            return false;
+#endif // TLR_ENABLE_MMAP
+        }
+
+        bool IStream::read(char c[], int n)
+        {
+            TLR_PRIVATE_P();
+            const size_t pos = p.io->getPos();
+            const size_t size = p.io->getSize();
+            if (n < 0 || pos + static_cast<size_t>(n) > size)
+            {
+                throw Iex::InputExc("Unexpected end of file.");
+            }
+            p.io->read(c, n);
+            return pos + n < size;
+        }
+
+        char* IStream::readMemoryMapped(int n)
+        {
+            TLR_PRIVATE_P();
+            char* out = nullptr;
+#if defined(TLR_ENABLE_MMAP)
+            if (!p.io->mmapP())
+            {
+                throw Iex::InputExc("The file is not memory-mapped.");
+            }
+            const size_t pos = p.io->getPos();
+            if (n < 0 || pos + static_cast<size_t>(n) > p.io->getSize())
+            {
+                throw Iex::InputExc("Unexpected end of file.");
+            }
+            out = reinterpret_cast<char*>(const_cast<uint8_t*>(p.io->mmapP()));
+            p.io->setPos(pos + n);
+#else // TLR_ENABLE_MMAP
+            throw Iex::InputExc("The file is not memory-mapped.");
+#endif // TLR_ENABLE_MMAP
+            return out;
+        }
+
+        Imf::Int64 IStream::tellg()
+        {
+            return _p->io->getPos();
+        }
+
+        void IStream::seekg(Imf::Int64 pos)
+        {
+            _p->io->setPos(pos);
+        }
+
         void readTags(const Imf::Header& header, std::map<std::string, std::string>& tags, double& speed)
         {
             // Predefined attributes.
@@ -670,7 +755,7 @@ namespace tlr
             const file::Path& path,
             const avio::Options& options)
         {
-            return Read::create(path, avio::merge(options, _options), _logSystem);
+            return Read::create(path, avio::merge(options, _options), _cache, _threadPool, _logSystem);
         }
 
         std::vector<imaging::PixelType> Plugin::getWritePixelTypes() const
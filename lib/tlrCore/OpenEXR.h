@@ -7,12 +7,61 @@
 #include <tlrCore/SequenceIO.h>
 
 #include <ImfHeader.h>
+#include <ImfIO.h>
 
 namespace tlr
 {
     //! OpenEXR I/O.
     namespace exr
     {
+        //! Default number of threads used by OpenEXR to decode each frame.
+        const size_t decodeThreadCount = 4;
+
+        //! OpenEXR channel selection.
+        enum class Channels
+        {
+            All,   //!< Read the color and alpha channels
+            Color, //!< Read the color channels without alpha
+
+            Count,
+            First = All
+        };
+        TLR_ENUM(Channels);
+        TLR_ENUM_SERIALIZE(Channels);
+
+        //! OpenEXR channel precision.
+        enum class Precision
+        {
+            Half,   //!< Convert all channels to 16-bit float
+            Native, //!< Read 32-bit channels as 32-bit float
+
+            Count,
+            First = Half
+        };
+        TLR_ENUM(Precision);
+        TLR_ENUM_SERIALIZE(Precision);
+
+        //! OpenEXR input stream that reads with file::FileIO. When the file
+        //! is memory-mapped, OpenEXR reads the data directly from the
+        //! memory-map without copying it.
+        class IStream : public Imf::IStream
+        {
+            TLR_NON_COPYABLE(IStream);
+
+        public:
+            IStream(const std::string& fileName, file::DirectIO = file::DirectIO::Off);
+            ~IStream() override;
+
+            bool isMemoryMapped() const override;
+            bool read(char c[], int n) override;
+            char* readMemoryMapped(int n) override;
+            Imf::Int64 tellg() override;
+            void seekg(Imf::Int64 pos) override;
+
+        private:
+            TLR_PRIVATE();
+        };
+
         //! Read the tags from an Imf header.
         void readTags(const Imf::Header&, std::map<std::string, std::string>&, double& speed);
 
@@ -22,12 +71,26 @@ namespace tlr
         void writeTags(const std::map<std::string, std::string>&, double speed, Imf::Header&);
 
         //! OpenEXR reader.
+        //!
+        //! Only the channels of the selected layer are decoded. The layer is
+        //! given by the "OpenEXR/Layer" option, which is either a channel
+        //! name prefix such as "diffuse" or the name of a part in a
+        //! multi-part file. The default layer is the unprefixed channels.
+        //! A layer with R, G, and B channels is read as RGB, and a layer
+        //! with a Y channel or a single channel is read as luminance. The
+        //! A channel is added unless the "OpenEXR/Channels" option is
+        //! Color.
+        //!
+        //! Each frame is decoded with "OpenEXR/ThreadCount" threads from
+        //! the OpenEXR global thread pool.
         class Read : public avio::ISequenceRead
         {
         protected:
             void _init(
                 const file::Path&,
                 const avio::Options&,
+                const std::shared_ptr<avio::Cache>&,
+                const std::shared_ptr<core::ThreadPool>&,
                 const std::shared_ptr<core::LogSystem>&);
             Read();
 
@@ -38,13 +101,20 @@ namespace tlr
             static std::shared_ptr<Read> create(
                 const file::Path&,
                 const avio::Options&,
+                const std::shared_ptr<avio::Cache>&,
+                const std::shared_ptr<core::ThreadPool>&,
                 const std::shared_ptr<core::LogSystem>&);
 
         protected:
             avio::Info _getInfo(const std::string& fileName) override;
             avio::VideoFrame _readVideoFrame(
                 const std::string& fileName,
-                const otime::RationalTime&) override;
+                const otime::RationalTime&,
+                uint16_t proxyLevel) override;
+            std::string _getCacheOptions() const override;
+
+        private:
+            TLR_PRIVATE();
         };
 
         //! OpenEXR writer.
@@ -4,9 +4,21 @@
 
 #include <tlrCore/OpenEXR.h>
 
+#include <tlrCore/String.h>
 #include <tlrCore/StringFormat.h>
 
-#include <ImfRgbaFile.h>
+#include <ImfChannelList.h>
+#include <ImfFrameBuffer.h>
+#include <ImfInputPart.h>
+#include <ImfMultiPartInputFile.h>
+#include <ImfPartType.h>
+#include <ImfThreading.h>
+#include <ImfTiledInputPart.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <sstream>
 
 namespace tlr
 {
@@ -14,77 +26,328 @@ namespace tlr
     {
         namespace
         {
-            avio::Info imfInfo(const Imf::RgbaInputFile& f)
+            //! The channels that are read from a file.
+            struct Layer
             {
-                avio::Info out;
-                imaging::PixelType pixelType = imaging::getFloatType(4, 16);
+                int part = -1;
+                std::vector<std::string> channels;
+                Imf::PixelType channelType = Imf::HALF;
+                imaging::Info info;
+            };
+
+            bool findChannels(
+                const Imf::ChannelList& channelList,
+                const std::string& prefix,
+                Channels channels,
+                std::vector<std::string>& out)
+            {
+                // Find the channels that belong directly to the layer.
+                // Sub-sampled channels are not supported.
+                std::map<std::string, std::string> names;
+                for (auto i = channelList.begin(); i != channelList.end(); ++i)
+                {
+                    const std::string name = i.name();
+                    if (name.size() > prefix.size() &&
+                        0 == name.compare(0, prefix.size(), prefix) &&
+                        std::string::npos == name.find('.', prefix.size()) &&
+                        1 == i.channel().xSampling &&
+                        1 == i.channel().ySampling)
+                    {
+                        names[string::toLower(name.substr(prefix.size()))] = name;
+                    }
+                }
+
+                out.clear();
+                const auto r = names.find("r");
+                const auto g = names.find("g");
+                const auto b = names.find("b");
+                const auto y = names.find("y");
+                const auto a = names.find("a");
+                if (r != names.end() && g != names.end() && b != names.end())
+                {
+                    out.push_back(r->second);
+                    out.push_back(g->second);
+                    out.push_back(b->second);
+                }
+                else if (y != names.end())
+                {
+                    out.push_back(y->second);
+                }
+                else if (1 == names.size())
+                {
+                    out.push_back(names.begin()->second);
+                }
+                if (!out.empty() &&
+                    a != names.end() &&
+                    a->second != out[0] &&
+                    Channels::All == channels)
+                {
+                    out.push_back(a->second);
+                }
+                return !out.empty();
+            }
+
+            Layer getLayer(
+                const Imf::MultiPartInputFile& f,
+                const std::string& fileName,
+                const std::string& layer,
+                Channels channels,
+                Precision precision)
+            {
+                Layer out;
+                const std::string prefix = !layer.empty() ? (layer + ".") : std::string();
+                for (int i = 0; i < f.parts() && -1 == out.part; ++i)
+                {
+                    const Imf::Header& header = f.header(i);
+                    if (header.hasType() && Imf::isDeepData(header.type()))
+                    {
+                        continue;
+                    }
+                    if (findChannels(header.channels(), prefix, channels, out.channels) ||
+                        (!layer.empty() &&
+                            header.hasName() &&
+                            header.name() == layer &&
+                            findChannels(header.channels(), std::string(), channels, out.channels)))
+                    {
+                        out.part = i;
+                    }
+                }
+                if (-1 == out.part)
+                {
+                    throw std::runtime_error(string::Format("{0}: Layer not found: {1}").
+                        arg(fileName).
+                        arg(layer));
+                }
+
+                const Imf::Header& header = f.header(out.part);
+                if (Precision::Native == precision)
+                {
+                    for (const auto& i : out.channels)
+                    {
+                        if (header.channels()[i].type != Imf::HALF)
+                        {
+                            out.channelType = Imf::FLOAT;
+                            break;
+                        }
+                    }
+                }
+                const imaging::PixelType pixelType = imaging::getFloatType(
+                    out.channels.size(),
+                    Imf::HALF == out.channelType ? 16 : 32);
                 if (imaging::PixelType::None == pixelType)
                 {
-                    throw std::runtime_error(string::Format("{0}: File not supported").arg(f.fileName()));
+                    throw std::runtime_error(string::Format("{0}: File not supported").arg(fileName));
                 }
-                const auto dw = f.dataWindow();
+                const auto dw = header.dataWindow();
                 const int width = dw.max.x - dw.min.x + 1;
                 const int height = dw.max.y - dw.min.y + 1;
-                out.video.push_back(imaging::Info(width, height, pixelType));
+                out.info = imaging::Info(width, height, pixelType);
+                return out;
+            }
+
+            //! An OpenEXR file and the stream it reads from.
+            struct File
+            {
+                File(const std::string& fileName, file::DirectIO directIO, int threadCount) :
+                    stream(new IStream(fileName, directIO)),
+                    f(new Imf::MultiPartInputFile(*stream, threadCount))
+                {}
+
+                std::unique_ptr<IStream> stream;
+                std::unique_ptr<Imf::MultiPartInputFile> f;
+            };
+
+            //! Create a frame buffer that decodes the layer's channels
+            //! straight into the image.
+            Imf::FrameBuffer imfFrameBuffer(
+                const Layer& layer,
+                const Imath::Box2i& dataWindow,
+                const std::shared_ptr<imaging::Image>& image)
+            {
+                const size_t channelByteCount = Imf::HALF == layer.channelType ? 2 : 4;
+                const size_t xStride = layer.channels.size() * channelByteCount;
+                const size_t yStride = static_cast<size_t>(image->getWidth()) * xStride;
+                char* base = reinterpret_cast<char*>(image->getData()) -
+                    static_cast<ptrdiff_t>(dataWindow.min.x) * static_cast<ptrdiff_t>(xStride) -
+                    static_cast<ptrdiff_t>(dataWindow.min.y) * static_cast<ptrdiff_t>(yStride);
+                Imf::FrameBuffer out;
+                for (size_t i = 0; i < layer.channels.size(); ++i)
+                {
+                    out.insert(
+                        layer.channels[i],
+                        Imf::Slice(layer.channelType, base + i * channelByteCount, xStride, yStride));
+                }
+                return out;
+            }
+
+            avio::Info imfInfo(const Imf::MultiPartInputFile& f, const Layer& layer)
+            {
+                avio::Info out;
+                out.video.push_back(layer.info);
                 double speed = avio::sequenceDefaultSpeed;
-                readTags(f.header(), out.tags, speed);
+                readTags(f.header(layer.part), out.tags, speed);
                 out.videoDuration = otime::RationalTime(1.0, speed);
                 return out;
             }
         }
 
+        struct Read::Private
+        {
+            std::string layer;
+            Channels channels = Channels::All;
+            Precision precision = Precision::Half;
+            size_t threadCount = decodeThreadCount;
+
+            // The file opened by _getInfo(), which is re-used to read the
+            // first frame.
+            std::string fileName;
+            std::unique_ptr<File> file;
+            std::mutex mutex;
+        };
+
         void Read::_init(
             const file::Path& path,
             const avio::Options& options,
+            const std::shared_ptr<avio::Cache>& cache,
+            const std::shared_ptr<core::ThreadPool>& threadPool,
             const std::shared_ptr<core::LogSystem>& logSystem)
         {
-            ISequenceRead::_init(path, options, logSystem);
+            TLR_PRIVATE_P();
+
+            auto i = options.find("OpenEXR/Layer");
+            if (i != options.end())
+            {
+                p.layer = i->second;
+            }
+            i = options.find("OpenEXR/Channels");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.channels;
+            }
+            i = options.find("OpenEXR/Precision");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.precision;
+            }
+            i = options.find("OpenEXR/ThreadCount");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.threadCount;
+            }
+
+            // The OpenEXR global thread pool is shared by all of the
+            // readers, so it is only ever grown.
+            {
+                static std::mutex mutex;
+                std::unique_lock<std::mutex> lock(mutex);
+                if (Imf::globalThreadCount() < static_cast<int>(p.threadCount))
+                {
+                    Imf::setGlobalThreadCount(static_cast<int>(p.threadCount));
+                }
+            }
+
+            ISequenceRead::_init(path, options, cache, threadPool, logSystem);
         }
 
-        Read::Read()
+        Read::Read() :
+            _p(new Private)
         {}
 
         Read::~Read()
-        {}
+        {
+            _finish();
+        }
 
         std::shared_ptr<Read> Read::create(
             const file::Path& path,
             const avio::Options& options,
+            const std::shared_ptr<avio::Cache>& cache,
+            const std::shared_ptr<core::ThreadPool>& threadPool,
             const std::shared_ptr<core::LogSystem>& logSystem)
         {
             auto out = std::shared_ptr<Read>(new Read);
-            out->_init(path, options, logSystem);
+            out->_init(path, options, cache, threadPool, logSystem);
             return out;
         }
 
+        std::string Read::_getCacheOptions() const
+        {
+            TLR_PRIVATE_P();
+            std::stringstream ss;
+            ss << p.channels << '/' << p.precision << '/' << p.layer;
+            return ss.str();
+        }
+
         avio::Info Read::_getInfo(const std::string& fileName)
         {
-            avio::Info out;
-            Imf::RgbaInputFile f(fileName.c_str());
-            out = imfInfo(f);
+            TLR_PRIVATE_P();
+            std::unique_ptr<File> f(new File(fileName, _directIO, static_cast<int>(p.threadCount)));
+            const auto layer = getLayer(*f->f, fileName, p.layer, p.channels, p.precision);
+            const avio::Info out = imfInfo(*f->f, layer);
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.fileName = fileName;
+            p.file = std::move(f);
             return out;
         }
 
         avio::VideoFrame Read::_readVideoFrame(
             const std::string& fileName,
-            const otime::RationalTime& time)
+            const otime::RationalTime& time,
+            uint16_t proxyLevel)
         {
-            Imf::RgbaInputFile f(fileName.c_str());
-            const auto info = imfInfo(f);
+            TLR_PRIVATE_P();
+
+            std::unique_ptr<File> f;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (p.file && fileName == p.fileName)
+                {
+                    f = std::move(p.file);
+                }
+                p.file.reset();
+            }
+            if (!f)
+            {
+                f.reset(new File(fileName, _directIO, static_cast<int>(p.threadCount)));
+            }
+            const auto layer = getLayer(*f->f, fileName, p.layer, p.channels, p.precision);
+            const auto info = imfInfo(*f->f, layer);
 
             avio::VideoFrame out;
             out.time = time;
-            out.image = imaging::Image::create(info.video[0]);
-            out.image->setTags(info.tags);
-
-            const auto dw = f.dataWindow();
-            const int width = dw.max.x - dw.min.x + 1;
-            const int height = dw.max.y - dw.min.y + 1;
-            f.setFrameBuffer(
-                reinterpret_cast<Imf::Rgba*>(out.image->getData()) - dw.min.x - dw.min.y * width,
-                1,
-                width);
-            f.readPixels(dw.min.y, dw.max.y);
+
+            // Proxies of tiled files are read from the closest mip-map or
+            // rip-map level that is not smaller than the proxy level.
+            const Imf::Header& header = f->f->header(layer.part);
+            if (proxyLevel > 0 &&
+                header.hasTileDescription() &&
+                header.tileDescription().mode != Imf::ONE_LEVEL)
+            {
+                Imf::TiledInputPart part(*f->f, layer.part);
+                const int level = std::min(
+                    static_cast<int>(proxyLevel),
+                    std::min(part.numXLevels(), part.numYLevels()) - 1);
+                const auto dw = part.dataWindowForLevel(level, level);
+                imaging::Info imageInfo = layer.info;
+                imageInfo.size.w = dw.max.x - dw.min.x + 1;
+                imageInfo.size.h = dw.max.y - dw.min.y + 1;
+                out.image = imaging::Image::create(imageInfo);
+                out.image->setTags(info.tags);
+                part.setFrameBuffer(imfFrameBuffer(layer, dw, out.image));
+                part.readTiles(0, part.numXTiles(level) - 1, 0, part.numYTiles(level) - 1, level, level);
+            }
+            else
+            {
+                out.image = imaging::Image::create(info.video[0]);
+                out.image->setTags(info.tags);
+                const auto dw = header.dataWindow();
+                Imf::InputPart part(*f->f, layer.part);
+                part.setFrameBuffer(imfFrameBuffer(layer, dw, out.image));
+                part.readPixels(dw.min.y, dw.max.y);
+            }
 
             return out;
         }
@@ -47,8 +47,8 @@ namespace tlr
             Imf::Header header(info.size.w, info.size.h);
             writeTags(image->getTags(), avio::sequenceDefaultSpeed, header);
             Imf::RgbaOutputFile f(fileName.c_str(), header);
-            const size_t scanlineSize = info.size.w * 4 * 2;
-            uint8_t* p = image->getData();
+            const auto packed = imaging::pack(image);
+            uint8_t* p = packed->getData();
             f.setFrameBuffer(reinterpret_cast<Imf::Rgba*>(p), 1, info.size.w);
             f.writePixels(info.size.h);
         }
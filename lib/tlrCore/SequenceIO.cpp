@@ -4,15 +4,23 @@
 
 #include <tlrCore/SequenceIO.h>
 
+#include <tlrCore/AVIOCache.h>
 #include <tlrCore/Assert.h>
+#include <tlrCore/Error.h>
 #include <tlrCore/File.h>
-#include <tlrCore/LRUCache.h>
+#include <tlrCore/SequenceIndex.h>
+#include <tlrCore/String.h>
+#include <tlrCore/ThreadPool.h>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <condition_variable>
+#include <cstring>
 #include <queue>
 #include <list>
 #include <mutex>
+#include <set>
 #include <sstream>
 #include <thread>
 
@@ -20,9 +28,24 @@ namespace tlr
 {
     namespace avio
     {
+        TLR_ENUM_IMPL(
+            SequenceMissingFrame,
+            "Empty",
+            "Hold");
+        TLR_ENUM_SERIALIZE_IMPL(SequenceMissingFrame);
+
         struct ISequenceRead::Private
         {
             std::promise<Info> infoPromise;
+            imaging::Size imageSize;
+
+            std::shared_ptr<file::SequenceIndex> index;
+            std::chrono::steady_clock::time_point indexTime;
+            std::chrono::seconds indexTimeout = sequenceIndexTimeout;
+            bool indexBackground = sequenceIndexBackground;
+            std::shared_ptr<std::atomic<bool> > indexUpdating;
+            SequenceMissingFrame missingFrame = SequenceMissingFrame::Empty;
+            std::string cacheOptions;
 
             struct VideoFrameRequest
             {
@@ -30,25 +53,49 @@ namespace tlr
                 VideoFrameRequest(VideoFrameRequest&&) = default;
 
                 otime::RationalTime time = time::invalidTime;
+                int64_t priority = 0;
+                imaging::Size size;
                 std::promise<VideoFrame> promise;
             };
             std::list<VideoFrameRequest> videoFrameRequests;
+            size_t videoFramesInFlight = 0;
+
+            struct VideoFrameRead
+            {
+                std::string fileName;
+                CacheKey cacheKey;
+                otime::RationalTime time = time::invalidTime;
+                otime::RationalTime readTime = time::invalidTime;
+                uint16_t proxyLevel = 0;
+                std::promise<VideoFrame> promise;
+            };
+
+            size_t prefetchCount = sequencePrefetchCount;
+            int64_t prefetchHead = -1;
+            int64_t prefetchHeadPriority = 0;
+            int64_t prefetchFrame = -1;
+            int64_t prefetchPriority = 0;
+            int64_t prefetchDirection = 1;
+            std::set<int64_t> prefetched;
+
             std::condition_variable requestCV;
             std::mutex requestMutex;
-            memory::LRUCache<std::string, VideoFrame> videoFrameCache;
 
             std::thread thread;
             std::atomic<bool> running;
             std::atomic<bool> stopped;
             size_t threadCount = sequenceThreadCount;
+            size_t batchSize = sequenceBatchSize;
         };
 
         void ISequenceRead::_init(
             const file::Path& path,
             const Options& options,
+            const std::shared_ptr<Cache>& cache,
+            const std::shared_ptr<core::ThreadPool>& threadPool,
             const std::shared_ptr<core::LogSystem>& logSystem)
         {
-            IRead::_init(path, options, logSystem);
+            IRead::_init(path, options, cache, threadPool, logSystem);
 
             TLR_PRIVATE_P();
 
@@ -58,14 +105,52 @@ namespace tlr
                 std::stringstream ss(i->second);
                 ss >> p.threadCount;
             }
+            i = options.find("SequenceIO/BatchSize");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.batchSize;
+            }
             i = options.find("SequenceIO/DefaultSpeed");
             if (i != options.end())
             {
                 std::stringstream ss(i->second);
                 ss >> _defaultSpeed;
             }
-
-            p.videoFrameCache.setMax(1);
+            i = options.find("SequenceIO/Prefetch");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.prefetchCount;
+            }
+            i = options.find("FileIO/DirectIO");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> _directIO;
+            }
+            i = options.find("SequenceIO/MissingFrame");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.missingFrame;
+            }
+            i = options.find("SequenceIO/IndexTimeout");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                int64_t seconds = 0;
+                ss >> seconds;
+                p.indexTimeout = std::chrono::seconds(seconds);
+            }
+            i = options.find("SequenceIO/IndexBackground");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.indexBackground;
+            }
+            p.indexUpdating = std::make_shared<std::atomic<bool> >(false);
+            p.cacheOptions = _getCacheOptions();
 
             p.running = true;
             p.stopped = false;
@@ -75,7 +160,17 @@ namespace tlr
                     TLR_PRIVATE_P();
                     try
                     {
-                        p.infoPromise.set_value(_getInfo(path.get()));
+                        if (!path.getNumber().empty())
+                        {
+                            p.index = file::SequenceIndex::create(path);
+                            p.indexTime = std::chrono::steady_clock::now();
+                        }
+                        const Info info = _getInfo(path.get());
+                        if (!info.video.empty())
+                        {
+                            p.imageSize = info.video[0].size;
+                        }
+                        p.infoPromise.set_value(info);
                         _run();
                     }
                     catch (const std::exception&)
@@ -101,12 +196,7 @@ namespace tlr
 
         ISequenceRead::~ISequenceRead()
         {
-            TLR_PRIVATE_P();
-            p.running = false;
-            if (p.thread.joinable())
-            {
-                p.thread.join();
-            }
+            _finish();
         }
 
         std::future<Info> ISequenceRead::getInfo()
@@ -114,17 +204,27 @@ namespace tlr
             return _p->infoPromise.get_future();
         }
 
-        std::future<VideoFrame> ISequenceRead::readVideoFrame(const otime::RationalTime& time)
+        std::future<VideoFrame> ISequenceRead::readVideoFrame(
+            const otime::RationalTime& time,
+            int64_t priority,
+            const imaging::Size& size)
         {
             TLR_PRIVATE_P();
             Private::VideoFrameRequest request;
             request.time = time;
+            request.priority = priority;
+            request.size = size;
             auto future = request.promise.get_future();
             if (!p.stopped)
             {
                 {
                     std::unique_lock<std::mutex> lock(p.requestMutex);
-                    p.videoFrameRequests.push_back(std::move(request));
+                    auto i = p.videoFrameRequests.begin();
+                    while (i != p.videoFrameRequests.end() && i->priority <= priority)
+                    {
+                        ++i;
+                    }
+                    p.videoFrameRequests.insert(i, std::move(request));
                 }
                 p.requestCV.notify_one();
             }
@@ -139,7 +239,7 @@ namespace tlr
         {
             TLR_PRIVATE_P();
             std::unique_lock<std::mutex> lock(p.requestMutex);
-            return !p.videoFrameRequests.empty();
+            return !p.videoFrameRequests.empty() || p.videoFramesInFlight > 0;
         }
 
         void ISequenceRead::cancelVideoFrames()
@@ -159,83 +259,408 @@ namespace tlr
             return _p->stopped;
         }
 
+        void ISequenceRead::_finish()
+        {
+            TLR_PRIVATE_P();
+            p.running = false;
+            if (p.thread.joinable())
+            {
+                p.thread.join();
+            }
+        }
+
         void ISequenceRead::_run()
         {
             TLR_PRIVATE_P();
+            const size_t batchSize = _batchRead ? std::max(p.batchSize, static_cast<size_t>(1)) : 1;
+            const size_t inFlightMax = p.threadCount * batchSize;
             while (p.running)
             {
-                struct Result
-                {
-                    std::string fileName;
-                    otime::RationalTime time = time::invalidTime;
-                    std::future<VideoFrame> future;
-                    std::promise<VideoFrame> promise;
-                };
-                std::vector<Result> results;
+                // Take as many requests as there are free slots, waiting
+                // until there is room for a full batch.
+                std::list<Private::VideoFrameRequest> requests;
                 {
                     std::unique_lock<std::mutex> lock(p.requestMutex);
                     p.requestCV.wait_for(
                         lock,
                         sequenceRequestTimeout,
-                        [this]
+                        [this, batchSize, inFlightMax]
                         {
-                            return !_p->videoFrameRequests.empty();
+                            return !_p->videoFrameRequests.empty() &&
+                                _p->videoFramesInFlight + std::min(batchSize, _p->videoFrameRequests.size()) <= inFlightMax;
                         });
-                    for (size_t i = 0; i < p.threadCount && !p.videoFrameRequests.empty(); ++i)
+                    while (!p.videoFrameRequests.empty() &&
+                        p.videoFramesInFlight < inFlightMax)
                     {
-                        Result result;
-                        result.time = p.videoFrameRequests.front().time;
-                        result.promise = std::move(p.videoFrameRequests.front().promise);
-                        results.push_back(std::move(result));
+                        requests.push_back(std::move(p.videoFrameRequests.front()));
                         p.videoFrameRequests.pop_front();
+                        ++p.videoFramesInFlight;
                     }
                 }
 
-                auto it = results.begin();
-                while (it != results.end())
+                // Find the frames that need to be read.
+                std::vector<std::shared_ptr<Private::VideoFrameRead> > reads;
+                for (auto& request : requests)
                 {
-                    //std::cout << "request: " << it->time << std::endl;
+                    //std::cout << "request: " << request.time << std::endl;
+                    std::string fileName;
+                    CacheKey cacheKey;
+                    otime::RationalTime readTime = request.time;
+                    const uint16_t proxyLevel = imaging::getProxyLevel(p.imageSize, request.size);
                     if (!_path.getNumber().empty())
                     {
-                        it->fileName = _path.get(static_cast<int>(it->time.value()));
+                        int64_t frame = static_cast<int64_t>(request.time.value());
+                        _prefetch(frame, request.priority);
+                        if (!_hasFrame(frame))
+                        {
+                            frame = SequenceMissingFrame::Hold == p.missingFrame ?
+                                p.index->getNearest(frame) :
+                                -1;
+                            if (-1 == frame)
+                            {
+                                request.promise.set_value(VideoFrame());
+                                _finishVideoFrame();
+                                continue;
+                            }
+                            readTime = otime::RationalTime(frame, request.time.rate());
+                        }
+                        fileName = _path.get(static_cast<int>(frame));
+                        cacheKey = CacheKey(fileName, frame, imaging::PixelType::None, proxyLevel, p.cacheOptions);
                     }
                     else
                     {
-                        it->fileName = _path.get();
+                        fileName = _path.get();
+                        cacheKey = CacheKey(fileName, 0, imaging::PixelType::None, proxyLevel, p.cacheOptions);
                     }
                     VideoFrame videoFrame;
-                    if (p.videoFrameCache.get(it->fileName, videoFrame))
+                    if (_cache && _cache->get(cacheKey, videoFrame))
                     {
-                        it->promise.set_value(videoFrame);
-                        it = results.erase(it);
+                        videoFrame.time = request.time;
+                        request.promise.set_value(videoFrame);
+                        _finishVideoFrame();
                     }
                     else
                     {
-                        const auto fileName = it->fileName;
-                        const auto time = it->time;
-                        it->future = std::async(
-                            std::launch::async,
-                            [this, fileName, time]
+                        auto read = std::make_shared<Private::VideoFrameRead>();
+                        read->fileName = fileName;
+                        read->cacheKey = cacheKey;
+                        read->time = request.time;
+                        read->readTime = readTime;
+                        read->proxyLevel = proxyLevel;
+                        read->promise = std::move(request.promise);
+                        reads.push_back(read);
+                    }
+                }
+
+                // Start the reads. Readers that support batches read several
+                // frames with the same proxy level in each task. Each task
+                // completes its promises as soon as the frames are decoded
+                // and frees their slots for the next requests.
+                for (size_t i = 0; i < reads.size();)
+                {
+                    const uint16_t proxyLevel = reads[i]->proxyLevel;
+                    size_t end = i + 1;
+                    while (end < reads.size() &&
+                        end - i < batchSize &&
+                        reads[end]->proxyLevel == proxyLevel)
+                    {
+                        ++end;
+                    }
+                    const std::vector<std::shared_ptr<Private::VideoFrameRead> > batch(
+                        reads.begin() + i,
+                        reads.begin() + end);
+                    i = end;
+                    auto task = [this, batch, proxyLevel]
+                    {
+                        std::vector<std::string> fileNames;
+                        std::vector<otime::RationalTime> times;
+                        for (const auto& read : batch)
+                        {
+                            fileNames.push_back(read->fileName);
+                            times.push_back(read->readTime);
+                        }
+                        std::vector<VideoFrame> videoFrames;
+                        try
+                        {
+                            videoFrames = _readVideoFrames(fileNames, times, proxyLevel);
+                        }
+                        catch (const std::exception&)
+                        {}
+                        videoFrames.resize(batch.size());
+                        for (size_t j = 0; j < batch.size(); ++j)
+                        {
+                            const auto& read = batch[j];
+
+                            // Downscale the images from readers that do not
+                            // support the proxy level, or only support some
+                            // of the levels.
+                            if (proxyLevel > 0 && videoFrames[j].image)
                             {
-                                VideoFrame out;
-                                try
+                                const imaging::Size& size = videoFrames[j].image->getSize();
+                                const imaging::Size proxySize = imaging::getProxySize(_p->imageSize, proxyLevel);
+                                if (size.w > proxySize.w || size.h > proxySize.h)
                                 {
-                                    out = _readVideoFrame(fileName, time);
+                                    videoFrames[j].image = imaging::downscale(
+                                        videoFrames[j].image,
+                                        imaging::getProxySize(size, imaging::getProxyLevel(size, proxySize)));
                                 }
-                                catch (const std::exception&)
-                                {}
-                                return out;
-                            });
-                        ++it;
+                            }
+
+                            if (read->time != read->readTime)
+                            {
+                                VideoFrame tmp = videoFrames[j];
+                                tmp.time = read->time;
+                                read->promise.set_value(tmp);
+                            }
+                            else
+                            {
+                                read->promise.set_value(videoFrames[j]);
+                            }
+                            if (_cache)
+                            {
+                                _cache->add(read->cacheKey, videoFrames[j]);
+                            }
+                            _finishVideoFrame();
+                        }
+                    };
+                    if (_threadPool)
+                    {
+                        _threadPool->run(task);
+                    }
+                    else
+                    {
+                        task();
                     }
                 }
-                for (auto& i : results)
+            }
+
+            // Wait for the reads that are still in flight.
+            std::unique_lock<std::mutex> lock(p.requestMutex);
+            p.requestCV.wait(
+                lock,
+                [this]
                 {
-                    auto videoFrame = i.future.get();
-                    i.promise.set_value(videoFrame);
-                    p.videoFrameCache.add(i.fileName, videoFrame);
+                    return 0 == _p->videoFramesInFlight;
+                });
+        }
+
+        std::vector<VideoFrame> ISequenceRead::_readVideoFrames(
+            const std::vector<std::string>& fileNames,
+            const std::vector<otime::RationalTime>& times,
+            uint16_t proxyLevel)
+        {
+            std::vector<VideoFrame> out;
+            for (size_t i = 0; i < fileNames.size(); ++i)
+            {
+                VideoFrame videoFrame;
+                try
+                {
+                    videoFrame = _readVideoFrame(fileNames[i], times[i], proxyLevel);
+                }
+                catch (const std::exception&)
+                {}
+                out.push_back(videoFrame);
+            }
+            return out;
+        }
+
+        std::string ISequenceRead::_getCacheOptions() const
+        {
+            return std::string();
+        }
+
+        std::shared_ptr<imaging::Image> ISequenceRead::_mapImage(
+            const std::shared_ptr<file::FileIO>& io,
+            const imaging::Info& info,
+            size_t offset) const
+        {
+            std::shared_ptr<imaging::Image> out;
+#if defined(TLR_ENABLE_MMAP)
+            if (file::DirectIO::Off == _directIO)
+            {
+                if (auto mmapRef = io->mmapRef())
+                {
+                    const size_t byteCount = imaging::getDataByteCount(info);
+                    if (offset + byteCount <= io->getSize() &&
+                        0 == offset % std::max(info.layout.alignment, static_cast<uint8_t>(1)))
+                    {
+                        out = imaging::Image::create(info, mmapRef.get() + offset, mmapRef);
+                    }
+                }
+            }
+#endif // TLR_ENABLE_MMAP
+            return out;
+        }
+
+        std::shared_ptr<imaging::Image> ISequenceRead::_readProxyImage(
+            const std::shared_ptr<file::FileIO>& io,
+            const imaging::Info& info,
+            size_t offset,
+            uint16_t proxyLevel) const
+        {
+            imaging::Info proxyInfo = info;
+            proxyInfo.size = imaging::getProxySize(info.size, proxyLevel);
+            auto out = imaging::Image::create(proxyInfo);
+
+            const uint8_t* mapped = nullptr;
+#if defined(TLR_ENABLE_MMAP)
+            std::shared_ptr<uint8_t> mmapRef;
+            if (file::DirectIO::Off == _directIO)
+            {
+                mmapRef = io->mmapRef();
+                if (mmapRef && offset + imaging::getDataByteCount(info) <= io->getSize())
+                {
+                    mapped = mmapRef.get() + offset;
+                }
+            }
+#endif // TLR_ENABLE_MMAP
+
+            const size_t step = static_cast<size_t>(1) << std::min(proxyLevel, static_cast<uint16_t>(15));
+            const size_t pixelByteCount = imaging::getDataByteCount(imaging::Info(1, 1, info.pixelType));
+            const size_t rowByteCount = info.size.w * pixelByteCount;
+            std::vector<uint8_t> row;
+            uint8_t* outP = out->getData();
+            for (size_t y = 0; y < proxyInfo.size.h; ++y)
+            {
+                const size_t rowOffset = y * step * rowByteCount;
+                const uint8_t* in = nullptr;
+                if (mapped)
+                {
+                    in = mapped + rowOffset;
+                }
+                else
+                {
+                    row.resize(rowByteCount);
+                    io->readAt(offset + rowOffset, row.data(), rowByteCount);
+                    in = row.data();
+                }
+                for (size_t x = 0; x < proxyInfo.size.w; ++x, outP += pixelByteCount)
+                {
+                    std::memcpy(outP, in + x * step * pixelByteCount, pixelByteCount);
+                }
+            }
+            return out;
+        }
+
+        bool ISequenceRead::_hasFrame(int64_t frame)
+        {
+            TLR_PRIVATE_P();
+            bool out = true;
+            if (p.index)
+            {
+                out = p.index->hasFrame(frame);
+                if (!out)
+                {
+                    // The frame may have been written since the directory
+                    // was last scanned.
+                    const auto now = std::chrono::steady_clock::now();
+                    if (now - p.indexTime >= p.indexTimeout)
+                    {
+                        p.indexTime = now;
+                        if (p.indexBackground && _threadPool)
+                        {
+                            // Don't block the requests while the directory is
+                            // scanned. The task keeps the index alive in case
+                            // the reader is destroyed first.
+                            if (!p.indexUpdating->exchange(true))
+                            {
+                                auto index = p.index;
+                                auto indexUpdating = p.indexUpdating;
+                                _threadPool->run(
+                                    [index, indexUpdating]
+                                    {
+                                        index->update();
+                                        *indexUpdating = false;
+                                    });
+                            }
+                        }
+                        else
+                        {
+                            p.index->update();
+                            out = p.index->hasFrame(frame);
+                        }
+                    }
                 }
             }
+            return out;
+        }
+
+        void ISequenceRead::_prefetch(int64_t frame, int64_t priority)
+        {
+            TLR_PRIVATE_P();
+
+            // Direct reads bypass the page cache, so there is nothing to
+            // gain from prefetching.
+            if (0 == p.prefetchCount || file::DirectIO::Direct == _directIO)
+            {
+                return;
+            }
+
+            // The direction of playback follows from the priorities the
+            // player gives the requests. After a seek the most urgent request
+            // is the playhead, and the next most urgent is the following
+            // frame in the playback direction. During playback the frames
+            // entering the read ahead are requested one at a time with the
+            // same priority. The read behind requests do not match either
+            // case, so they do not change the direction.
+            if (-1 == p.prefetchHead || priority < p.prefetchHeadPriority)
+            {
+                p.prefetchHead = frame;
+                p.prefetchHeadPriority = priority;
+            }
+            else if (priority == p.prefetchHeadPriority + 1 && frame != p.prefetchHead)
+            {
+                p.prefetchDirection = frame > p.prefetchHead ? 1 : -1;
+            }
+            else if (priority == p.prefetchPriority && p.prefetchFrame != -1 && frame != p.prefetchFrame)
+            {
+                p.prefetchDirection = frame > p.prefetchFrame ? 1 : -1;
+            }
+            p.prefetchFrame = frame;
+            p.prefetchPriority = priority;
+
+            // Forget the frames that are no longer near the requests.
+            const int64_t count = static_cast<int64_t>(p.prefetchCount);
+            p.prefetched.erase(p.prefetched.begin(), p.prefetched.lower_bound(frame - count));
+            p.prefetched.erase(p.prefetched.upper_bound(frame + count), p.prefetched.end());
+
+            for (int64_t i = 1; i <= count; ++i)
+            {
+                const int64_t prefetchFrame = frame + i * p.prefetchDirection;
+                if (p.prefetched.count(prefetchFrame) ||
+                    (p.index && !p.index->hasFrame(prefetchFrame)))
+                {
+                    continue;
+                }
+                p.prefetched.insert(prefetchFrame);
+                const std::string fileName = _path.get(static_cast<int>(prefetchFrame));
+                if (!_cache || !_cache->contains(CacheKey(fileName, prefetchFrame, imaging::PixelType::None, 0, p.cacheOptions)))
+                {
+                    if (_threadPool)
+                    {
+                        _threadPool->run(
+                            [fileName]
+                            {
+                                file::prefetch(fileName);
+                            });
+                    }
+                    else
+                    {
+                        file::prefetch(fileName);
+                    }
+                }
+            }
+        }
+
+        void ISequenceRead::_finishVideoFrame()
+        {
+            TLR_PRIVATE_P();
+
+            // Notify while holding the lock, the reader may be destroyed as
+            // soon as the last frame is finished.
+            std::unique_lock<std::mutex> lock(p.requestMutex);
+            --p.videoFramesInFlight;
+            p.requestCV.notify_all();
         }
 
         struct ISequenceWrite::Private
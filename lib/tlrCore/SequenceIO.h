@@ -5,6 +5,7 @@
 #pragma once
 
 #include <tlrCore/AVIO.h>
+#include <tlrCore/FileIO.h>
 
 namespace tlr
 {
@@ -13,19 +14,65 @@ namespace tlr
         //! Default speed for image sequences.
         const float sequenceDefaultSpeed = 24.F;
 
-        //! Number of threads.
+        //! Maximum number of frames read at the same time.
         const size_t sequenceThreadCount = 4;
 
+        //! Maximum number of frames read in one batch, by readers that
+        //! support batches.
+        const size_t sequenceBatchSize = 4;
+
+        //! Number of frames ahead of the requests in the playback direction
+        //! that are prefetched into the operating system's page cache.
+        const size_t sequencePrefetchCount = 8;
+
         //! Timeout for frame requests.
         const std::chrono::microseconds sequenceRequestTimeout(1000);
 
+        //! Minimum time between scans of the sequence directory when missing
+        //! frames are requested.
+        const std::chrono::seconds sequenceIndexTimeout(1);
+
+        //! Whether the sequence directory is scanned again in the background
+        //! when missing frames are requested.
+        const bool sequenceIndexBackground = true;
+
+        //! Image sequence missing frame options.
+        enum class SequenceMissingFrame
+        {
+            Empty, //!< Return an empty frame
+            Hold,  //!< Return the nearest frame that exists
+
+            Count,
+            First = Empty
+        };
+        TLR_ENUM(SequenceMissingFrame);
+        TLR_ENUM_SERIALIZE(SequenceMissingFrame);
+
         //! Base class for image sequence readers.
+        //!
+        //! The files in the sequence are indexed with a single scan of the
+        //! directory, and requests for missing frames are answered without
+        //! opening any files. The directory is scanned again when a missing
+        //! frame is requested, at most once every sequenceIndexTimeout. Unless
+        //! the "SequenceIO/IndexBackground" option is disabled, the scan runs
+        //! on the thread pool and the frame is reported missing until the
+        //! scan has finished.
+        //!
+        //! The files of the frames following the requests in the playback
+        //! direction are prefetched with file::prefetch(), so that the
+        //! storage can fetch them while the current frames are decoded.
+        //!
+        //! Requests with a size are read at the proxy level for the size of
+        //! the first frame, and cached separately from the full resolution
+        //! frames.
         class ISequenceRead : public IRead
         {
         protected:
             void _init(
                 const file::Path&,
                 const Options&,
+                const std::shared_ptr<Cache>&,
+                const std::shared_ptr<core::ThreadPool>&,
                 const std::shared_ptr<core::LogSystem>&);
             ISequenceRead();
 
@@ -33,7 +80,10 @@ namespace tlr
             ~ISequenceRead() override;
 
             std::future<Info> getInfo() override;
-            std::future<VideoFrame> readVideoFrame(const otime::RationalTime&) override;
+            std::future<VideoFrame> readVideoFrame(
+                const otime::RationalTime&,
+                int64_t priority = 0,
+                const imaging::Size& size = imaging::Size()) override;
             bool hasVideoFrames() override;
             void cancelVideoFrames() override;
             void stop() override;
@@ -41,14 +91,67 @@ namespace tlr
 
         protected:
             virtual Info _getInfo(const std::string& fileName) = 0;
+
+            //! Read a video frame. Readers that support proxies return the
+            //! image at the given proxy level, the others return the full
+            //! resolution image which is then downscaled.
             virtual VideoFrame _readVideoFrame(
                 const std::string& fileName,
-                const otime::RationalTime&) = 0;
+                const otime::RationalTime&,
+                uint16_t proxyLevel) = 0;
+
+            //! Read a batch of video frames. Frames that cannot be read are
+            //! returned empty. The default implementation calls
+            //! _readVideoFrame() for each frame.
+            virtual std::vector<VideoFrame> _readVideoFrames(
+                const std::vector<std::string>& fileNames,
+                const std::vector<otime::RationalTime>&,
+                uint16_t proxyLevel);
+
+            //! Get the reader options that change the decoded images. They
+            //! are added to the cache keys, so that readers of the same files
+            //! with different options do not share frames. This is called
+            //! once by _init(), after the derived class has read its options.
+            virtual std::string _getCacheOptions() const;
+
+            //! Create a read-only image that points directly into the
+            //! memory-map of the file, without copying the data. This
+            //! returns null if the file is not memory-mapped, direct I/O is
+            //! enabled, or the data is not aligned for the image layout.
+            std::shared_ptr<imaging::Image> _mapImage(
+                const std::shared_ptr<file::FileIO>&,
+                const imaging::Info&,
+                size_t offset) const;
+
+            //! Read an image at the given proxy level from uncompressed data,
+            //! by point sampling the rows and columns. Only the sampled rows
+            //! are read from the file, or they are sampled straight from the
+            //! memory-map.
+            std::shared_ptr<imaging::Image> _readProxyImage(
+                const std::shared_ptr<file::FileIO>&,
+                const imaging::Info&,
+                size_t offset,
+                uint16_t proxyLevel) const;
+
+            //! Stop the reader thread and wait for the reads in flight to
+            //! finish. Derived classes must call this from their destructor,
+            //! before the members used by the reads are destroyed.
+            void _finish();
 
             float _defaultSpeed = sequenceDefaultSpeed;
+            file::DirectIO _directIO = file::DirectIO::Off;
+
+            //! Readers that override _readVideoFrames() set this to receive
+            //! batches of frames. Each batch is read by one task, and up to
+            //! sequenceThreadCount full batches are in flight at the same
+            //! time.
+            bool _batchRead = false;
 
         private:
             void _run();
+            bool _hasFrame(int64_t);
+            void _prefetch(int64_t frame, int64_t priority);
+            void _finishVideoFrame();
 
             TLR_PRIVATE();
         };
@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCore/SequenceIndex.h>
+
+#include <tlrCore/File.h>
+
+#include <cstdlib>
+#include <map>
+#include <mutex>
+
+namespace tlr
+{
+    namespace file
+    {
+        struct SequenceIndex::Private
+        {
+            Path path;
+            std::map<int64_t, uint64_t> frames;
+            mutable std::mutex mutex;
+        };
+
+        void SequenceIndex::_init(const Path& path)
+        {
+            TLR_PRIVATE_P();
+            p.path = path;
+            update();
+        }
+
+        SequenceIndex::SequenceIndex() :
+            _p(new Private)
+        {}
+
+        SequenceIndex::~SequenceIndex()
+        {}
+
+        std::shared_ptr<SequenceIndex> SequenceIndex::create(const Path& path)
+        {
+            auto out = std::shared_ptr<SequenceIndex>(new SequenceIndex);
+            out->_init(path);
+            return out;
+        }
+
+        const Path& SequenceIndex::getPath() const
+        {
+            return _p->path;
+        }
+
+        void SequenceIndex::update()
+        {
+            TLR_PRIVATE_P();
+            const std::string& baseName = p.path.getBaseName();
+            const std::string& extension = p.path.getExtension();
+            std::map<int64_t, uint64_t> frames;
+            for (const auto& i : listDirectory(p.path.getDirectory(), baseName, extension))
+            {
+                const std::string& fileName = i.fileName;
+                const std::size_t size = fileName.size();
+                if (size > baseName.size() + extension.size() &&
+                    0 == fileName.compare(0, baseName.size(), baseName) &&
+                    0 == fileName.compare(size - extension.size(), extension.size(), extension))
+                {
+                    const std::string number = fileName.substr(
+                        baseName.size(),
+                        size - baseName.size() - extension.size());
+                    bool digits = number.size() < 10;
+                    for (auto j = number.begin(); j != number.end() && digits; ++j)
+                    {
+                        digits = *j >= '0' && *j <= '9';
+                    }
+                    if (digits)
+                    {
+                        // Only accept the file name if it matches the padding
+                        // of the path.
+                        const int frame = std::atoi(number.c_str());
+                        if (p.path.get(frame, false) == fileName)
+                        {
+                            frames[frame] = i.size;
+                        }
+                    }
+                }
+            }
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.frames.swap(frames);
+        }
+
+        std::size_t SequenceIndex::getCount() const
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.frames.size();
+        }
+
+        math::Range<int64_t> SequenceIndex::getRange() const
+        {
+            TLR_PRIVATE_P();
+            math::Range<int64_t> out;
+            std::unique_lock<std::mutex> lock(p.mutex);
+            if (!p.frames.empty())
+            {
+                out = math::Range<int64_t>(p.frames.begin()->first, p.frames.rbegin()->first);
+            }
+            return out;
+        }
+
+        bool SequenceIndex::hasFrame(int64_t frame) const
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.frames.find(frame) != p.frames.end();
+        }
+
+        uint64_t SequenceIndex::getSize(int64_t frame) const
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            const auto i = p.frames.find(frame);
+            return i != p.frames.end() ? i->second : 0;
+        }
+
+        std::vector<int64_t> SequenceIndex::getMissing() const
+        {
+            TLR_PRIVATE_P();
+            std::vector<int64_t> out;
+            std::unique_lock<std::mutex> lock(p.mutex);
+            if (!p.frames.empty())
+            {
+                int64_t frame = p.frames.begin()->first;
+                for (const auto& i : p.frames)
+                {
+                    for (; frame < i.first; ++frame)
+                    {
+                        out.push_back(frame);
+                    }
+                    frame = i.first + 1;
+                }
+            }
+            return out;
+        }
+
+        int64_t SequenceIndex::getNearest(int64_t frame) const
+        {
+            TLR_PRIVATE_P();
+            int64_t out = -1;
+            std::unique_lock<std::mutex> lock(p.mutex);
+            if (!p.frames.empty())
+            {
+                auto i = p.frames.lower_bound(frame);
+                if (i == p.frames.end())
+                {
+                    out = p.frames.rbegin()->first;
+                }
+                else if (i->first == frame || i == p.frames.begin())
+                {
+                    out = i->first;
+                }
+                else
+                {
+                    const int64_t next = i->first;
+                    const int64_t prev = (--i)->first;
+                    out = (frame - prev) <= (next - frame) ? prev : next;
+                }
+            }
+            return out;
+        }
+    }
+}
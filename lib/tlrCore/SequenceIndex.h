@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlrCore/Path.h>
+#include <tlrCore/Range.h>
+
+#include <memory>
+
+namespace tlr
+{
+    namespace file
+    {
+        //! Index of the files in a sequence.
+        //!
+        //! The index is built from a single scan of the sequence directory,
+        //! so that frames can be checked without touching the file system.
+        //!
+        //! The index is thread safe.
+        class SequenceIndex
+        {
+            TLR_NON_COPYABLE(SequenceIndex);
+
+        protected:
+            void _init(const Path&);
+            SequenceIndex();
+
+        public:
+            ~SequenceIndex();
+
+            //! Create a new sequence index. The directory is scanned when
+            //! the index is created.
+            static std::shared_ptr<SequenceIndex> create(const Path&);
+
+            //! Get the path.
+            const Path& getPath() const;
+
+            //! Scan the directory again.
+            void update();
+
+            //! Get the number of frames found.
+            std::size_t getCount() const;
+
+            //! Get the range of frames found.
+            math::Range<int64_t> getRange() const;
+
+            //! Does the frame exist?
+            bool hasFrame(int64_t) const;
+
+            //! Get the size of a frame's file in bytes, or zero if the frame
+            //! does not exist.
+            uint64_t getSize(int64_t) const;
+
+            //! Get the frames that are missing from the range.
+            std::vector<int64_t> getMissing() const;
+
+            //! Get the nearest frame that exists, or -1 if there are no
+            //! frames. Ties go to the earlier frame.
+            int64_t getNearest(int64_t) const;
+
+        private:
+            TLR_PRIVATE();
+        };
+    }
+}
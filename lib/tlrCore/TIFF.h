@@ -11,13 +11,23 @@ namespace tlr
     //! TIFF I/O.
     namespace tiff
     {
+        //! Default number of threads used to decode each frame.
+        const size_t decodeThreadCount = 4;
+
         //! TIFF reader.
+        //!
+        //! The strips or tiles of each frame are decoded in parallel by up to
+        //! "TIFF/ThreadCount" tasks on the thread pool, including the thread
+        //! reading the frame. Each task has its own TIFF handle reading from
+        //! the same memory-mapped file, and decodes straight into the image.
         class Read : public avio::ISequenceRead
         {
         protected:
             void _init(
                 const file::Path&,
                 const avio::Options&,
+                const std::shared_ptr<avio::Cache>&,
+                const std::shared_ptr<core::ThreadPool>&,
                 const std::shared_ptr<core::LogSystem>&);
             Read();
 
@@ -28,13 +38,19 @@ namespace tlr
             static std::shared_ptr<Read> create(
                 const file::Path&,
                 const avio::Options&,
+                const std::shared_ptr<avio::Cache>&,
+                const std::shared_ptr<core::ThreadPool>&,
                 const std::shared_ptr<core::LogSystem>&);
 
         protected:
             avio::Info _getInfo(const std::string& fileName) override;
             avio::VideoFrame _readVideoFrame(
                 const std::string& fileName,
-                const otime::RationalTime&) override;
+                const otime::RationalTime&,
+                uint16_t proxyLevel) override;
+
+        private:
+            TLR_PRIVATE();
         };
 
         //! TIFF writer.
@@ -4,10 +4,17 @@
 
 #include <tlrCore/TIFF.h>
 
+#include <tlrCore/FileIO.h>
 #include <tlrCore/StringFormat.h>
+#include <tlrCore/ThreadPool.h>
 
 #include <tiffio.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
 #include <sstream>
 
 namespace tlr
@@ -17,32 +24,35 @@ namespace tlr
         namespace
         {
             void readPalette(
-                uint8_t*  in,
-                int       size,
-                int       bytes,
-                uint16_t* red,
-                uint16_t* green,
-                uint16_t* blue)
+                const uint8_t* in,
+                uint8_t*       out,
+                int            size,
+                int            bytes,
+                uint16_t*      red,
+                uint16_t*      green,
+                uint16_t*      blue)
             {
+                // The output may overlap the input as long as it does not
+                // start before it, so the pixels are converted from the end.
                 switch (bytes)
                 {
                 case 1:
                 {
                     const uint8_t* inP = in + size - 1;
-                    uint8_t* outP = in + (size_t(size) - 1) * 3;
+                    uint8_t* outP = out + (size_t(size) - 1) * 3;
                     for (int x = 0; x < size; ++x, outP -= 3)
                     {
                         const uint8_t index = *inP--;
-                        outP[0] = static_cast<uint8_t>(red[index]);
-                        outP[1] = static_cast<uint8_t>(green[index]);
-                        outP[2] = static_cast<uint8_t>(blue[index]);
+                        outP[0] = static_cast<uint8_t>(red[index] >> 8);
+                        outP[1] = static_cast<uint8_t>(green[index] >> 8);
+                        outP[2] = static_cast<uint8_t>(blue[index] >> 8);
                     }
                 }
                 break;
                 case 2:
                 {
                     const uint16_t* inP = reinterpret_cast<const uint16_t*>(in) + size - 1;
-                    uint16_t* outP = reinterpret_cast<uint16_t*>(in) + (size_t(size) - 1) * 3;
+                    uint16_t* outP = reinterpret_cast<uint16_t*>(out) + (size_t(size) - 1) * 3;
                     for (int x = 0; x < size; ++x, outP -= 3)
                     {
                         const uint16_t index = *inP--;
@@ -55,16 +65,153 @@ namespace tlr
                 }
             }
 
-            class File
+            template<typename T>
+            void copySample(
+                const uint8_t* in,
+                uint8_t*       out,
+                size_t         size,
+                size_t         samples,
+                size_t         sample)
+            {
+                const T* inP = reinterpret_cast<const T*>(in);
+                T* outP = reinterpret_cast<T*>(out) + sample;
+                for (size_t x = 0; x < size; ++x, ++inP, outP += samples)
+                {
+                    *outP = *inP;
+                }
+            }
+
+            //! The file shared by the TIFF handles.
+            struct Source
+            {
+                std::string fileName;
+                std::shared_ptr<file::FileIO> io;
+                std::shared_ptr<uint8_t> mmap;
+            };
+
+            //! A TIFF handle reading from the shared file. Each handle has
+            //! its own file position so that the handles can be used from
+            //! different threads.
+            class Handle
             {
             public:
-                File(const std::string& fileName)
+                Handle(const std::shared_ptr<Source>& source) :
+                    _source(source)
                 {
-                    _f = TIFFOpen(fileName.data(), "r");
+                    _f = TIFFClientOpen(
+                        source->fileName.c_str(),
+                        "r",
+                        this,
+                        readProc,
+                        writeProc,
+                        seekProc,
+                        closeProc,
+                        sizeProc,
+                        mapProc,
+                        unmapProc);
                     if (!_f)
                     {
-                        throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
+                        throw std::runtime_error(string::Format("{0}: Cannot open").arg(source->fileName));
+                    }
+                }
+
+                ~Handle()
+                {
+                    if (_f)
+                    {
+                        TIFFClose(_f);
+                    }
+                }
+
+                TIFF* get() const
+                {
+                    return _f;
+                }
+
+            private:
+                static tmsize_t readProc(thandle_t h, void* data, tmsize_t size)
+                {
+                    Handle* handle = static_cast<Handle*>(h);
+                    const toff_t fileSize = handle->_source->io->getSize();
+                    const tmsize_t out = handle->_pos < fileSize ?
+                        static_cast<tmsize_t>(std::min(static_cast<toff_t>(size), fileSize - handle->_pos)) :
+                        0;
+                    try
+                    {
+                        handle->_source->io->readAt(handle->_pos, data, out);
+                    }
+                    catch (const std::exception&)
+                    {
+                        return -1;
+                    }
+                    handle->_pos += out;
+                    return out;
+                }
+
+                static tmsize_t writeProc(thandle_t, void*, tmsize_t)
+                {
+                    return 0;
+                }
+
+                static toff_t seekProc(thandle_t h, toff_t offset, int whence)
+                {
+                    Handle* handle = static_cast<Handle*>(h);
+                    switch (whence)
+                    {
+                    case SEEK_SET: handle->_pos = offset; break;
+                    case SEEK_CUR: handle->_pos += offset; break;
+                    case SEEK_END: handle->_pos = handle->_source->io->getSize() + offset; break;
+                    default: break;
+                    }
+                    return handle->_pos;
+                }
+
+                static int closeProc(thandle_t)
+                {
+                    return 0;
+                }
+
+                static toff_t sizeProc(thandle_t h)
+                {
+                    return static_cast<Handle*>(h)->_source->io->getSize();
+                }
+
+                static int mapProc(thandle_t h, void** base, toff_t* size)
+                {
+                    // Uncompressed strips and tiles are read straight from
+                    // the memory-map.
+                    Handle* handle = static_cast<Handle*>(h);
+                    if (handle->_source->mmap)
+                    {
+                        *base = handle->_source->mmap.get();
+                        *size = handle->_source->io->getSize();
+                        return 1;
                     }
+                    return 0;
+                }
+
+                static void unmapProc(thandle_t, void*, toff_t)
+                {}
+
+                std::shared_ptr<Source> _source;
+                toff_t _pos = 0;
+                TIFF* _f = nullptr;
+            };
+
+            class File
+            {
+            public:
+                File(const std::string& fileName, file::DirectIO directIO)
+                {
+                    _source = std::make_shared<Source>();
+                    _source->fileName = fileName;
+                    _source->io = file::FileIO::create();
+                    _source->io->open(fileName, file::Mode::Read, directIO);
+#if defined(TLR_ENABLE_MMAP)
+                    _source->mmap = _source->io->mmapRef();
+#endif // TLR_ENABLE_MMAP
+                    _handle.reset(new Handle(_source));
+                    TIFF* f = _handle->get();
 
                     uint32  tiffWidth = 0;
                     uint32  tiffHeight = 0;
@@ -77,28 +224,56 @@ namespace tlr
                     uint16  tiffOrient = 0;
                     uint16  tiffCompression = 0;
                     uint16  tiffPlanarConfig = 0;
-                    TIFFGetFieldDefaulted(_f, TIFFTAG_IMAGEWIDTH, &tiffWidth);
-                    TIFFGetFieldDefaulted(_f, TIFFTAG_IMAGELENGTH, &tiffHeight);
-                    TIFFGetFieldDefaulted(_f, TIFFTAG_PHOTOMETRIC, &tiffPhotometric);
-                    TIFFGetFieldDefaulted(_f, TIFFTAG_SAMPLESPERPIXEL, &tiffSamples);
-                    TIFFGetFieldDefaulted(_f, TIFFTAG_BITSPERSAMPLE, &tiffSampleDepth);
-                    TIFFGetFieldDefaulted(_f, TIFFTAG_SAMPLEFORMAT, &tiffSampleFormat);
-                    TIFFGetFieldDefaulted(_f, TIFFTAG_EXTRASAMPLES, &tiffExtraSamplesSize, &tiffExtraSamples);
-                    TIFFGetFieldDefaulted(_f, TIFFTAG_ORIENTATION, &tiffOrient);
-                    TIFFGetFieldDefaulted(_f, TIFFTAG_COMPRESSION, &tiffCompression);
-                    TIFFGetFieldDefaulted(_f, TIFFTAG_PLANARCONFIG, &tiffPlanarConfig);
-                    TIFFGetFieldDefaulted(_f, TIFFTAG_COLORMAP, &_colormap[0], &_colormap[1], &_colormap[2]);
+                    uint32  tiffRowsPerStrip = 0;
+                    uint32  tiffTileWidth = 0;
+                    uint32  tiffTileHeight = 0;
+                    TIFFGetFieldDefaulted(f, TIFFTAG_IMAGEWIDTH, &tiffWidth);
+                    TIFFGetFieldDefaulted(f, TIFFTAG_IMAGELENGTH, &tiffHeight);
+                    TIFFGetFieldDefaulted(f, TIFFTAG_PHOTOMETRIC, &tiffPhotometric);
+                    TIFFGetFieldDefaulted(f, TIFFTAG_SAMPLESPERPIXEL, &tiffSamples);
+                    TIFFGetFieldDefaulted(f, TIFFTAG_BITSPERSAMPLE, &tiffSampleDepth);
+                    TIFFGetFieldDefaulted(f, TIFFTAG_SAMPLEFORMAT, &tiffSampleFormat);
+                    TIFFGetFieldDefaulted(f, TIFFTAG_EXTRASAMPLES, &tiffExtraSamplesSize, &tiffExtraSamples);
+                    TIFFGetFieldDefaulted(f, TIFFTAG_ORIENTATION, &tiffOrient);
+                    TIFFGetFieldDefaulted(f, TIFFTAG_COMPRESSION, &tiffCompression);
+                    TIFFGetFieldDefaulted(f, TIFFTAG_PLANARCONFIG, &tiffPlanarConfig);
+                    TIFFGetFieldDefaulted(f, TIFFTAG_COLORMAP, &_colormap[0], &_colormap[1], &_colormap[2]);
                     _palette = PHOTOMETRIC_PALETTE == tiffPhotometric;
                     _planar = PLANARCONFIG_SEPARATE == tiffPlanarConfig;
+                    _width = tiffWidth;
+                    _height = tiffHeight;
                     _samples = tiffSamples;
                     _sampleDepth = tiffSampleDepth;
                     _scanlineSize = tiffWidth * tiffSamples * tiffSampleDepth / 8;
 
+                    // Get the layout of the strips or tiles.
+                    _tiled = TIFFIsTiled(f) != 0;
+                    if (_tiled)
+                    {
+                        TIFFGetField(f, TIFFTAG_TILEWIDTH, &tiffTileWidth);
+                        TIFFGetField(f, TIFFTAG_TILELENGTH, &tiffTileHeight);
+                        _chunkWidth = tiffTileWidth;
+                        _chunkHeight = tiffTileHeight;
+                        _chunkCount = TIFFNumberOfTiles(f);
+                        _chunkByteCount = TIFFTileSize(f);
+                    }
+                    else
+                    {
+                        TIFFGetFieldDefaulted(f, TIFFTAG_ROWSPERSTRIP, &tiffRowsPerStrip);
+                        _chunkWidth = tiffWidth;
+                        _chunkHeight = std::min(tiffRowsPerStrip, tiffHeight);
+                        _chunkCount = TIFFNumberOfStrips(f);
+                        _chunkByteCount = TIFFStripSize(f);
+                    }
+
                     imaging::PixelType pixelType = imaging::PixelType::None;
                     switch (tiffPhotometric)
                     {
                     case PHOTOMETRIC_PALETTE:
-                        pixelType = imaging::PixelType::RGB_U8;
+                        if (8 == tiffSampleDepth)
+                        {
+                            pixelType = imaging::PixelType::RGB_U8;
+                        }
                         break;
                     case PHOTOMETRIC_MINISWHITE:
                     case PHOTOMETRIC_MINISBLACK:
@@ -115,7 +290,9 @@ namespace tlr
                         }
                         break;
                     }
-                    if (imaging::PixelType::None == pixelType)
+                    if (imaging::PixelType::None == pixelType ||
+                        0 == _chunkWidth ||
+                        0 == _chunkHeight)
                     {
                         throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
                     }
@@ -123,28 +300,28 @@ namespace tlr
                     _info.video.push_back(imaging::Info(tiffWidth, tiffHeight, pixelType));
 
                     char* tag = 0;
-                    if (TIFFGetField(_f, TIFFTAG_ARTIST, &tag))
+                    if (TIFFGetField(f, TIFFTAG_ARTIST, &tag))
                     {
                         if (tag)
                         {
                             _info.tags["Creator"] = tag;
                         }
                     }
-                    if (TIFFGetField(_f, TIFFTAG_IMAGEDESCRIPTION, &tag))
+                    if (TIFFGetField(f, TIFFTAG_IMAGEDESCRIPTION, &tag))
                     {
                         if (tag)
                         {
                             _info.tags["Description"] = tag;
                         }
                     }
-                    if (TIFFGetField(_f, TIFFTAG_COPYRIGHT, &tag))
+                    if (TIFFGetField(f, TIFFTAG_COPYRIGHT, &tag))
                     {
                         if (tag)
                         {
                             _info.tags["Copyright"] = tag;
                         }
                     }
-                    if (TIFFGetField(_f, TIFFTAG_DATETIME, &tag))
+                    if (TIFFGetField(f, TIFFTAG_DATETIME, &tag))
                     {
                         if (tag)
                         {
@@ -153,100 +330,88 @@ namespace tlr
                     }
                 }
 
-                ~File()
-                {
-                    if (_f)
-                    {
-                        TIFFClose(_f);
-                    }
-                }
-
                 const avio::Info& getInfo() const
                 {
                     return _info;
                 }
 
                 avio::VideoFrame read(
-                    const std::string& fileName,
-                    const otime::RationalTime& time)
+                    const otime::RationalTime& time,
+                    size_t threadCount,
+                    const std::shared_ptr<core::ThreadPool>& threadPool)
                 {
                     avio::VideoFrame out;
                     out.time = time;
                     const auto& info = _info.video[0];
                     out.image = imaging::Image::create(info);
                     out.image->setTags(_info.tags);
+                    uint8_t* data = out.image->getData();
 
-                    if (_planar)
+                    // Each task opens its own handle and takes the next
+                    // strip or tile until they have all been decoded. This
+                    // thread decodes with the first handle, and then cancels
+                    // the tasks that the thread pool has not started, so
+                    // that it never waits on work that is still queued.
+                    struct Decode
                     {
-                        std::vector<uint8_t> scanline;
-                        scanline.resize(info.size.w * _sampleDepth / 8);
-                        for (size_t sample = 0; sample < _samples; ++sample)
-                        {
-                            for (uint16_t y = 0; y < info.size.h; ++y)
+                        std::atomic<size_t> next;
+                        bool finished = false;
+                        size_t running = 0;
+                        std::condition_variable cv;
+                        std::mutex mutex;
+                    };
+                    auto decode = std::make_shared<Decode>();
+                    decode->next = 0;
+                    const size_t taskCount = threadPool ? std::min(threadCount, _chunkCount) : 1;
+                    for (size_t i = 1; i < taskCount; ++i)
+                    {
+                        threadPool->run(
+                            [this, decode, data]
                             {
-                                if (TIFFReadScanline(_f, (tdata_t*)scanline.data(), y, sample) == -1)
-                                {
-                                    break;
-                                }
-                                uint8_t* p = out.image->getData() + y * _scanlineSize;
-                                switch (_sampleDepth)
                                 {
-                                case 8:
-                                {
-                                    const uint8_t* inP = scanline.data();
-                                    uint8_t* outP = p + sample;
-                                    for (uint16_t x = 0; x < info.size.w; ++x, ++inP, outP += _samples)
+                                    std::unique_lock<std::mutex> lock(decode->mutex);
+                                    if (decode->finished)
                                     {
-                                        *outP = *inP;
+                                        return;
                                     }
-                                    break;
+                                    ++decode->running;
                                 }
-                                case 16:
+                                try
                                 {
-                                    const uint16_t* inP = reinterpret_cast<uint16_t*>(scanline.data());
-                                    uint16_t* outP = reinterpret_cast<uint16_t*>(p) + sample;
-                                    for (uint16_t x = 0; x < info.size.w; ++x, ++inP, outP += _samples)
-                                    {
-                                        *outP = *inP;
-                                    }
-                                    break;
+                                    Handle handle(_source);
+                                    _decode(handle.get(), decode->next, data);
                                 }
-                                case 32:
-                                {
-                                    const float* inP = reinterpret_cast<float*>(scanline.data());
-                                    float* outP = reinterpret_cast<float*>(p) + sample;
-                                    for (uint16_t x = 0; x < info.size.w; ++x, ++inP, outP += _samples)
-                                    {
-                                        *outP = *inP;
-                                    }
-                                    break;
-                                }
-                                default:
-                                    break;
-                                }
-                            }
-                        }
+                                catch (const std::exception&)
+                                {}
+                                std::unique_lock<std::mutex> lock(decode->mutex);
+                                --decode->running;
+                                decode->cv.notify_all();
+                            });
                     }
-                    else
+                    _decode(_handle->get(), decode->next, data);
                     {
-                        for (uint16_t y = 0; y < info.size.h; ++y)
-                        {
-                            const uint8_t* p = out.image->getData() + y * _scanlineSize;
-                            if (TIFFReadScanline(_f, (tdata_t*)p, y) == -1)
+                        std::unique_lock<std::mutex> lock(decode->mutex);
+                        decode->finished = true;
+                        decode->cv.wait(
+                            lock,
+                            [decode]
                             {
-                                break;
-                            }
-                        }
+                                return 0 == decode->running;
+                            });
                     }
 
+                    // Palette images are decoded as packed indices, which
+                    // are converted in place starting from the last row.
                     if (_palette)
                     {
-                        for (uint16_t y = 0; y < info.size.h; ++y)
+                        const size_t rowByteCount = imaging::getChannelCount(info.pixelType) * _scanlineSize;
+                        for (size_t y = _height; y > 0; --y)
                         {
                             readPalette(
-                                out.image->getData() + y * _scanlineSize,
-                                info.size.w,
-                                static_cast<int>(imaging::getChannelCount(info.pixelType)),
+                                data + (y - 1) * _scanlineSize,
+                                data + (y - 1) * rowByteCount,
+                                static_cast<int>(_width),
+                                static_cast<int>(_sampleDepth / 8),
                                 _colormap[0], _colormap[1], _colormap[2]);
                         }
                     }
@@ -255,53 +420,139 @@ namespace tlr
                 }
 
             private:
-                TIFF*      _f = nullptr;
+                void _decode(TIFF* f, std::atomic<size_t>& next, uint8_t* data)
+                {
+                    // Contiguous strips are decoded straight into the image,
+                    // everything else is decoded into a buffer and copied.
+                    const bool direct = !_tiled && !_planar;
+                    std::vector<uint8_t> buffer(direct ? 0 : _chunkByteCount);
+                    const size_t pixelByteCount = _samples * _sampleDepth / 8;
+                    const size_t chunkRowByteCount = _chunkWidth * (_planar ? 1 : _samples) * _sampleDepth / 8;
+                    const size_t across = (_width + _chunkWidth - 1) / _chunkWidth;
+                    const size_t down = (_height + _chunkHeight - 1) / _chunkHeight;
+                    const size_t planeChunkCount = std::max(across * down, static_cast<size_t>(1));
+                    for (size_t chunk = next++; chunk < _chunkCount; chunk = next++)
+                    {
+                        const size_t sample = chunk / planeChunkCount;
+                        const size_t x0 = (chunk % planeChunkCount) % across * _chunkWidth;
+                        const size_t y0 = (chunk % planeChunkCount) / across * _chunkHeight;
+                        if (sample >= _samples || y0 >= _height)
+                        {
+                            continue;
+                        }
+                        const size_t w = std::min(_chunkWidth, _width - x0);
+                        const size_t h = std::min(_chunkHeight, _height - y0);
+                        uint8_t* p = data + y0 * _scanlineSize + x0 * pixelByteCount;
+                        if (direct)
+                        {
+                            TIFFReadEncodedStrip(f, static_cast<uint32>(chunk), p, h * _scanlineSize);
+                            continue;
+                        }
+                        const tmsize_t r = _tiled ?
+                            TIFFReadEncodedTile(f, static_cast<uint32>(chunk), buffer.data(), buffer.size()) :
+                            TIFFReadEncodedStrip(f, static_cast<uint32>(chunk), buffer.data(), buffer.size());
+                        if (-1 == r)
+                        {
+                            continue;
+                        }
+                        for (size_t y = 0; y < h; ++y, p += _scanlineSize)
+                        {
+                            const uint8_t* bufferP = buffer.data() + y * chunkRowByteCount;
+                            if (_planar)
+                            {
+                                switch (_sampleDepth)
+                                {
+                                case 8: copySample<uint8_t>(bufferP, p, w, _samples, sample); break;
+                                case 16: copySample<uint16_t>(bufferP, p, w, _samples, sample); break;
+                                case 32: copySample<float>(bufferP, p, w, _samples, sample); break;
+                                default: break;
+                                }
+                            }
+                            else
+                            {
+                                memcpy(p, bufferP, w * pixelByteCount);
+                            }
+                        }
+                    }
+                }
+
+                std::shared_ptr<Source> _source;
+                std::unique_ptr<Handle> _handle;
                 bool       _palette = false;
                 uint16*    _colormap[3] = { nullptr, nullptr, nullptr };
                 bool       _planar = false;
+                bool       _tiled = false;
+                size_t     _width = 0;
+                size_t     _height = 0;
                 size_t     _samples = 0;
                 size_t     _sampleDepth = 0;
                 size_t     _scanlineSize = 0;
+                size_t     _chunkWidth = 0;
+                size_t     _chunkHeight = 0;
+                size_t     _chunkCount = 0;
+                size_t     _chunkByteCount = 0;
                 avio::Info _info;
             };
         }
 
+        struct Read::Private
+        {
+            size_t threadCount = decodeThreadCount;
+        };
+
         void Read::_init(
             const file::Path& path,
             const avio::Options& options,
+            const std::shared_ptr<avio::Cache>& cache,
+            const std::shared_ptr<core::ThreadPool>& threadPool,
             const std::shared_ptr<core::LogSystem>& logSystem)
         {
-            ISequenceRead::_init(path, options, logSystem);
+            TLR_PRIVATE_P();
+
+            auto i = options.find("TIFF/ThreadCount");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.threadCount;
+            }
+
+            ISequenceRead::_init(path, options, cache, threadPool, logSystem);
         }
 
-        Read::Read()
+        Read::Read() :
+            _p(new Private)
         {}
 
         Read::~Read()
-        {}
+        {
+            _finish();
+        }
 
         std::shared_ptr<Read> Read::create(
             const file::Path& path,
             const avio::Options& options,
+            const std::shared_ptr<avio::Cache>& cache,
+            const std::shared_ptr<core::ThreadPool>& threadPool,
             const std::shared_ptr<core::LogSystem>& logSystem)
         {
             auto out = std::shared_ptr<Read>(new Read);
-            out->_init(path, options, logSystem);
+            out->_init(path, options, cache, threadPool, logSystem);
             return out;
         }
 
         avio::Info Read::_getInfo(const std::string& fileName)
         {
-            avio::Info out = std::unique_ptr<File>(new File(fileName))->getInfo();
+            avio::Info out = std::unique_ptr<File>(new File(fileName, _directIO))->getInfo();
             out.videoDuration = otime::RationalTime(1.0, _defaultSpeed);
             return out;
         }
 
         avio::VideoFrame Read::_readVideoFrame(
             const std::string& fileName,
-            const otime::RationalTime& time)
+            const otime::RationalTime& time,
+            uint16_t proxyLevel)
         {
-            return std::unique_ptr<File>(new File(fileName))->read(fileName, time);
+            return std::unique_ptr<File>(new File(fileName, _directIO))->read(time, _p->threadCount, _threadPool);
         }
     }
 }
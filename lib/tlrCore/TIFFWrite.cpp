@@ -88,7 +88,6 @@ namespace tlr
                     {
                         throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
                     }
-                    const size_t scanlineSize = info.size.w * tiffSamples * tiffSampleDepth / 8;
 
                     tiffCompression = COMPRESSION_NONE;
                     /*switch (_p->options.compression)
@@ -137,9 +136,10 @@ namespace tlr
                         TIFFSetField(_f, TIFFTAG_IMAGEDESCRIPTION, i->second.c_str());
                     }
 
+                    const size_t stride = image->getPlaneStride(0);
                     for (uint16_t y = 0; y < info.size.h; ++y)
                     {
-                        uint8_t* p = image->getData() + (y * scanlineSize);
+                        uint8_t* p = image->getPlaneData(0) + y * stride;
                         if (TIFFWriteScanline(_f, (tdata_t*)p, y) == -1)
                         {
                             throw std::runtime_error(string::Format("{0}: Cannot write scanline: {1}").arg(fileName).arg(y));
@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCore/ThreadPool.h>
+
+#include <tlrCore/StringFormat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace tlr
+{
+    namespace core
+    {
+        namespace
+        {
+            const std::chrono::milliseconds taskTimeout(5);
+        }
+
+        struct ThreadPool::Private
+        {
+            struct Queue
+            {
+                std::deque<std::function<void(void)> > tasks;
+                std::mutex mutex;
+            };
+            std::vector<std::unique_ptr<Queue> > queues;
+            std::vector<std::thread> threads;
+            std::atomic<std::size_t> next;
+
+            std::size_t pending = 0;
+            std::condition_variable cv;
+            std::mutex mutex;
+            std::atomic<bool> running;
+
+            std::atomic<std::size_t> submitted;
+            std::atomic<std::size_t> completed;
+            std::atomic<std::size_t> stolen;
+
+            bool pop(std::size_t index, std::function<void(void)>&);
+        };
+
+        void ThreadPool::_init()
+        {
+            TLR_PRIVATE_P();
+
+            const std::size_t threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+            for (std::size_t i = 0; i < threadCount; ++i)
+            {
+                p.queues.push_back(std::unique_ptr<Private::Queue>(new Private::Queue));
+            }
+            p.next = 0;
+            p.running = true;
+            p.submitted = 0;
+            p.completed = 0;
+            p.stolen = 0;
+            for (std::size_t i = 0; i < threadCount; ++i)
+            {
+                p.threads.push_back(std::thread(
+                    [this, i]
+                    {
+                        _run(i);
+                    }));
+            }
+
+            _log(string::Format("Thread count: {0}").arg(threadCount));
+        }
+
+        ThreadPool::ThreadPool(const std::shared_ptr<Context>& context) :
+            ISystem("tlr::core::ThreadPool", context),
+            _p(new Private)
+        {}
+
+        ThreadPool::~ThreadPool()
+        {
+            TLR_PRIVATE_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.running = false;
+            }
+            p.cv.notify_all();
+            for (auto& i : p.threads)
+            {
+                if (i.joinable())
+                {
+                    i.join();
+                }
+            }
+        }
+
+        std::shared_ptr<ThreadPool> ThreadPool::create(const std::shared_ptr<Context>& context)
+        {
+            auto out = std::shared_ptr<ThreadPool>(new ThreadPool(context));
+            out->_init();
+            return out;
+        }
+
+        std::size_t ThreadPool::getThreadCount() const
+        {
+            return _p->threads.size();
+        }
+
+        ThreadPoolStats ThreadPool::getStats() const
+        {
+            TLR_PRIVATE_P();
+            ThreadPoolStats out;
+            out.threadCount = p.threads.size();
+            out.submitted = p.submitted;
+            out.completed = p.completed;
+            out.stolen = p.stolen;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                out.pending = p.pending;
+            }
+            return out;
+        }
+
+        void ThreadPool::run(const std::function<void(void)>& task, int affinity)
+        {
+            TLR_PRIVATE_P();
+            const std::size_t index = affinity >= 0 ?
+                (static_cast<std::size_t>(affinity) % p.queues.size()) :
+                (p.next++ % p.queues.size());
+            {
+                std::unique_lock<std::mutex> lock(p.queues[index]->mutex);
+                p.queues[index]->tasks.push_back(task);
+            }
+            ++p.submitted;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                ++p.pending;
+            }
+            p.cv.notify_one();
+        }
+
+        bool ThreadPool::Private::pop(std::size_t index, std::function<void(void)>& task)
+        {
+            auto& queue = *queues[index];
+            std::unique_lock<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty())
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+            return false;
+        }
+
+        void ThreadPool::_run(std::size_t index)
+        {
+            TLR_PRIVATE_P();
+            const std::size_t queueCount = p.queues.size();
+            while (p.running)
+            {
+                // Run a task from our own queue first, then try to steal
+                // one from the other queues.
+                std::function<void(void)> task;
+                bool found = p.pop(index, task);
+                for (std::size_t i = 1; !found && i < queueCount; ++i)
+                {
+                    if (p.pop((index + i) % queueCount, task))
+                    {
+                        found = true;
+                        ++p.stolen;
+                    }
+                }
+                if (found)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(p.mutex);
+                        --p.pending;
+                    }
+                    try
+                    {
+                        task();
+                    }
+                    catch (const std::exception&)
+                    {
+                        //! \todo How should this be handled?
+                    }
+                    ++p.completed;
+                }
+                else
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex);
+                    p.cv.wait_for(
+                        lock,
+                        taskTimeout,
+                        [this]
+                        {
+                            return _p->pending > 0 || !_p->running;
+                        });
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlrCore/ISystem.h>
+
+#include <functional>
+#include <future>
+#include <type_traits>
+
+namespace tlr
+{
+    namespace core
+    {
+        //! No thread affinity.
+        const int noAffinity = -1;
+
+        //! Thread pool statistics.
+        struct ThreadPoolStats
+        {
+            //! Number of worker threads.
+            std::size_t threadCount = 0;
+
+            //! Number of tasks submitted.
+            std::size_t submitted = 0;
+
+            //! Number of tasks completed.
+            std::size_t completed = 0;
+
+            //! Number of tasks taken from another thread's queue.
+            std::size_t stolen = 0;
+
+            //! Number of tasks waiting to run.
+            std::size_t pending = 0;
+        };
+
+        //! Thread pool.
+        //!
+        //! Each worker thread has its own task queue. Tasks are added to the
+        //! queue given by the affinity hint, or to the queues in turn when
+        //! there is no hint. Workers run the tasks in their own queue first,
+        //! and take tasks from the other queues when their own is empty.
+        //!
+        //! Tasks should not block waiting on other tasks in the pool.
+        class ThreadPool : public ISystem
+        {
+            TLR_NON_COPYABLE(ThreadPool);
+
+        protected:
+            void _init();
+            ThreadPool(const std::shared_ptr<Context>&);
+
+        public:
+            ~ThreadPool() override;
+
+            //! Create a new thread pool.
+            static std::shared_ptr<ThreadPool> create(const std::shared_ptr<Context>&);
+
+            //! Get the number of worker threads.
+            std::size_t getThreadCount() const;
+
+            //! Get the statistics.
+            ThreadPoolStats getStats() const;
+
+            //! Run a task. Tasks with the same affinity hint prefer to run on
+            //! the same worker thread.
+            void run(const std::function<void(void)>&, int affinity = noAffinity);
+
+            //! Run a task and get a future for the result.
+            template<typename T>
+            std::future<typename std::result_of<T()>::type> submit(T&&, int affinity = noAffinity);
+
+        private:
+            void _run(std::size_t);
+
+            TLR_PRIVATE();
+        };
+    }
+}
+
+#include <tlrCore/ThreadPoolInline.h>
@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+namespace tlr
+{
+    namespace core
+    {
+        template<typename T>
+        inline std::future<typename std::result_of<T()>::type> ThreadPool::submit(T&& value, int affinity)
+        {
+            typedef typename std::result_of<T()>::type Result;
+            auto task = std::make_shared<std::packaged_task<Result()> >(std::forward<T>(value));
+            auto out = task->get_future();
+            run(
+                [task]
+                {
+                    (*task)();
+                },
+                affinity);
+            return out;
+        }
+    }
+}
@@ -28,6 +28,7 @@
 #include <array>
 #include <iomanip>
 #include <iostream>
+#include <list>
 #include <mutex>
 #include <sstream>
 #include <thread>
@@ -122,6 +123,23 @@ namespace tlr
             return !(*this == other);
         }
 
+        std::size_t getDataByteCount(const Frame& frame)
+        {
+            std::size_t out = 0;
+            for (const auto& i : frame.layers)
+            {
+                if (i.image)
+                {
+                    out += i.image->getDataByteCount();
+                }
+                if (i.imageB)
+                {
+                    out += i.imageB->getDataByteCount();
+                }
+            }
+            return out;
+        }
+
         namespace
         {
 #if defined(TLR_ENABLE_PYTHON)
@@ -206,7 +224,9 @@ namespace tlr
             std::future<avio::VideoFrame> readVideoFrame(
                 const otio::Track*,
                 const otio::Clip*,
-                const otime::RationalTime&);
+                const otime::RationalTime&,
+                int64_t priority,
+                const imaging::Size&);
             void stopReaders();
             void delReaders();
 
@@ -224,12 +244,35 @@ namespace tlr
                 Request(Request&&) = default;
 
                 otime::RationalTime time = time::invalidTime;
+                int64_t priority = 0;
+                imaging::Size size;
                 std::promise<Frame> promise;
             };
             std::list<Request> requests;
             std::condition_variable requestCV;
             std::mutex requestMutex;
 
+            struct LayerData
+            {
+                LayerData() {};
+                LayerData(LayerData&&) = default;
+
+                std::future<avio::VideoFrame> image;
+                std::future<avio::VideoFrame> imageB;
+                Transition transition = Transition::None;
+                float transitionValue = 0.F;
+            };
+            struct Result
+            {
+                Result() {};
+                Result(Result&&) = default;
+
+                otime::RationalTime time = time::invalidTime;
+                std::vector<LayerData> layerData;
+                std::promise<Frame> promise;
+            };
+            std::list<Result> results;
+
             struct Reader
             {
                 std::shared_ptr<avio::IRead> read;
@@ -335,15 +378,25 @@ namespace tlr
             return _p->imageInfo;
         }
 
-        std::future<Frame> Timeline::getFrame(const otime::RationalTime& time)
+        std::future<Frame> Timeline::getFrame(
+            const otime::RationalTime& time,
+            int64_t priority,
+            const imaging::Size& size)
         {
             TLR_PRIVATE_P();
             Private::Request request;
             request.time = time;
+            request.priority = priority;
+            request.size = size;
             auto future = request.promise.get_future();
             {
                 std::unique_lock<std::mutex> lock(p.requestMutex);
-                p.requests.push_back(std::move(request));
+                auto i = p.requests.begin();
+                while (i != p.requests.end() && i->priority <= priority)
+                {
+                    ++i;
+                }
+                p.requests.insert(i, std::move(request));
             }
             p.requestCV.notify_one();
             return future;
@@ -351,7 +404,9 @@ namespace tlr
 
         void Timeline::setActiveRanges(const std::vector<otime::TimeRange>& ranges)
         {
-            _p->activeRanges = ranges;
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.requestMutex);
+            p.activeRanges = ranges;
         }
 
         void Timeline::cancelFrames()
@@ -441,24 +496,9 @@ namespace tlr
 
         void Timeline::Private::frameRequests()
         {
-            struct LayerData
-            {
-                LayerData() {};
-                LayerData(LayerData&&) = default;
-
-                std::future<avio::VideoFrame> image;
-                std::future<avio::VideoFrame> imageB;
-                Transition transition = Transition::None;
-                float transitionValue = 0.F;
-            };
-            struct Result
-            {
-                otime::RationalTime time = time::invalidTime;
-                std::vector<LayerData> layerData;
-                std::promise<Frame> promise;
-            };
-            Result result;
-            bool resultValid = false;
+            // Get new requests, dropping the ones that are no longer in the
+            // active time ranges.
+            std::list<Request> newRequests;
             {
                 std::unique_lock<std::mutex> lock(requestMutex);
                 requestCV.wait_for(
@@ -466,20 +506,37 @@ namespace tlr
                     requestTimeout,
                     [this]
                     {
-                        return !requests.empty();
+                        return !requests.empty() && results.size() < requestCount;
                     });
-                if (!requests.empty())
+                while (!requests.empty() && results.size() + newRequests.size() < requestCount)
                 {
-                    result.time = requests.front().time;
-                    result.promise = std::move(requests.front().promise);
-                    resultValid = true;
+                    bool active = activeRanges.empty();
+                    for (const auto& i : activeRanges)
+                    {
+                        if (i.contains(requests.front().time))
+                        {
+                            active = true;
+                            break;
+                        }
+                    }
+                    if (active)
+                    {
+                        newRequests.push_back(std::move(requests.front()));
+                    }
+                    else
+                    {
+                        requests.front().promise.set_value(Frame());
+                    }
                     requests.pop_front();
                 }
             }
-            if (resultValid)
+
+            // Start reading the frames for the new requests.
+            for (auto& request : newRequests)
             {
-                Frame frame;
-                frame.time = result.time;
+                Result result;
+                result.time = request.time;
+                result.promise = std::move(request.promise);
                 try
                 {
                     for (const auto& j : timeline->tracks()->children())
@@ -496,11 +553,11 @@ namespace tlr
                                     if (rangeOpt.has_value())
                                     {
                                         const auto range = rangeOpt.value();
-                                        const auto time = result.time - globalStartTime;
+                                        const auto time = request.time - globalStartTime;
                                         if (range.contains(time))
                                         {
                                             LayerData data;
-                                            data.image = readVideoFrame(track, clip, time);
+                                            data.image = readVideoFrame(track, clip, time, request.priority, request.size);
                                             auto clipStartTime = clip->trimmed_range(&errorStatus).start_time();
                                             const auto neighbors = track->neighbors_of(clip, &errorStatus);
                                             if (auto transition = dynamic_cast<otio::Transition*>(neighbors.second.value))
@@ -511,7 +568,7 @@ namespace tlr
                                                     const auto transitionNeighbors = track->neighbors_of(transition, &errorStatus);
                                                     if (const auto clipB = dynamic_cast<otio::Clip*>(transitionNeighbors.second.value))
                                                     {
-                                                        data.imageB = readVideoFrame(track, clipB, time);
+                                                        data.imageB = readVideoFrame(track, clipB, time, request.priority, request.size);
                                                         data.transition = toTransition(transition->transition_type());
                                                         data.transitionValue = otime::RationalTime(time - transitionStartTime).value() /
                                                             (transition->in_offset().value() + transition->out_offset().value() + 1.0);
@@ -527,7 +584,7 @@ namespace tlr
                                                     const auto transitionNeighbors = track->neighbors_of(transition, &errorStatus);
                                                     if (const auto clipB = dynamic_cast<otio::Clip*>(transitionNeighbors.first.value))
                                                     {
-                                                        data.imageB = readVideoFrame(track, clipB, time);
+                                                        data.imageB = readVideoFrame(track, clipB, time, request.priority, request.size);
                                                         data.transition = toTransition(transition->transition_type());
                                                         data.transitionValue = 1.F - (otime::RationalTime(time - range.start_time() + transition->in_offset()).value() + 1.0) /
                                                             (transition->in_offset().value() + transition->out_offset().value() + 1.0);
@@ -541,31 +598,67 @@ namespace tlr
                             }
                         }
                     }
-                    for (auto& j : result.layerData)
+                }
+                catch (const std::exception&)
+                {
+                    //! \todo How should this be handled?
+                }
+                results.push_back(std::move(result));
+            }
+
+            // Finish the requests that have all of their frames.
+            auto i = results.begin();
+            while (i != results.end())
+            {
+                bool ready = true;
+                for (const auto& j : i->layerData)
+                {
+                    if ((j.image.valid() && j.image.wait_for(std::chrono::seconds(0)) != std::future_status::ready) ||
+                        (j.imageB.valid() && j.imageB.wait_for(std::chrono::seconds(0)) != std::future_status::ready))
+                    {
+                        ready = false;
+                        break;
+                    }
+                }
+                if (ready)
+                {
+                    Frame frame;
+                    frame.time = i->time;
+                    try
                     {
-                        FrameLayer layer;
-                        layer.image = j.image.get().image;
-                        if (j.imageB.valid())
+                        for (auto& j : i->layerData)
                         {
-                            layer.imageB = j.imageB.get().image;
+                            FrameLayer layer;
+                            layer.image = j.image.get().image;
+                            if (j.imageB.valid())
+                            {
+                                layer.imageB = j.imageB.get().image;
+                            }
+                            layer.transition = j.transition;
+                            layer.transitionValue = j.transitionValue;
+                            frame.layers.push_back(layer);
                         }
-                        layer.transition = j.transition;
-                        layer.transitionValue = j.transitionValue;
-                        frame.layers.push_back(layer);
                     }
+                    catch (const std::exception&)
+                    {
+                        //! \todo How should this be handled?
+                    }
+                    i->promise.set_value(frame);
+                    i = results.erase(i);
                 }
-                catch (const std::exception&)
+                else
                 {
-                    //! \todo How should this be handled?
+                    ++i;
                 }
-                result.promise.set_value(frame);
             }
         }
 
         std::future<avio::VideoFrame> Timeline::Private::readVideoFrame(
             const otio::Track* track,
             const otio::Clip* clip,
-            const otime::RationalTime& time)
+            const otime::RationalTime& time,
+            int64_t priority,
+            const imaging::Size& size)
         {
             std::future<avio::VideoFrame> out;
 
@@ -603,7 +696,7 @@ namespace tlr
             {
                 const auto readTime = frameTime.rescaled_to(j->second.info.videoDuration);
                 const auto floorTime = otime::RationalTime(floor(readTime.value()), readTime.rate());
-                out = j->second.read->readVideoFrame(floorTime);
+                out = j->second.read->readVideoFrame(floorTime, priority, size);
             }
             else
             {
@@ -624,7 +717,7 @@ namespace tlr
                     reader.info = info;
                     const auto readTime = frameTime.rescaled_to(info.videoDuration);
                     const auto floorTime = otime::RationalTime(floor(readTime.value()), readTime.rate());
-                    out = read->readVideoFrame(floorTime);
+                    out = read->readVideoFrame(floorTime, priority, size);
                     readers[clip] = std::move(reader);
                 }
             }
@@ -634,6 +727,11 @@ namespace tlr
 
         void Timeline::Private::stopReaders()
         {
+            std::vector<otime::TimeRange> activeRanges;
+            {
+                std::unique_lock<std::mutex> lock(requestMutex);
+                activeRanges = this->activeRanges;
+            }
             auto i = readers.begin();
             while (i != readers.end())
             {
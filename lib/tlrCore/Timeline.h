@@ -22,6 +22,9 @@ namespace tlr
         //! Timeout for frame requests.
         const std::chrono::microseconds requestTimeout(1000);
 
+        //! Maximum number of frame requests in progress at the same time.
+        const std::size_t requestCount = 16;
+
         //! Get the timeline file extensions.
         std::vector<std::string> getExtensions();
 
@@ -72,6 +75,9 @@ namespace tlr
             bool operator != (const Frame&) const;
         };
 
+        //! Get the number of bytes used to store the frame images.
+        std::size_t getDataByteCount(const Frame&);
+
         //! Timeline.
         class Timeline : public std::enable_shared_from_this<Timeline>
         {
@@ -115,11 +121,18 @@ namespace tlr
             ///@{
 
             //! Set the active time ranges. This informs the timeline which
-            //! I/O readers to keep active.
+            //! I/O readers to keep active. Pending frame requests outside of
+            //! the active time ranges are dropped and return an empty frame.
             void setActiveRanges(const std::vector<otime::TimeRange>&);
 
-            //! Get a frame.
-            std::future<Frame> getFrame(const otime::RationalTime&);
+            //! Get a frame. Requests with a lower priority value are served
+            //! first, and requests with the same priority are served in the
+            //! order they were made. If a size is given the images may be
+            //! read at a reduced resolution, see avio::IRead::readVideoFrame().
+            std::future<Frame> getFrame(
+                const otime::RationalTime&,
+                int64_t priority = 0,
+                const imaging::Size& size = imaging::Size());
 
             //! Cancel frames.
             void cancelFrames();
@@ -17,6 +17,7 @@
 #include <Python.h>
 #endif
 
+#include <algorithm>
 #include <array>
 #include <iomanip>
 #include <iostream>
@@ -43,6 +44,9 @@ namespace tlr
             "FrameNextX100");
         TLR_ENUM_SERIALIZE_IMPL(TimeAction);
 
+        TLR_ENUM_IMPL(FrameCacheMode, "Frames", "Bytes");
+        TLR_ENUM_SERIALIZE_IMPL(FrameCacheMode);
+
         otime::RationalTime loopTime(const otime::RationalTime& time, const otime::TimeRange& range)
         {
             auto out = time;
@@ -64,18 +68,27 @@ namespace tlr
                 Forward,
                 Reverse
             };
+
+            // Frame requests made after a seek are given priority over the
+            // requests made before it.
+            const int64_t seekPriority = 1000000000;
         }
 
         struct TimelinePlayer::Private
         {
             otime::RationalTime loopPlayback(const otime::RationalTime&);
 
+            void frameCacheByteLimits(
+                std::size_t frameCacheMaxByteCount,
+                std::size_t& frameCacheReadAhead,
+                std::size_t& frameCacheReadBehind);
             void frameCacheUpdate(
                 const otime::RationalTime& currentTime,
                 const otime::TimeRange& inOutRange,
                 FrameCacheDirection,
                 std::size_t frameCacheReadAhead,
-                std::size_t frameCacheReadBehind);
+                std::size_t frameCacheReadBehind,
+                int64_t seekCount);
 
             std::shared_ptr<Timeline> timeline;
 
@@ -85,6 +98,7 @@ namespace tlr
             std::shared_ptr<observer::Value<otime::TimeRange> > inOutRange;
             std::shared_ptr<observer::Value<Frame> > frame;
             std::shared_ptr<observer::List<otime::TimeRange> > cachedFrames;
+            std::shared_ptr<observer::Value<std::size_t> > frameCacheByteCount;
             std::chrono::steady_clock::time_point startTime;
             otime::RationalTime playbackStartTime = time::invalidTime;
 
@@ -94,12 +108,16 @@ namespace tlr
                 otime::TimeRange inOutRange = time::invalidTimeRange;
                 Frame frame;
                 std::map<otime::RationalTime, std::future<Frame> > frameRequests;
-                bool clearFrameRequests = false;
+                int64_t frameRequestsSeekCount = 0;
+                int64_t seekCount = 0;
                 std::map<otime::RationalTime, Frame> frameCache;
                 std::vector<otime::TimeRange> cachedFrames;
+                std::size_t frameCacheByteCount = 0;
                 FrameCacheDirection frameCacheDirection = FrameCacheDirection::Forward;
                 std::size_t frameCacheReadAhead = 100;
                 std::size_t frameCacheReadBehind = 10;
+                FrameCacheMode frameCacheMode = FrameCacheMode::Frames;
+                std::size_t frameCacheMaxByteCount = 4 * memory::gigabyte;
                 std::mutex mutex;
                 std::atomic<bool> running;
             };
@@ -124,6 +142,7 @@ namespace tlr
                 otime::TimeRange(p.timeline->getGlobalStartTime(), p.timeline->getDuration()));
             p.frame = observer::Value<Frame>::create();
             p.cachedFrames = observer::List<otime::TimeRange>::create();
+            p.frameCacheByteCount = observer::Value<std::size_t>::create(0);
 
             // Create a new thread.
             p.threadData.currentTime = p.currentTime->get();
@@ -138,26 +157,31 @@ namespace tlr
                     {
                         otime::RationalTime currentTime = time::invalidTime;
                         otime::TimeRange inOutRange = time::invalidTimeRange;
-                        bool clearFrameRequests = false;
+                        int64_t seekCount = 0;
                         FrameCacheDirection frameCacheDirection = FrameCacheDirection::Forward;
                         std::size_t frameCacheReadAhead = 0;
                         std::size_t frameCacheReadBehind = 0;
+                        FrameCacheMode frameCacheMode = FrameCacheMode::Frames;
+                        std::size_t frameCacheMaxByteCount = 0;
                         {
                             std::unique_lock<std::mutex> lock(p.threadData.mutex);
                             currentTime = p.threadData.currentTime;
                             inOutRange = p.threadData.inOutRange;
-                            clearFrameRequests = p.threadData.clearFrameRequests;
-                            p.threadData.clearFrameRequests = false;
+                            seekCount = p.threadData.seekCount;
                             frameCacheDirection = p.threadData.frameCacheDirection;
                             frameCacheReadAhead = p.threadData.frameCacheReadAhead;
                             frameCacheReadBehind = p.threadData.frameCacheReadBehind;
+                            frameCacheMode = p.threadData.frameCacheMode;
+                            frameCacheMaxByteCount = p.threadData.frameCacheMaxByteCount;
                         }
 
-                        //! Clear frame requests.
-                        if (clearFrameRequests)
+                        //! Convert the byte limit to read ahead and read behind.
+                        if (FrameCacheMode::Bytes == frameCacheMode)
                         {
-                            p.timeline->cancelFrames();
-                            p.threadData.frameRequests.clear();
+                            p.frameCacheByteLimits(
+                                frameCacheMaxByteCount,
+                                frameCacheReadAhead,
+                                frameCacheReadBehind);
                         }
 
                         //! Update the frame cache.
@@ -166,7 +190,8 @@ namespace tlr
                             inOutRange,
                             frameCacheDirection,
                             frameCacheReadAhead,
-                            frameCacheReadBehind);
+                            frameCacheReadBehind,
+                            seekCount);
 
                         //! Update the frame.
                         const auto i = p.threadData.frameCache.find(currentTime);
@@ -327,7 +352,7 @@ namespace tlr
                 {
                     std::unique_lock<std::mutex> lock(p.threadData.mutex);
                     p.threadData.currentTime = tmp;
-                    p.threadData.clearFrameRequests = true;
+                    ++p.threadData.seekCount;
                 }
             }
         }
@@ -468,6 +493,39 @@ namespace tlr
             p.threadData.frameCacheReadBehind = value;
         }
 
+        FrameCacheMode TimelinePlayer::getFrameCacheMode()
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.threadData.mutex);
+            return p.threadData.frameCacheMode;
+        }
+
+        void TimelinePlayer::setFrameCacheMode(FrameCacheMode value)
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.threadData.mutex);
+            p.threadData.frameCacheMode = value;
+        }
+
+        std::size_t TimelinePlayer::getFrameCacheMaxByteCount()
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.threadData.mutex);
+            return p.threadData.frameCacheMaxByteCount;
+        }
+
+        void TimelinePlayer::setFrameCacheMaxByteCount(std::size_t value)
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.threadData.mutex);
+            p.threadData.frameCacheMaxByteCount = value;
+        }
+
+        std::shared_ptr<observer::IValue<std::size_t> > TimelinePlayer::observeFrameCacheByteCount() const
+        {
+            return _p->frameCacheByteCount;
+        }
+
         std::shared_ptr<observer::IList<otime::TimeRange> > TimelinePlayer::observeCachedFrames() const
         {
             return _p->cachedFrames;
@@ -496,14 +554,17 @@ namespace tlr
             // Sync with the thread.
             Frame frame;
             std::vector<otime::TimeRange> cachedFrames;
+            std::size_t frameCacheByteCount = 0;
             {
                 std::unique_lock<std::mutex> lock(p.threadData.mutex);
                 p.threadData.currentTime = p.currentTime->get();
                 frame = p.threadData.frame;
                 cachedFrames = p.threadData.cachedFrames;
+                frameCacheByteCount = p.threadData.frameCacheByteCount;
             }
             p.frame->setIfChanged(frame);
             p.cachedFrames->setIfChanged(cachedFrames);
+            p.frameCacheByteCount->setIfChanged(frameCacheByteCount);
         }
 
         otime::RationalTime TimelinePlayer::Private::loopPlayback(const otime::RationalTime& time)
@@ -561,19 +622,57 @@ namespace tlr
             return out;
         }
 
+        void TimelinePlayer::Private::frameCacheByteLimits(
+            std::size_t frameCacheMaxByteCount,
+            std::size_t& frameCacheReadAhead,
+            std::size_t& frameCacheReadBehind)
+        {
+            // Estimate the size of a frame from the cached frames, or from
+            // the timeline image information if nothing is cached yet.
+            std::size_t frameByteCount = 0;
+            if (!threadData.frameCache.empty())
+            {
+                for (const auto& i : threadData.frameCache)
+                {
+                    frameByteCount += getDataByteCount(i.second);
+                }
+                frameByteCount /= threadData.frameCache.size();
+            }
+            if (0 == frameByteCount)
+            {
+                frameByteCount = imaging::getDataByteCount(timeline->getImageInfo());
+            }
+            const std::size_t frameCount = frameByteCount > 0 ?
+                std::max(frameCacheMaxByteCount / frameByteCount, static_cast<std::size_t>(1)) :
+                frameCacheReadAhead + frameCacheReadBehind;
+
+            // Split the frames between read ahead and read behind.
+            const std::size_t total = frameCacheReadAhead + frameCacheReadBehind;
+            const std::size_t readAhead = total > 0 ?
+                std::max(frameCount * frameCacheReadAhead / total, static_cast<std::size_t>(1)) :
+                frameCount;
+            frameCacheReadAhead = std::min(readAhead, frameCount);
+            frameCacheReadBehind = frameCount - frameCacheReadAhead;
+        }
+
         void TimelinePlayer::Private::frameCacheUpdate(
             const otime::RationalTime& currentTime,
             const otime::TimeRange& inOutRange,
             FrameCacheDirection frameCacheDirection,
             std::size_t frameCacheReadAhead,
-            std::size_t frameCacheReadBehind)
+            std::size_t frameCacheReadBehind,
+            int64_t seekCount)
         {
-            // Get which frames should be cached.
+            // Get which frames should be cached, and their priority. Frames
+            // ahead of the current time in the playback direction come
+            // first, nearest first, followed by the frames behind.
             std::vector<otime::RationalTime> frames;
+            std::vector<int64_t> priorities;
             const auto& duration = timeline->getDuration();
             auto time = currentTime;
             const auto& range = inOutRange;
-            for (std::size_t i = 0; i < (FrameCacheDirection::Forward == frameCacheDirection ? frameCacheReadBehind : frameCacheReadAhead); ++i)
+            const std::size_t back = FrameCacheDirection::Forward == frameCacheDirection ? frameCacheReadBehind : frameCacheReadAhead;
+            for (std::size_t i = 0; i < back; ++i)
             {
                 time = loopTime(time - otime::RationalTime(1, duration.rate()), range);
             }
@@ -584,11 +683,58 @@ namespace tlr
                     break;
                 }
                 frames.push_back(time);
+                const int64_t offset = static_cast<int64_t>(i) - static_cast<int64_t>(back);
+                int64_t distance = 0;
+                if (FrameCacheDirection::Forward == frameCacheDirection)
+                {
+                    distance = offset >= 0 ? offset : (frameCacheReadAhead - offset);
+                }
+                else
+                {
+                    distance = offset <= 0 ? -offset : (frameCacheReadAhead + offset);
+                }
+                priorities.push_back(distance - seekCount * seekPriority);
                 time = loopTime(time + otime::RationalTime(1, duration.rate()), range);
             }
             const auto ranges = toRanges(frames);
             timeline->setActiveRanges(ranges);
 
+            // After a seek the pending requests are cancelled, and the frames
+            // that are still needed are requested again with their new
+            // priorities. Otherwise the frames that were requested before
+            // the seek, like the frame under the playhead, would be served
+            // after all of the new requests. Frames that are already being
+            // read finish in the I/O cache.
+            if (seekCount != threadData.frameRequestsSeekCount)
+            {
+                threadData.frameRequestsSeekCount = seekCount;
+                timeline->cancelFrames();
+                threadData.frameRequests.clear();
+            }
+
+            // Remove requests for frames that are no longer needed.
+            auto frameRequestsIt = threadData.frameRequests.begin();
+            while (frameRequestsIt != threadData.frameRequests.end())
+            {
+                bool old = true;
+                for (const auto& i : ranges)
+                {
+                    if (i.contains(frameRequestsIt->first))
+                    {
+                        old = false;
+                        break;
+                    }
+                }
+                if (old)
+                {
+                    frameRequestsIt = threadData.frameRequests.erase(frameRequestsIt);
+                }
+                else
+                {
+                    ++frameRequestsIt;
+                }
+            }
+
             // Remove old frames from the cache.
             auto frameCacheIt = threadData.frameCache.begin();
             while (frameCacheIt != threadData.frameCache.end())
@@ -612,26 +758,19 @@ namespace tlr
                 }
             }
 
-            // Find uncached frames.
-            std::vector<otime::RationalTime> uncached;
-            for (const auto& i : frames)
+            // Get uncached frames.
+            for (std::size_t i = 0; i < frames.size(); ++i)
             {
-                const auto j = threadData.frameCache.find(i);
+                const auto j = threadData.frameCache.find(frames[i]);
                 if (j == threadData.frameCache.end())
                 {
-                    const auto k = threadData.frameRequests.find(i);
+                    const auto k = threadData.frameRequests.find(frames[i]);
                     if (k == threadData.frameRequests.end())
                     {
-                        uncached.push_back(i);
+                        threadData.frameRequests[frames[i]] = timeline->getFrame(frames[i], priorities[i]);
                     }
                 }
             }
-
-            // Get uncached frames.
-            for (const auto& i : uncached)
-            {
-                threadData.frameRequests[i] = timeline->getFrame(i);
-            }
             auto framesIt = threadData.frameRequests.begin();
             while (framesIt != threadData.frameRequests.end())
             {
@@ -651,13 +790,16 @@ namespace tlr
 
             // Update cached frames.
             std::vector<otime::RationalTime> cachedFrames;
+            std::size_t frameCacheByteCount = 0;
             for (const auto& i : threadData.frameCache)
             {
                 cachedFrames.push_back(i.second.time);
+                frameCacheByteCount += getDataByteCount(i.second);
             }
             {
                 std::unique_lock<std::mutex> lock(threadData.mutex);
                 threadData.cachedFrames = toRanges(cachedFrames);
+                threadData.frameCacheByteCount = frameCacheByteCount;
             }
         }
     }
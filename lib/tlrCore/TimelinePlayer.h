@@ -57,6 +57,18 @@ namespace tlr
         TLR_ENUM(TimeAction);
         TLR_ENUM_SERIALIZE(TimeAction);
 
+        //! Frame cache modes.
+        enum class FrameCacheMode
+        {
+            Frames, //!< Limit the cache by the number of frames
+            Bytes,  //!< Limit the cache by the number of bytes
+
+            Count,
+            First = Frames
+        };
+        TLR_ENUM(FrameCacheMode);
+        TLR_ENUM_SERIALIZE(FrameCacheMode);
+
         //! Loop time.
         otime::RationalTime loopTime(const otime::RationalTime&, const otime::TimeRange&);
 
@@ -183,6 +195,24 @@ namespace tlr
             //! Set the frame cache read behind.
             void setFrameCacheReadBehind(int);
 
+            //! Get the frame cache mode.
+            FrameCacheMode getFrameCacheMode();
+
+            //! Set the frame cache mode.
+            void setFrameCacheMode(FrameCacheMode);
+
+            //! Get the frame cache maximum number of bytes.
+            std::size_t getFrameCacheMaxByteCount();
+
+            //! Set the frame cache maximum number of bytes. This is only used
+            //! with FrameCacheMode::Bytes, where the number of frames that
+            //! fit is split between read ahead and read behind with the same
+            //! ratio as the read ahead and read behind settings.
+            void setFrameCacheMaxByteCount(std::size_t);
+
+            //! Observe the number of bytes used by the frame cache.
+            std::shared_ptr<observer::IValue<std::size_t> > observeFrameCacheByteCount() const;
+
             //! Observe the cached frames.
             std::shared_ptr<observer::IList<otime::TimeRange> > observeCachedFrames() const;
 
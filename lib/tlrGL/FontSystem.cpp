@@ -48,6 +48,11 @@ namespace tlr
             fontInfo(fontInfo)
         {}
 
+        bool GlyphInfo::operator == (const GlyphInfo& other) const noexcept
+        {
+            return code == other.code && fontInfo == other.fontInfo;
+        }
+
         bool GlyphInfo::operator < (const GlyphInfo& other) const
         {
             return std::tie(code, fontInfo) < std::tie(other.code, other.fontInfo);
@@ -369,3 +374,20 @@ namespace tlr
         }
     }
 }
+
+namespace std
+{
+    std::size_t hash<tlr::gl::FontInfo>::operator() (const tlr::gl::FontInfo& value) const noexcept
+    {
+        return
+            std::hash<int>()(static_cast<int>(value.family)) ^
+            (std::hash<uint16_t>()(value.size) << 1);
+    }
+
+    std::size_t hash<tlr::gl::GlyphInfo>::operator() (const tlr::gl::GlyphInfo& value) const noexcept
+    {
+        return
+            std::hash<uint32_t>()(value.code) ^
+            (std::hash<tlr::gl::FontInfo>()(value.fontInfo) << 1);
+    }
+}
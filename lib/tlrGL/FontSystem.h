@@ -7,6 +7,7 @@
 #include <tlrCore/BBox.h>
 #include <tlrCore/Util.h>
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -135,3 +136,18 @@ namespace tlr
         };
     }
 }
+
+namespace std
+{
+    template<>
+    struct hash<tlr::gl::FontInfo>
+    {
+        std::size_t operator() (const tlr::gl::FontInfo&) const noexcept;
+    };
+
+    template<>
+    struct hash<tlr::gl::GlyphInfo>
+    {
+        std::size_t operator() (const tlr::gl::GlyphInfo&) const noexcept;
+    };
+}
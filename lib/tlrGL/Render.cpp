@@ -121,7 +121,27 @@ namespace tlr
                 "const uint PixelType_RGBA_F16 = 20;\n"
                 "const uint PixelType_RGBA_F32 = 21;\n"
                 "const uint PixelType_YUV_420P = 22;\n"
+                "const uint PixelType_YUV_422P = 23;\n"
+                "const uint PixelType_YUV_444P = 24;\n"
+                "const uint PixelType_YUV_420P_U10 = 25;\n"
+                "const uint PixelType_YUV_422P_U10 = 26;\n"
+                "const uint PixelType_YUV_444P_U10 = 27;\n"
+                "const uint PixelType_YUV_420P_U16 = 28;\n"
+                "const uint PixelType_YUV_422P_U16 = 29;\n"
+                "const uint PixelType_YUV_444P_U16 = 30;\n"
                 "uniform int pixelType;\n"
+                "\n"
+                "// tlr::imaging::YUVRange\n"
+                "const uint YUVRange_Full    = 0;\n"
+                "const uint YUVRange_Limited = 1;\n"
+                "uniform int yuvRange;\n"
+                "\n"
+                "// tlr::imaging::YUVCoefficients\n"
+                "const uint YUVCoefficients_BT601  = 0;\n"
+                "const uint YUVCoefficients_BT709  = 1;\n"
+                "const uint YUVCoefficients_BT2020 = 2;\n"
+                "uniform int yuvCoefficients;\n"
+                "\n"
                 "uniform sampler2D textureSampler0;\n"
                 "uniform sampler2D textureSampler1;\n"
                 "uniform sampler2D textureSampler2;\n"
@@ -131,14 +151,52 @@ namespace tlr
                 "vec4 sampleTexture(sampler2D s0, sampler2D s1, sampler2D s2)\n"
                 "{\n"
                 "    vec4 c;\n"
-                "    if (PixelType_YUV_420P == pixelType)\n"
+                "    if (pixelType >= PixelType_YUV_420P && pixelType <= PixelType_YUV_444P_U16)\n"
                 "    {\n"
-                "        float y = texture(s0, fTexture).r;\n"
-                "        float u = texture(s1, fTexture).r - 0.5;\n"
-                "        float v = texture(s2, fTexture).r - 0.5;\n"
-                "        c.r = y + 1.402 * v;\n"
-                "        c.g = y - 0.344 * u - 0.714 * v;\n"
-                "        c.b = y + 1.772 * u;\n"
+                "        // The chroma planes are upsampled by the texture\n"
+                "        // filtering. 10-bit samples are stored in 16-bit\n"
+                "        // textures.\n"
+                "        float scale = 1.0;\n"
+                "        float maxValue = 255.0;\n"
+                "        if (pixelType >= PixelType_YUV_420P_U10 && pixelType <= PixelType_YUV_444P_U10)\n"
+                "        {\n"
+                "            scale = 65535.0 / 1023.0;\n"
+                "            maxValue = 1023.0;\n"
+                "        }\n"
+                "        else if (pixelType >= PixelType_YUV_420P_U16 && pixelType <= PixelType_YUV_444P_U16)\n"
+                "        {\n"
+                "            maxValue = 65535.0;\n"
+                "        }\n"
+                "        float y = texture(s0, fTexture).r * scale;\n"
+                "        float u = texture(s1, fTexture).r * scale;\n"
+                "        float v = texture(s2, fTexture).r * scale;\n"
+                "\n"
+                "        // The range values are defined for 8-bit samples and\n"
+                "        // shifted to the sample bit depth.\n"
+                "        float bitScale = (maxValue + 1.0) / (256.0 * maxValue);\n"
+                "        u -= 128.0 * bitScale;\n"
+                "        v -= 128.0 * bitScale;\n"
+                "        if (YUVRange_Limited == yuvRange)\n"
+                "        {\n"
+                "            y = (y - 16.0 * bitScale) / (219.0 * bitScale);\n"
+                "            u /= 224.0 * bitScale;\n"
+                "            v /= 224.0 * bitScale;\n"
+                "        }\n"
+                "\n"
+                "        // Coefficients for red from V, green from U and V,\n"
+                "        // and blue from U.\n"
+                "        vec4 k = vec4(1.402, 0.344136, 0.714136, 1.772);\n"
+                "        if (YUVCoefficients_BT709 == yuvCoefficients)\n"
+                "        {\n"
+                "            k = vec4(1.5748, 0.187324, 0.468124, 1.8556);\n"
+                "        }\n"
+                "        else if (YUVCoefficients_BT2020 == yuvCoefficients)\n"
+                "        {\n"
+                "            k = vec4(1.4746, 0.164553, 0.571353, 1.8814);\n"
+                "        }\n"
+                "        c.r = y + k.x * v;\n"
+                "        c.g = y - k.y * u - k.z * v;\n"
+                "        c.b = y + k.w * u;\n"
                 "        c.a = 1.0;\n"
                 "    }\n"
                 "    else\n"
@@ -480,27 +538,28 @@ namespace tlr
                 switch (info.pixelType)
                 {
                 case imaging::PixelType::YUV_420P:
+                case imaging::PixelType::YUV_422P:
+                case imaging::PixelType::YUV_444P:
+                case imaging::PixelType::YUV_420P_U10:
+                case imaging::PixelType::YUV_422P_U10:
+                case imaging::PixelType::YUV_444P_U10:
+                case imaging::PixelType::YUV_420P_U16:
+                case imaging::PixelType::YUV_422P_U16:
+                case imaging::PixelType::YUV_444P_U16:
                 {
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + offset));
-                    auto infoTmp = imaging::Info(info.size, imaging::PixelType::L_U8);
-                    auto texture = Texture::create(infoTmp);
-                    texture->copy(image->getData(), infoTmp);
-                    out.push_back(texture);
-
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 1 + offset));
-                    const std::size_t w = info.size.w;
-                    const std::size_t h = info.size.h;
-                    const std::size_t w2 = w / 2;
-                    const std::size_t h2 = h / 2;
-                    infoTmp = imaging::Info(imaging::Size(w2, h2), imaging::PixelType::L_U8);
-                    texture = Texture::create(infoTmp);
-                    texture->copy(image->getData() + (w * h), infoTmp);
-                    out.push_back(texture);
-
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 2 + offset));
-                    texture = Texture::create(infoTmp);
-                    texture->copy(image->getData() + (w * h) + (w2 * h2), infoTmp);
-                    out.push_back(texture);
+                    // Each plane is copied to a separate texture.
+                    const imaging::PixelType planeType = imaging::getBitDepth(info.pixelType) > 8 ?
+                        imaging::PixelType::L_U16 :
+                        imaging::PixelType::L_U8;
+                    for (uint8_t i = 0; i < image->getPlaneCount(); ++i)
+                    {
+                        glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + i + offset));
+                        auto infoTmp = imaging::Info(imaging::getPlaneSize(info, i), planeType);
+                        infoTmp.layout.endian = info.layout.endian;
+                        auto texture = Texture::create(infoTmp);
+                        texture->copy(image->getPlaneData(i), infoTmp, image->getPlaneStride(i));
+                        out.push_back(texture);
+                    }
                     break;
                 }
                 default:
@@ -527,6 +586,8 @@ namespace tlr
             p.shader->setUniform("colorMode", static_cast<int>(ColorMode::TextureColorConfig));
             p.shader->setUniform("color", color);
             p.shader->setUniform("pixelType", static_cast<int>(info.pixelType));
+            p.shader->setUniform("yuvRange", static_cast<int>(info.yuvRange));
+            p.shader->setUniform("yuvCoefficients", static_cast<int>(info.yuvCoefficients));
             p.shader->setUniform("textureSampler0", 0);
             p.shader->setUniform("textureSampler1", 1);
             p.shader->setUniform("textureSampler2", 2);
@@ -44,6 +44,14 @@ namespace tlr
                 GL_RGBA,
                 GL_RGBA,
 
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
                 GL_NONE
             };
             return data[static_cast<std::size_t>(value)];
@@ -80,6 +88,14 @@ namespace tlr
                 GL_RGBA16F,
                 GL_RGBA32F,
 
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
                 GL_NONE
             };
             return data[static_cast<std::size_t>(type)];
@@ -116,11 +132,95 @@ namespace tlr
                 GL_HALF_FLOAT,
                 GL_FLOAT,
 
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
                 GL_NONE
             };
             return data[static_cast<std::size_t>(value)];
         }
 
+        namespace
+        {
+            void texSubImage(
+                const uint8_t* data,
+                const imaging::Info& info,
+                size_t stride,
+                uint16_t x,
+                uint16_t y)
+            {
+                // Rows with padding are skipped over with the row length,
+                // which is in pixels, and the alignment. Rows that cannot be
+                // described that way are copied one at a time.
+                GLint alignment = info.layout.alignment;
+                GLint rowLength = 0;
+                bool rows = false;
+                const size_t pixelByteCount = imaging::getDataByteCount(imaging::Info(1, 1, info.pixelType));
+                if (stride > 0 && pixelByteCount > 0 && stride != imaging::getPlaneRowByteCount(info, 0))
+                {
+                    const size_t length = stride / pixelByteCount;
+                    if (0 == stride % pixelByteCount)
+                    {
+                        alignment = 1;
+                        rowLength = static_cast<GLint>(length);
+                    }
+                    else
+                    {
+                        rows = true;
+                        for (GLint i : { 8, 4, 2 })
+                        {
+                            if (0 == stride % i && stride - length * pixelByteCount < static_cast<size_t>(i))
+                            {
+                                alignment = i;
+                                rowLength = static_cast<GLint>(length);
+                                rows = false;
+                                break;
+                            }
+                        }
+                    }
+                }
+
+                glPixelStorei(GL_UNPACK_ALIGNMENT, rows ? 1 : alignment);
+                glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength);
+                glPixelStorei(GL_UNPACK_SWAP_BYTES, info.layout.endian != memory::getEndian() ? GL_TRUE : GL_FALSE);
+                if (rows)
+                {
+                    for (uint16_t i = 0; i < info.size.h; ++i)
+                    {
+                        glTexSubImage2D(
+                            GL_TEXTURE_2D,
+                            0,
+                            x,
+                            y + i,
+                            info.size.w,
+                            1,
+                            getTextureFormat(info.pixelType),
+                            getTextureType(info.pixelType),
+                            data + i * stride);
+                    }
+                }
+                else
+                {
+                    glTexSubImage2D(
+                        GL_TEXTURE_2D,
+                        0,
+                        x,
+                        y,
+                        info.size.w,
+                        info.size.h,
+                        getTextureFormat(info.pixelType),
+                        getTextureType(info.pixelType),
+                        data);
+                }
+                glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+            }
+        }
+
         void Texture::_init(const imaging::Info& info, GLenum filterMin, GLenum filterMag)
         {
             _info = info;
@@ -209,64 +309,20 @@ namespace tlr
 
         void Texture::copy(const imaging::Image& data)
         {
-            const auto& info = data.getInfo();
             glBindTexture(GL_TEXTURE_2D, _id);
-            glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
-            if (info.layout.endian != memory::getEndian())
-            {
-                glPixelStorei(GL_UNPACK_SWAP_BYTES, GL_TRUE);
-            }
-            glTexSubImage2D(
-                GL_TEXTURE_2D,
-                0,
-                0,
-                0,
-                info.size.w,
-                info.size.h,
-                getTextureFormat(info.pixelType),
-                getTextureType(info.pixelType),
-                data.getData());
+            texSubImage(data.getData(), data.getInfo(), data.getPlaneStride(0), 0, 0);
         }
 
-        void Texture::copy(const uint8_t* data, const imaging::Info& info)
+        void Texture::copy(const uint8_t* data, const imaging::Info& info, size_t stride)
         {
             glBindTexture(GL_TEXTURE_2D, _id);
-            glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
-            if (info.layout.endian != memory::getEndian())
-            {
-                glPixelStorei(GL_UNPACK_SWAP_BYTES, GL_TRUE);
-            }
-            glTexSubImage2D(
-                GL_TEXTURE_2D,
-                0,
-                0,
-                0,
-                info.size.w,
-                info.size.h,
-                getTextureFormat(info.pixelType),
-                getTextureType(info.pixelType),
-                data);
+            texSubImage(data, info, stride, 0, 0);
         }
 
         void Texture::copy(const imaging::Image& data, uint16_t x, uint16_t y)
         {
-            const auto& info = data.getInfo();
             glBindTexture(GL_TEXTURE_2D, _id);
-            glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
-            if (info.layout.endian != memory::getEndian())
-            {
-                glPixelStorei(GL_UNPACK_SWAP_BYTES, GL_TRUE);
-            }
-            glTexSubImage2D(
-                GL_TEXTURE_2D,
-                0,
-                x,
-                y,
-                info.size.w,
-                info.size.h,
-                getTextureFormat(info.pixelType),
-                getTextureType(info.pixelType),
-                data.getData());
+            texSubImage(data.getData(), data.getInfo(), data.getPlaneStride(0), x, y);
         }
 
         void Texture::bind()
@@ -52,11 +52,12 @@ namespace tlr
             void set(const imaging::Info&);
 
             //! \name Copy
-            //! Copy image data to the texture.
+            //! Copy image data to the texture. The stride is the number of
+            //! bytes between rows, or zero if the rows are tightly packed.
             ///@{
 
             void copy(const imaging::Image&);
-            void copy(const uint8_t*, const imaging::Info&);
+            void copy(const uint8_t*, const imaging::Info&, size_t stride = 0);
             void copy(const imaging::Image&, uint16_t x, uint16_t y);
 
             ///@}
@@ -44,6 +44,14 @@ namespace tlr
                 GL_RGBA,
                 GL_RGBA,
 
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
                 GL_NONE
             };
             return data[static_cast<std::size_t>(value)];
@@ -80,6 +88,14 @@ namespace tlr
                 GL_HALF_FLOAT,
                 GL_FLOAT,
 
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
                 GL_NONE
             };
             return data[static_cast<std::size_t>(value)];
@@ -18,6 +18,7 @@ namespace tlr
             std::shared_ptr<observer::ValueObserver<otime::TimeRange> > inOutRangeObserver;
             std::shared_ptr<observer::ValueObserver<timeline::Frame> > frameObserver;
             std::shared_ptr<observer::ListObserver<otime::TimeRange> > cachedFramesObserver;
+            std::shared_ptr<observer::ValueObserver<std::size_t> > frameCacheByteCountObserver;
         };
 
         TimelinePlayer::TimelinePlayer(
@@ -73,6 +74,13 @@ namespace tlr
                     Q_EMIT cachedFramesChanged(value);
                 });
 
+            p.frameCacheByteCountObserver = observer::ValueObserver<std::size_t>::create(
+                p.timelinePlayer->observeFrameCacheByteCount(),
+                [this](std::size_t value)
+                {
+                    Q_EMIT frameCacheByteCountChanged(value);
+                });
+
             startTimer(playerTimerInterval, Qt::PreciseTimer);
         }
 
@@ -126,6 +134,21 @@ namespace tlr
             return _p->timelinePlayer->observeFrame()->get();
         }
 
+        timeline::FrameCacheMode TimelinePlayer::frameCacheMode()
+        {
+            return _p->timelinePlayer->getFrameCacheMode();
+        }
+
+        std::size_t TimelinePlayer::frameCacheMaxByteCount()
+        {
+            return _p->timelinePlayer->getFrameCacheMaxByteCount();
+        }
+
+        std::size_t TimelinePlayer::frameCacheByteCount() const
+        {
+            return _p->timelinePlayer->observeFrameCacheByteCount()->get();
+        }
+
         const std::vector<otime::TimeRange>& TimelinePlayer::cachedFrames() const
         {
             return _p->timelinePlayer->observeCachedFrames()->get();
@@ -229,6 +252,16 @@ namespace tlr
             _p->timelinePlayer->setFrameCacheReadBehind(value);
         }
 
+        void TimelinePlayer::setFrameCacheMode(timeline::FrameCacheMode value)
+        {
+            _p->timelinePlayer->setFrameCacheMode(value);
+        }
+
+        void TimelinePlayer::setFrameCacheMaxByteCount(std::size_t value)
+        {
+            _p->timelinePlayer->setFrameCacheMaxByteCount(value);
+        }
+
         void TimelinePlayer::timerEvent(QTimerEvent*)
         {
             _p->timelinePlayer->tick();
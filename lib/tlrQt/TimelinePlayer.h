@@ -85,6 +85,15 @@ namespace tlr
             //! Get the frame cache read behind.
             int frameCacheReadBehind();
 
+            //! Get the frame cache mode.
+            timeline::FrameCacheMode frameCacheMode();
+
+            //! Get the frame cache maximum number of bytes.
+            std::size_t frameCacheMaxByteCount();
+
+            //! Get the number of bytes used by the frame cache.
+            std::size_t frameCacheByteCount() const;
+
             //! Get the cached frames.
             const std::vector<otime::TimeRange>& cachedFrames() const;
 
@@ -166,6 +175,12 @@ namespace tlr
             //! Set the frame cache read behind.
             void setFrameCacheReadBehind(int);
 
+            //! Set the frame cache mode.
+            void setFrameCacheMode(tlr::timeline::FrameCacheMode);
+
+            //! Set the frame cache maximum number of bytes.
+            void setFrameCacheMaxByteCount(std::size_t);
+
             ///@}
 
         Q_SIGNALS:
@@ -195,6 +210,10 @@ namespace tlr
             //! This signal is emitted when the cached frames are changed.
             void cachedFramesChanged(const std::vector<otime::TimeRange>&);
 
+            //! This signal is emitted when the number of bytes used by the
+            //! frame cache is changed.
+            void frameCacheByteCountChanged(std::size_t);
+
             ///@}
 
         protected:
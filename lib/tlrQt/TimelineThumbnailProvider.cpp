@@ -172,7 +172,12 @@ namespace tlr
                         p.timeline->getGlobalStartTime() + request.time,
                         otime::RationalTime(1.0, request.time.rate())) });
                     
-                    const auto frame = p.timeline->getFrame(request.time).get();
+                    // Read the frame at a reduced resolution for the
+                    // thumbnail size.
+                    const auto frame = p.timeline->getFrame(
+                        request.time,
+                        0,
+                        imaging::Size(request.size.width(), request.size.height())).get();
 
                     const imaging::Info info(request.size.width(), request.size.height(), imaging::PixelType::RGBA_U8);
                     if (info != fboInfo)
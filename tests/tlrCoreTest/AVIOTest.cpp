@@ -6,8 +6,11 @@
 
 #include <tlrCore/AVIOSystem.h>
 #include <tlrCore/Assert.h>
+#include <tlrCore/SequenceIO.h>
 #include <tlrCore/StringFormat.h>
 
+#include <condition_variable>
+#include <mutex>
 #include <sstream>
 
 using namespace tlr::avio;
@@ -28,7 +31,9 @@ namespace tlr
         void AVIOTest::run()
         {
             _videoFrame();
+            _cache();
             _ioSystem();
+            _priority();
         }
 
         void AVIOTest::_videoFrame()
@@ -57,6 +62,51 @@ namespace tlr
             }
         }
 
+        void AVIOTest::_cache()
+        {
+            {
+                const CacheKey a("file.0001.exr", 1);
+                TLR_ASSERT(imaging::PixelType::None == a.pixelType);
+                CacheKey b("file.0001.exr", 1);
+                TLR_ASSERT(a == b);
+                TLR_ASSERT(std::hash<CacheKey>()(a) == std::hash<CacheKey>()(b));
+                b.frame = 2;
+                TLR_ASSERT(a != b);
+                b.frame = 1;
+                b.pixelType = imaging::PixelType::RGBA_U8;
+                TLR_ASSERT(a != b);
+            }
+            {
+                const imaging::Info info(16, 16, imaging::PixelType::L_U8);
+                const std::size_t byteCount = imaging::getDataByteCount(info);
+                auto cache = Cache::create();
+                TLR_ASSERT(cacheMaxByteCount == cache->getMax());
+                cache->setMax(byteCount * 2);
+                for (int i = 0; i < 3; ++i)
+                {
+                    const otime::RationalTime time(i, 24.0);
+                    cache->add(CacheKey("file.exr", i), VideoFrame(time, imaging::Image::create(info)));
+                }
+                TLR_ASSERT(byteCount * 2 == cache->getSize());
+                TLR_ASSERT(2 == cache->getCount());
+                TLR_ASSERT(!cache->contains(CacheKey("file.exr", 0)));
+                VideoFrame videoFrame;
+                TLR_ASSERT(cache->get(CacheKey("file.exr", 2), videoFrame));
+                TLR_ASSERT(otime::RationalTime(2.0, 24.0) == videoFrame.time);
+                TLR_ASSERT(videoFrame.image);
+                cache->add(CacheKey("file.exr", 3), VideoFrame());
+                TLR_ASSERT(!cache->contains(CacheKey("file.exr", 3)));
+                cache->remove(CacheKey("file.exr", 2));
+                TLR_ASSERT(1 == cache->getCount());
+                cache->clear();
+                TLR_ASSERT(0 == cache->getSize());
+            }
+            {
+                auto system = _context->getSystem<System>();
+                TLR_ASSERT(system->getCache());
+            }
+        }
+
         void AVIOTest::_ioSystem()
         {
             auto system = _context->getSystem<System>();
@@ -69,5 +119,132 @@ namespace tlr
             TLR_ASSERT(!system->read(file::Path()));
             TLR_ASSERT(!system->write(file::Path(), Info()));
         }
+
+        namespace
+        {
+            //! Reader that records the order the frames are read in, and
+            //! blocks the reads until it is released.
+            class PriorityRead : public ISequenceRead
+            {
+            protected:
+                PriorityRead()
+                {}
+
+            public:
+                ~PriorityRead() override
+                {
+                    release();
+                    _finish();
+                }
+
+                static std::shared_ptr<PriorityRead> create(
+                    const file::Path& path,
+                    const Options& options,
+                    const std::shared_ptr<core::LogSystem>& logSystem)
+                {
+                    auto out = std::shared_ptr<PriorityRead>(new PriorityRead);
+                    out->_init(path, options, nullptr, nullptr, logSystem);
+                    return out;
+                }
+
+                void waitForReads(size_t count)
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _cv.wait(
+                        lock,
+                        [this, count]
+                        {
+                            return _reads.size() >= count;
+                        });
+                }
+
+                void release()
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _released = true;
+                    _cv.notify_all();
+                }
+
+                std::vector<otime::RationalTime> getReads()
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    return _reads;
+                }
+
+            protected:
+                Info _getInfo(const std::string&) override
+                {
+                    Info out;
+                    out.video.push_back(imaging::Info(16, 16, imaging::PixelType::L_U8));
+                    out.videoDuration = otime::RationalTime(24.0, 24.0);
+                    return out;
+                }
+
+                VideoFrame _readVideoFrame(
+                    const std::string&,
+                    const otime::RationalTime& time,
+                    uint16_t) override
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _reads.push_back(time);
+                    _cv.notify_all();
+                    _cv.wait(
+                        lock,
+                        [this]
+                        {
+                            return _released;
+                        });
+                    return VideoFrame(time, imaging::Image::create(imaging::Info(16, 16, imaging::PixelType::L_U8)));
+                }
+
+            private:
+                std::vector<otime::RationalTime> _reads;
+                bool _released = false;
+                std::condition_variable _cv;
+                std::mutex _mutex;
+            };
+        }
+
+        void AVIOTest::_priority()
+        {
+            // Keep the reader busy with the first request while the other
+            // requests are queued, so that they are all waiting when it
+            // is released. Lower priority values are read first, and
+            // requests with the same priority are read in order.
+            Options options;
+            options["SequenceIO/ThreadCount"] = "1";
+            auto read = PriorityRead::create(file::Path("AVIOTest_priority.test"), options, _context->getLogSystem());
+            std::vector<std::future<VideoFrame> > futures;
+            futures.push_back(read->readVideoFrame(otime::RationalTime(0.0, 24.0), 0));
+            read->waitForReads(1);
+            const std::vector<std::pair<double, int64_t> > requests =
+            {
+                { 1.0, 3 },
+                { 2.0, 1 },
+                { 3.0, 2 },
+                { 4.0, 1 },
+                { 5.0, 0 }
+            };
+            for (const auto& i : requests)
+            {
+                futures.push_back(read->readVideoFrame(otime::RationalTime(i.first, 24.0), i.second));
+            }
+            read->release();
+            for (auto& i : futures)
+            {
+                const auto videoFrame = i.get();
+                TLR_ASSERT(videoFrame.image);
+            }
+            const std::vector<otime::RationalTime> order =
+            {
+                otime::RationalTime(0.0, 24.0),
+                otime::RationalTime(5.0, 24.0),
+                otime::RationalTime(2.0, 24.0),
+                otime::RationalTime(4.0, 24.0),
+                otime::RationalTime(3.0, 24.0),
+                otime::RationalTime(1.0, 24.0)
+            };
+            TLR_ASSERT(order == read->getReads());
+        }
     }
 }
@@ -22,7 +22,9 @@ namespace tlr
 
         private:
             void _videoFrame();
+            void _cache();
             void _ioSystem();
+            void _priority();
         };
     }
 }
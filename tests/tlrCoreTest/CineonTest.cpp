@@ -27,6 +27,7 @@ namespace tlr
         {
             _enums();
             _io();
+            _headerCache();
         }
 
         void CineonTest::_enums()
@@ -104,5 +105,63 @@ namespace tlr
                 }
             }
         }
+
+        void CineonTest::_headerCache()
+        {
+            // Write a sequence where the last frame has a different size,
+            // so the reader has to fall back from the cached header layout.
+            // Each frame has a different film frame, which must be read from
+            // the frame and not from the cached header.
+            auto plugin = _context->getSystem<avio::System>()->getPlugin<cineon::Plugin>();
+            const auto pixelType = plugin->getWritePixelTypes()[0];
+            const file::Path path("CineonTest_headerCache.0.cineon");
+            const std::vector<std::string> frames =
+            {
+                "0",
+                "1",
+                "2"
+            };
+            for (const auto& size : { imaging::Size(16, 16), imaging::Size(8, 8) })
+            {
+                auto imageInfo = imaging::Info(size, pixelType);
+                imageInfo.layout.alignment = plugin->getWriteAlignment(pixelType);
+                imageInfo.layout.endian = plugin->getWriteEndian();
+                avio::Info info;
+                info.video.push_back(imageInfo);
+                info.videoDuration = otime::RationalTime(1.0, 24.0);
+                auto write = plugin->write(path, info);
+                auto image = imaging::Image::create(imageInfo);
+                if (imaging::Size(16, 16) == size)
+                {
+                    for (int frame : { 0, 1 })
+                    {
+                        image->setTags({ { "Film Frame", frames[frame] } });
+                        write->writeVideoFrame(otime::RationalTime(frame, 24.0), image);
+                    }
+                }
+                else
+                {
+                    image->setTags({ { "Film Frame", frames[2] } });
+                    write->writeVideoFrame(otime::RationalTime(2.0, 24.0), image);
+                }
+            }
+            auto read = plugin->read(path);
+            for (const auto& i : std::vector<std::pair<int, imaging::Size> >(
+                {
+                    { 0, imaging::Size(16, 16) },
+                    { 1, imaging::Size(16, 16) },
+                    { 2, imaging::Size(8, 8) },
+                    { 0, imaging::Size(16, 16) }
+                }))
+            {
+                const auto videoFrame = read->readVideoFrame(otime::RationalTime(i.first, 24.0)).get();
+                TLR_ASSERT(videoFrame.image);
+                TLR_ASSERT(i.second == videoFrame.image->getSize());
+                const auto& tags = videoFrame.image->getTags();
+                const auto j = tags.find("Film Frame");
+                TLR_ASSERT(j != tags.end());
+                TLR_ASSERT(frames[i.first] == j->second);
+            }
+        }
     }
 }
@@ -23,6 +23,7 @@ namespace tlr
         private:
             void _enums();
             void _io();
+            void _headerCache();
         };
     }
 }
@@ -27,6 +27,8 @@ namespace tlr
         {
             _enums();
             _io();
+            _headerCache();
+            _proxy();
         }
 
         void DPXTest::_enums()
@@ -89,5 +91,103 @@ namespace tlr
                 }
             }
         }
+
+        void DPXTest::_headerCache()
+        {
+            // Write a sequence where the last frame has a different size,
+            // so the reader has to fall back from the cached header layout.
+            // Each frame has a different timecode, which must be read from
+            // the frame and not from the cached header.
+            auto plugin = _context->getSystem<avio::System>()->getPlugin<dpx::Plugin>();
+            const auto pixelType = plugin->getWritePixelTypes()[0];
+            const file::Path path("DPXTest_headerCache.0.dpx");
+            const std::vector<std::string> timecodes =
+            {
+                "00:00:01:00",
+                "00:00:01:01",
+                "00:00:01:02"
+            };
+            for (const auto& size : { imaging::Size(16, 16), imaging::Size(8, 8) })
+            {
+                auto imageInfo = imaging::Info(size, pixelType);
+                imageInfo.layout.alignment = plugin->getWriteAlignment(pixelType);
+                imageInfo.layout.endian = plugin->getWriteEndian();
+                avio::Info info;
+                info.video.push_back(imageInfo);
+                info.videoDuration = otime::RationalTime(1.0, 24.0);
+                auto write = plugin->write(path, info);
+                auto image = imaging::Image::create(imageInfo);
+                if (imaging::Size(16, 16) == size)
+                {
+                    for (int frame : { 0, 1 })
+                    {
+                        image->setTags({ { "Timecode", timecodes[frame] } });
+                        write->writeVideoFrame(otime::RationalTime(frame, 24.0), image);
+                    }
+                }
+                else
+                {
+                    image->setTags({ { "Timecode", timecodes[2] } });
+                    write->writeVideoFrame(otime::RationalTime(2.0, 24.0), image);
+                }
+            }
+            auto read = plugin->read(path);
+            for (const auto& i : std::vector<std::pair<int, imaging::Size> >(
+                {
+                    { 0, imaging::Size(16, 16) },
+                    { 1, imaging::Size(16, 16) },
+                    { 2, imaging::Size(8, 8) },
+                    { 0, imaging::Size(16, 16) }
+                }))
+            {
+                const auto videoFrame = read->readVideoFrame(otime::RationalTime(i.first, 24.0)).get();
+                TLR_ASSERT(videoFrame.image);
+                TLR_ASSERT(i.second == videoFrame.image->getSize());
+                const auto& tags = videoFrame.image->getTags();
+                const auto j = tags.find("Timecode");
+                TLR_ASSERT(j != tags.end());
+                TLR_ASSERT(timecodes[i.first] == j->second);
+            }
+        }
+
+        void DPXTest::_proxy()
+        {
+            auto plugin = _context->getSystem<avio::System>()->getPlugin<dpx::Plugin>();
+            const auto pixelType = plugin->getWritePixelTypes()[0];
+            const file::Path path("DPXTest_proxy.0.dpx");
+            auto imageInfo = imaging::Info(16, 16, pixelType);
+            imageInfo.layout.alignment = plugin->getWriteAlignment(pixelType);
+            imageInfo.layout.endian = plugin->getWriteEndian();
+            avio::Info info;
+            info.video.push_back(imageInfo);
+            info.videoDuration = otime::RationalTime(1.0, 24.0);
+            auto image = imaging::Image::create(imageInfo);
+            uint32_t* data = reinterpret_cast<uint32_t*>(image->getData());
+            for (uint32_t i = 0; i < 16 * 16; ++i)
+            {
+                data[i] = i;
+            }
+            plugin->write(path, info)->writeVideoFrame(otime::RationalTime(0.0, 24.0), image);
+
+            // The proxy samples every fourth row and column.
+            auto read = plugin->read(path);
+            const auto videoFrame = read->readVideoFrame(
+                otime::RationalTime(0.0, 24.0),
+                0,
+                imaging::Size(4, 4)).get();
+            TLR_ASSERT(videoFrame.image);
+            TLR_ASSERT(imaging::Size(4, 4) == videoFrame.image->getSize());
+            const uint32_t* proxyData = reinterpret_cast<const uint32_t*>(videoFrame.image->getData());
+            for (uint32_t y = 0; y < 4; ++y)
+            {
+                for (uint32_t x = 0; x < 4; ++x)
+                {
+                    TLR_ASSERT(y * 4 * 16 + x * 4 == proxyData[y * 4 + x]);
+                }
+            }
+            const auto fullFrame = read->readVideoFrame(otime::RationalTime(0.0, 24.0)).get();
+            TLR_ASSERT(fullFrame.image);
+            TLR_ASSERT(imaging::Size(16, 16) == fullFrame.image->getSize());
+        }
     }
 }
@@ -23,6 +23,8 @@ namespace tlr
         private:
             void _enums();
             void _io();
+            void _headerCache();
+            void _proxy();
         };
     }
 }
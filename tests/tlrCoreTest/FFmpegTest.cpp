@@ -7,9 +7,13 @@
 #include <tlrCore/AVIOSystem.h>
 #include <tlrCore/Assert.h>
 #include <tlrCore/FFmpeg.h>
+#include <tlrCore/StringFormat.h>
+#include <tlrCore/ThreadPool.h>
 
 #include <array>
+#include <cstring>
 #include <sstream>
+#include <thread>
 
 namespace tlr
 {
@@ -28,6 +32,11 @@ namespace tlr
         {
             _enums();
             _io();
+            _seek();
+            _reverse();
+            _readAhead();
+            _pixelTypes();
+            _decoders();
         }
 
         void FFmpegTest::_enums()
@@ -109,5 +118,273 @@ namespace tlr
                 }
             }
         }
+
+        void FFmpegTest::_seek()
+        {
+            // Write a movie where each frame has a different gray level, and
+            // check that the right frames are read in random order.
+            auto plugin = _context->getSystem<avio::System>()->getPlugin<ffmpeg::Plugin>();
+            const file::Path path("FFmpegTest_seek.mov");
+            const auto imageInfo = imaging::Info(64, 64, imaging::PixelType::L_U8);
+            const otime::RationalTime duration(48.0, 24.0);
+            try
+            {
+                {
+                    avio::Info info;
+                    info.video.push_back(imageInfo);
+                    info.videoDuration = duration;
+                    auto write = plugin->write(path, info);
+                    auto image = imaging::Image::create(imageInfo);
+                    for (size_t i = 0; i < static_cast<size_t>(duration.value()); ++i)
+                    {
+                        memset(image->getData(), static_cast<int>(i * 5), image->getDataByteCount());
+                        write->writeVideoFrame(otime::RationalTime(i, 24.0), image);
+                    }
+                }
+                for (const auto& keyFrameIndex : { "0", "1" })
+                {
+                    // Read without the video frame cache, so that every
+                    // frame is decoded by the reader.
+                    avio::Options options;
+                    options["ffmpeg/KeyFrameIndex"] = keyFrameIndex;
+                    auto read = ffmpeg::Read::create(
+                        path,
+                        options,
+                        nullptr,
+                        _context->getSystem<core::ThreadPool>(),
+                        _context->getLogSystem());
+                    for (size_t i : { 30, 10, 11, 12, 40, 5, 47, 0, 14, 13, 25, 26, 45, 46, 1 })
+                    {
+                        const auto videoFrame = read->readVideoFrame(otime::RationalTime(i, 24.0)).get();
+                        TLR_ASSERT(videoFrame.image);
+                        TLR_ASSERT(otime::RationalTime(i, 24.0) == videoFrame.time);
+
+                        // The gray level is converted to video range luma.
+                        const int luma = 16 + static_cast<int>(i * 5) * 219 / 255;
+                        TLR_ASSERT(abs(videoFrame.image->getData()[0] - luma) <= 2);
+                    }
+                }
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+        }
+
+        void FFmpegTest::_reverse()
+        {
+            // Read the movie written by _seek() backward.
+            const file::Path path("FFmpegTest_seek.mov");
+            try
+            {
+                for (const auto& gopCacheSize : { "0", "4", "60" })
+                {
+                    // Read without the video frame cache, so that the frames
+                    // come from the GOP cache or are decoded.
+                    avio::Options options;
+                    options["ffmpeg/GOPCacheSize"] = gopCacheSize;
+                    auto read = ffmpeg::Read::create(
+                        path,
+                        options,
+                        nullptr,
+                        _context->getSystem<core::ThreadPool>(),
+                        _context->getLogSystem());
+                    for (int i = 47; i >= 0; --i)
+                    {
+                        const auto videoFrame = read->readVideoFrame(otime::RationalTime(i, 24.0)).get();
+                        TLR_ASSERT(videoFrame.image);
+                        TLR_ASSERT(otime::RationalTime(i, 24.0) == videoFrame.time);
+                        const int luma = 16 + i * 5 * 219 / 255;
+                        TLR_ASSERT(abs(videoFrame.image->getData()[0] - luma) <= 2);
+                    }
+                }
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+        }
+
+        void FFmpegTest::_readAhead()
+        {
+            // Read the movie written by _seek() forward, giving the reader
+            // time to read ahead between the requests.
+            const file::Path path("FFmpegTest_seek.mov");
+            try
+            {
+                const std::vector<std::pair<std::string, std::string> > readAhead =
+                {
+                    { "0", "0" },
+                    { "8", "0" },
+                    { "8", "1024" },
+                    { "60", string::Format("{0}").arg(memory::gigabyte) }
+                };
+                for (const auto& i : readAhead)
+                {
+                    // Read without the video frame cache, so that the frames
+                    // come from the read ahead buffer or are decoded.
+                    avio::Options options;
+                    options["ffmpeg/ReadAheadFrames"] = i.first;
+                    options["ffmpeg/ReadAheadByteCount"] = i.second;
+                    auto read = ffmpeg::Read::create(
+                        path,
+                        options,
+                        nullptr,
+                        _context->getSystem<core::ThreadPool>(),
+                        _context->getLogSystem());
+                    for (const auto& j : { 0, 1, 2, 3, 10, 11, 30, 47 })
+                    {
+                        const auto videoFrame = read->readVideoFrame(otime::RationalTime(j, 24.0)).get();
+                        TLR_ASSERT(videoFrame.image);
+                        TLR_ASSERT(otime::RationalTime(j, 24.0) == videoFrame.time);
+                        const int luma = 16 + j * 5 * 219 / 255;
+                        TLR_ASSERT(abs(videoFrame.image->getData()[0] - luma) <= 2);
+                        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    }
+
+                    // The frames following the requests were read ahead,
+                    // unless either limit disables reading ahead.
+                    if (i.first != "0" && i.second != "0")
+                    {
+                        TLR_ASSERT(read->getBufferedFrameCount() > 0);
+                    }
+                    else
+                    {
+                        TLR_ASSERT(0 == read->getBufferedFrameCount());
+                    }
+                }
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+        }
+
+        void FFmpegTest::_pixelTypes()
+        {
+            // Check that 10-bit 4:2:2 and 4:4:4 movies are read without
+            // conversion.
+            auto plugin = _context->getSystem<avio::System>()->getPlugin<ffmpeg::Plugin>();
+            const auto imageInfo = imaging::Info(64, 64, imaging::PixelType::L_U8);
+            const otime::RationalTime duration(4.0, 24.0);
+            const std::vector<std::pair<ffmpeg::Profile, imaging::PixelType> > profiles =
+            {
+                { ffmpeg::Profile::ProRes_HQ, imaging::PixelType::YUV_422P_U10 },
+                { ffmpeg::Profile::ProRes_4444, imaging::PixelType::YUV_444P_U10 }
+            };
+            for (const auto& i : profiles)
+            {
+                file::Path path;
+                {
+                    std::stringstream ss;
+                    ss << "FFmpegTest_" << i.first << ".mov";
+                    _print(ss.str());
+                    path = file::Path(ss.str());
+                }
+                try
+                {
+                    {
+                        avio::Info info;
+                        info.video.push_back(imageInfo);
+                        info.videoDuration = duration;
+                        avio::Options options;
+                        options["ffmpeg/WriteProfile"] = string::Format("{0}").arg(i.first);
+                        auto write = plugin->write(path, info, options);
+                        auto image = imaging::Image::create(imageInfo);
+                        memset(image->getData(), 128, image->getDataByteCount());
+                        for (size_t j = 0; j < static_cast<size_t>(duration.value()); ++j)
+                        {
+                            write->writeVideoFrame(otime::RationalTime(j, 24.0), image);
+                        }
+                    }
+                    auto read = plugin->read(path);
+                    TLR_ASSERT(i.second == read->getInfo().get().video[0].pixelType);
+                    TLR_ASSERT(imaging::YUVRange::Limited == read->getInfo().get().video[0].yuvRange);
+                    for (size_t j = 0; j < static_cast<size_t>(duration.value()); ++j)
+                    {
+                        const auto videoFrame = read->readVideoFrame(otime::RationalTime(j, 24.0)).get();
+                        TLR_ASSERT(videoFrame.image);
+                        TLR_ASSERT(i.second == videoFrame.image->getPixelType());
+                        TLR_ASSERT(imaging::YUVRange::Limited == videoFrame.image->getInfo().yuvRange);
+                        TLR_ASSERT(3 == videoFrame.image->getPlaneCount());
+                        TLR_ASSERT(imaging::getPlaneSize(videoFrame.image->getInfo(), 1) ==
+                            imaging::getPlaneSize(imaging::Info(imageInfo.size, i.second), 1));
+
+                        // The gray level is converted to 10-bit video range
+                        // luma.
+                        const int luma = (16 + 128 * 219 / 255) * 4;
+                        const uint16_t* data = reinterpret_cast<const uint16_t*>(videoFrame.image->getData());
+                        TLR_ASSERT(abs(data[0] - luma) <= 8);
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    _printError(e.what());
+                }
+            }
+        }
+
+        void FFmpegTest::_decoders()
+        {
+            // Write an intra-only movie where each frame has a different gray
+            // level, and check that the right frames are read when all of the
+            // requests are made before waiting for them.
+            auto plugin = _context->getSystem<avio::System>()->getPlugin<ffmpeg::Plugin>();
+            const file::Path path("FFmpegTest_decoders.mov");
+            const auto imageInfo = imaging::Info(64, 64, imaging::PixelType::L_U8);
+            const otime::RationalTime duration(24.0, 24.0);
+            try
+            {
+                {
+                    avio::Info info;
+                    info.video.push_back(imageInfo);
+                    info.videoDuration = duration;
+                    avio::Options options;
+                    options["ffmpeg/WriteProfile"] = string::Format("{0}").arg(ffmpeg::Profile::ProRes);
+                    auto write = plugin->write(path, info, options);
+                    auto image = imaging::Image::create(imageInfo);
+                    for (size_t i = 0; i < static_cast<size_t>(duration.value()); ++i)
+                    {
+                        memset(image->getData(), static_cast<int>(i * 10), image->getDataByteCount());
+                        write->writeVideoFrame(otime::RationalTime(i, 24.0), image);
+                    }
+                }
+                for (const auto& decoderCount : { "1", "4" })
+                {
+                    // Read without the video frame cache, so that every
+                    // frame is decoded by the pool.
+                    avio::Options options;
+                    options["ffmpeg/DecoderCount"] = decoderCount;
+                    auto read = ffmpeg::Read::create(
+                        path,
+                        options,
+                        nullptr,
+                        _context->getSystem<core::ThreadPool>(),
+                        _context->getLogSystem());
+                    const std::vector<int> frames = { 12, 13, 14, 0, 23, 5, 6, 1, 20, 19, 18, 7, 2, 3, 4 };
+                    std::vector<std::future<avio::VideoFrame> > futures;
+                    for (const auto i : frames)
+                    {
+                        futures.push_back(read->readVideoFrame(otime::RationalTime(i, 24.0)));
+                    }
+                    for (size_t i = 0; i < frames.size(); ++i)
+                    {
+                        const auto videoFrame = futures[i].get();
+                        TLR_ASSERT(videoFrame.image);
+                        TLR_ASSERT(otime::RationalTime(frames[i], 24.0) == videoFrame.time);
+
+                        // The gray level is converted to 10-bit video range
+                        // luma.
+                        const int luma = (16 + frames[i] * 10 * 219 / 255) * 4;
+                        const uint16_t* data = reinterpret_cast<const uint16_t*>(videoFrame.image->getData());
+                        TLR_ASSERT(abs(data[0] - luma) <= 8);
+                    }
+                }
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+        }
     }
 }
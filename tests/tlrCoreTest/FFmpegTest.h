@@ -23,6 +23,11 @@ namespace tlr
         private:
             void _enums();
             void _io();
+            void _seek();
+            void _reverse();
+            void _readAhead();
+            void _pixelTypes();
+            void _decoders();
         };
     }
 }
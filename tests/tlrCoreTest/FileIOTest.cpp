@@ -8,7 +8,9 @@
 #include <tlrCore/File.h>
 #include <tlrCore/FileIO.h>
 #include <tlrCore/Path.h>
+#include <tlrCore/ThreadPool.h>
 
+#include <cstring>
 #include <limits>
 #include <sstream>
 
@@ -279,6 +281,119 @@ namespace tlr
             {
                 _print(e.what());
             }
+
+            _readQueue();
+            _directIO();
+        }
+
+        void FileIOTest::_readQueue()
+        {
+            const std::string fileName = Path(createTempDir(), _fileName).get();
+            std::vector<uint8_t> data(1024 * 1024);
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+                data[i] = static_cast<uint8_t>(i * 7);
+            }
+            {
+                auto io = FileIO::create();
+                io->open(fileName, Mode::Write);
+                io->write(data.data(), data.size());
+            }
+
+            {
+                auto io = FileIO::create();
+                io->open(fileName, Mode::Read);
+                uint8_t buf[16];
+                io->readAt(1000, buf, 16);
+                TLR_ASSERT(0 == memcmp(buf, data.data() + 1000, 16));
+                TLR_ASSERT(0 == io->getPos());
+                try
+                {
+                    io->readAt(data.size() - 8, buf, 16);
+                    TLR_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+            }
+
+            for (const auto& threadPool : { _context->getSystem<core::ThreadPool>(), std::shared_ptr<core::ThreadPool>() })
+            {
+                const size_t count = 100;
+                const size_t size = 8192;
+                std::vector<std::vector<uint8_t> > buffers(count);
+                auto queue = ReadQueue::create(threadPool, 8);
+                {
+                    std::stringstream ss;
+                    ss << "Read queue async: " << queue->isAsync();
+                    _print(ss.str());
+                }
+                auto io = FileIO::create();
+                io->open(fileName, Mode::Read);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    buffers[i].resize(size);
+                    queue->read(io, i * size, buffers[i].data(), size);
+                }
+                uint8_t buf[16];
+                const uint64_t errorID = queue->read(io, data.size() - 8, buf, 16);
+                queue->submit();
+                TLR_ASSERT(count + 1 == queue->getPending());
+                auto results = queue->reap(10);
+                TLR_ASSERT(results.size() >= 10);
+                for (const auto& i : queue->wait())
+                {
+                    results.push_back(i);
+                }
+                TLR_ASSERT(count + 1 == results.size());
+                TLR_ASSERT(0 == queue->getPending());
+                for (const auto& i : results)
+                {
+                    TLR_ASSERT(i.error.empty() == (i.id != errorID));
+                }
+                for (size_t i = 0; i < count; ++i)
+                {
+                    TLR_ASSERT(0 == memcmp(buffers[i].data(), data.data() + i * size, size));
+                }
+            }
+        }
+
+        void FileIOTest::_directIO()
+        {
+            for (auto i : getDirectIOEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                DirectIO directIO = DirectIO::First;
+                ss >> directIO;
+                TLR_ASSERT(i == directIO);
+            }
+
+            const std::string fileName = Path(createTempDir(), _fileName).get();
+            std::vector<uint8_t> data(3 * directIOAlignment + 123);
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+                data[i] = static_cast<uint8_t>(i * 13);
+            }
+            {
+                auto io = FileIO::create();
+                io->open(fileName, Mode::Write);
+                io->write(data.data(), data.size());
+            }
+            for (auto i : getDirectIOEnums())
+            {
+                auto io = FileIO::create();
+                io->open(fileName, Mode::Read, i);
+                uint8_t u8[7];
+                io->setPos(1000);
+                io->read(u8, 7);
+                TLR_ASSERT(0 == memcmp(u8, data.data() + 1000, 7));
+                TLR_ASSERT(1007 == io->getPos());
+                std::vector<uint8_t> buf(data.size());
+                io->readAt(0, buf.data(), buf.size());
+                TLR_ASSERT(buf == data);
+                io->readAt(5, buf.data() + 3, data.size() - 5);
+                TLR_ASSERT(0 == memcmp(buf.data() + 3, data.data() + 5, data.size() - 5));
+            }
         }
     }
 }
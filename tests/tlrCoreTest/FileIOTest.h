@@ -21,6 +21,9 @@ namespace tlr
             void run() override;
 
         private:
+            void _readQueue();
+            void _directIO();
+
             std::string _fileName;
             std::string _text;
             std::string _text2;
@@ -6,6 +6,8 @@
 
 #include <tlrCore/Assert.h>
 #include <tlrCore/File.h>
+#include <tlrCore/FileIO.h>
+#include <tlrCore/SequenceIndex.h>
 
 #include <sstream>
 
@@ -26,11 +28,108 @@ namespace tlr
 
         void FileTest::run()
         {
+            _tempDir();
+            _listDirectory();
+            _prefetch();
+            _sequenceIndex();
+        }
+
+        void FileTest::_tempDir()
+        {
+            std::stringstream ss;
+            ss << "Temp dir:" << createTempDir();
+            _print(ss.str());
+        }
+
+        void FileTest::_listDirectory()
+        {
+            const std::string dir = createTempDir();
+            {
+                auto io = FileIO::create();
+                io->open(Path(dir, "a.txt").get(), Mode::Write);
+                io->writeU32(0);
+            }
+            {
+                auto io = FileIO::create();
+                io->open(Path(dir, "b.txt").get(), Mode::Write);
+                io->writeU8(0);
+            }
+            auto entries = listDirectory(dir);
+            TLR_ASSERT(2 == entries.size());
+            for (const auto& i : entries)
+            {
+                if ("a.txt" == i.fileName)
+                {
+                    TLR_ASSERT(4 == i.size);
+                }
+                else
+                {
+                    TLR_ASSERT("b.txt" == i.fileName);
+                    TLR_ASSERT(1 == i.size);
+                }
+            }
+
+            // Only the matching file names are listed.
+            entries = listDirectory(dir, "a", ".txt");
+            TLR_ASSERT(1 == entries.size());
+            TLR_ASSERT("a.txt" == entries[0].fileName);
+            TLR_ASSERT(4 == entries[0].size);
+            TLR_ASSERT(listDirectory(dir, "b", ".exr").empty());
+        }
+
+        void FileTest::_prefetch()
+        {
+            const std::string fileName = Path(createTempDir(), "prefetch.txt").get();
+            {
+                auto io = FileIO::create();
+                io->open(fileName, Mode::Write);
+                io->writeU32(1);
+            }
+            prefetch(fileName);
+            {
+                auto io = FileIO::create();
+                io->open(fileName, Mode::Read);
+                uint32_t value = 0;
+                io->readU32(&value);
+                TLR_ASSERT(1 == value);
+            }
+            prefetch(fileName + ".missing");
+        }
+
+        void FileTest::_sequenceIndex()
+        {
+            const std::string dir = createTempDir();
+            for (const auto& i : { "render.0001.exr", "render.0002.exr", "render.0005.exr", "render.10.exr", "render.0003.tif" })
+            {
+                auto io = FileIO::create();
+                io->open(Path(dir, i).get(), Mode::Write);
+                io->writeU8(0);
+            }
+            const Path path(dir, "render.0001.exr");
+            auto index = SequenceIndex::create(path);
+            TLR_ASSERT(path == index->getPath());
+            TLR_ASSERT(3 == index->getCount());
+            TLR_ASSERT(math::Range<int64_t>(1, 5) == index->getRange());
+            TLR_ASSERT(index->hasFrame(1));
+            TLR_ASSERT(!index->hasFrame(3));
+            TLR_ASSERT(!index->hasFrame(10));
+            TLR_ASSERT(1 == index->getSize(2));
+            TLR_ASSERT(0 == index->getSize(4));
+            TLR_ASSERT(std::vector<int64_t>({ 3, 4 }) == index->getMissing());
+            TLR_ASSERT(1 == index->getNearest(0));
+            TLR_ASSERT(2 == index->getNearest(3));
+            TLR_ASSERT(5 == index->getNearest(4));
+            TLR_ASSERT(5 == index->getNearest(100));
+
             {
-                std::stringstream ss;
-                ss << "Temp dir:" << createTempDir();
-                _print(ss.str());
+                auto io = FileIO::create();
+                io->open(Path(dir, "render.0003.exr").get(), Mode::Write);
+                io->writeU8(0);
             }
+            TLR_ASSERT(!index->hasFrame(3));
+            index->update();
+            TLR_ASSERT(index->hasFrame(3));
+            TLR_ASSERT(std::vector<int64_t>({ 4 }) == index->getMissing());
         }
     }
 }
@@ -19,6 +19,12 @@ namespace tlr
             static std::shared_ptr<FileTest> create(const std::shared_ptr<core::Context>&);
 
             void run() override;
+
+        private:
+            void _tempDir();
+            void _listDirectory();
+            void _prefetch();
+            void _sequenceIndex();
         };
     }
 }
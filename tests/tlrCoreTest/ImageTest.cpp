@@ -6,6 +6,10 @@
 
 #include <tlrCore/Assert.h>
 #include <tlrCore/Image.h>
+#include <tlrCore/ImagePool.h>
+
+#include <cmath>
+#include <cstring>
 
 using namespace tlr::imaging;
 
@@ -29,6 +33,8 @@ namespace tlr
             _util();
             _info();
             _image();
+            _imagePool();
+            _proxy();
         }
         
         void ImageTest::_size()
@@ -70,6 +76,8 @@ namespace tlr
         void ImageTest::_enums()
         {
             _enum<PixelType>("PixelType", getPixelTypeEnums);
+            _enum<YUVRange>("YUVRange", getYUVRangeEnums);
+            _enum<YUVCoefficients>("YUVCoefficients", getYUVCoefficientsEnums);
         }
 
         void ImageTest::_info()
@@ -78,6 +86,8 @@ namespace tlr
                 const Info info;
                 TLR_ASSERT(Size() == info.size);
                 TLR_ASSERT(PixelType::None == info.pixelType);
+                TLR_ASSERT(YUVRange::Full == info.yuvRange);
+                TLR_ASSERT(YUVCoefficients::BT601 == info.yuvCoefficients);
                 TLR_ASSERT(!info.isValid());
             }
             {
@@ -95,6 +105,12 @@ namespace tlr
             {
                 TLR_ASSERT(Info(1, 2, PixelType::L_U8) == Info(1, 2, PixelType::L_U8));
                 TLR_ASSERT(Info(1, 2, PixelType::L_U8) != Info(1, 2, PixelType::L_U16));
+                Info info(1, 2, PixelType::YUV_420P);
+                info.yuvRange = YUVRange::Limited;
+                TLR_ASSERT(info != Info(1, 2, PixelType::YUV_420P));
+                info = Info(1, 2, PixelType::YUV_420P);
+                info.yuvCoefficients = YUVCoefficients::BT709;
+                TLR_ASSERT(info != Info(1, 2, PixelType::YUV_420P));
             }
         }
         
@@ -163,6 +179,7 @@ namespace tlr
                 auto image = Image::create(info);
                 image->zero();
                 TLR_ASSERT(image->getInfo() == info);
+                TLR_ASSERT(!image->isReadOnly());
                 TLR_ASSERT(image->getSize() == info.size);
                 TLR_ASSERT(image->getWidth() == info.size.w);
                 TLR_ASSERT(image->getHeight() == info.size.h);
@@ -171,6 +188,202 @@ namespace tlr
                 TLR_ASSERT(image->isValid());
                 TLR_ASSERT(image->getData());
                 TLR_ASSERT(static_cast<const imaging::Image*>(image.get())->getData());
+                TLR_ASSERT(0 == reinterpret_cast<std::uintptr_t>(image->getData()) % memory::defaultAlignment);
+            }
+            {
+                const Info info(2, 2, PixelType::L_U8);
+                auto data = std::shared_ptr<uint8_t>(new uint8_t[4], std::default_delete<uint8_t[]>());
+                std::weak_ptr<uint8_t> weak = data;
+                auto image = Image::create(info, data.get(), data);
+                TLR_ASSERT(image->getInfo() == info);
+                TLR_ASSERT(image->isReadOnly());
+                TLR_ASSERT(image->getDataByteCount() == 4);
+                TLR_ASSERT(image->getData() == data.get());
+                data.reset();
+                TLR_ASSERT(!weak.expired());
+                image.reset();
+                TLR_ASSERT(weak.expired());
+            }
+            {
+                const Info info(4, 2, PixelType::YUV_420P);
+                TLR_ASSERT(3 == getPlaneCount(info.pixelType));
+                TLR_ASSERT(Size(2, 1) == getPlaneSize(info, 1));
+                TLR_ASSERT(2 == getPlaneRowByteCount(info, 2));
+                auto image = Image::create(info);
+                TLR_ASSERT(image->isPacked());
+                TLR_ASSERT(3 == image->getPlaneCount());
+                TLR_ASSERT(image->getData() == image->getPlaneData(0));
+                TLR_ASSERT(image->getData() + 8 == image->getPlaneData(1));
+                TLR_ASSERT(image->getData() + 10 == image->getPlaneData(2));
+                TLR_ASSERT(4 == image->getPlaneStride(0));
+                TLR_ASSERT(2 == image->getPlaneStride(1));
+            }
+            {
+                TLR_ASSERT(isYUV(PixelType::YUV_422P_U10));
+                TLR_ASSERT(!isYUV(PixelType::RGB_U10));
+                TLR_ASSERT(Size(2, 2) == getPlaneSize(Info(4, 2, PixelType::YUV_422P), 1));
+                TLR_ASSERT(Size(4, 2) == getPlaneSize(Info(4, 2, PixelType::YUV_444P_U16), 2));
+                TLR_ASSERT(4 == getPlaneRowByteCount(Info(4, 2, PixelType::YUV_422P_U10), 1));
+                TLR_ASSERT(16 == getDataByteCount(Info(4, 2, PixelType::YUV_422P)));
+                TLR_ASSERT(48 == getDataByteCount(Info(4, 2, PixelType::YUV_444P_U16)));
+            }
+            {
+                const Info info(3, 2, PixelType::RGB_U8);
+                auto data = std::shared_ptr<uint8_t>(new uint8_t[32], std::default_delete<uint8_t[]>());
+                memset(data.get(), 1, 32);
+                auto image = Image::create(info, { data.get() }, { 16 }, data);
+                TLR_ASSERT(!image->isPacked());
+                TLR_ASSERT(image->isReadOnly());
+                TLR_ASSERT(1 == image->getPlaneCount());
+                TLR_ASSERT(16 == image->getPlaneStride(0));
+                TLR_ASSERT(32 == image->getDataByteCount());
+            }
+            {
+                const Info info(3, 2, PixelType::RGB_U8);
+                auto data = std::shared_ptr<uint8_t>(new uint8_t[32], std::default_delete<uint8_t[]>());
+                for (size_t i = 0; i < 32; ++i)
+                {
+                    data.get()[i] = i;
+                }
+                auto image = Image::create(info, { data.get() }, { 16 }, data);
+                auto packed = pack(image);
+                TLR_ASSERT(packed != image);
+                TLR_ASSERT(packed->getInfo() == info);
+                TLR_ASSERT(packed->isPacked());
+                TLR_ASSERT(18 == packed->getDataByteCount());
+                for (size_t y = 0; y < 2; ++y)
+                {
+                    for (size_t x = 0; x < 9; ++x)
+                    {
+                        TLR_ASSERT(y * 16 + x == packed->getData()[y * 9 + x]);
+                    }
+                }
+                TLR_ASSERT(pack(packed) == packed);
+            }
+        }
+
+        void ImageTest::_imagePool()
+        {
+            {
+                const ImagePoolStats stats;
+                TLR_ASSERT(0 == stats.hits);
+                TLR_ASSERT(0 == stats.misses);
+                TLR_ASSERT(0 == stats.count);
+                TLR_ASSERT(0 == stats.byteCount);
+                ImagePoolStats stats2;
+                TLR_ASSERT(stats == stats2);
+                stats2.hits = 1;
+                TLR_ASSERT(stats != stats2);
+            }
+            {
+                auto pool = ImagePool::create();
+                TLR_ASSERT(imagePoolMaxByteCount == pool->getMax());
+                const Info info(16, 16, PixelType::RGBA_U8);
+                const std::size_t byteCount = getDataByteCount(info);
+                const uint8_t* data = nullptr;
+                {
+                    auto image = Image::create(info, pool);
+                    data = image->getData();
+                    TLR_ASSERT(0 == reinterpret_cast<std::uintptr_t>(data) % memory::defaultAlignment);
+                    ImagePoolStats stats = pool->getStats();
+                    TLR_ASSERT(0 == stats.hits);
+                    TLR_ASSERT(1 == stats.misses);
+                    TLR_ASSERT(0 == stats.count);
+                }
+                ImagePoolStats stats = pool->getStats();
+                TLR_ASSERT(1 == stats.count);
+                TLR_ASSERT(byteCount == stats.byteCount);
+                {
+                    auto image = Image::create(info, pool);
+                    TLR_ASSERT(data == image->getData());
+                    stats = pool->getStats();
+                    TLR_ASSERT(1 == stats.hits);
+                    TLR_ASSERT(0 == stats.count);
+
+                    auto image2 = Image::create(Info(8, 8, PixelType::RGBA_U8), pool);
+                    stats = pool->getStats();
+                    TLR_ASSERT(2 == stats.misses);
+                }
+                stats = pool->getStats();
+                TLR_ASSERT(2 == stats.count);
+                pool->trim(byteCount);
+                stats = pool->getStats();
+                TLR_ASSERT(1 == stats.count);
+                TLR_ASSERT(byteCount / 4 == stats.byteCount);
+                pool->trim();
+                stats = pool->getStats();
+                TLR_ASSERT(0 == stats.count);
+                TLR_ASSERT(0 == stats.byteCount);
+
+                pool->setMax(0);
+                {
+                    auto image = Image::create(info, pool);
+                }
+                stats = pool->getStats();
+                TLR_ASSERT(0 == stats.count);
+            }
+            {
+                auto image = Image::create(Info());
+                TLR_ASSERT(!image->getData());
+            }
+        }
+
+        void ImageTest::_proxy()
+        {
+            {
+                TLR_ASSERT(0 == getProxyLevel(Size(1920, 1080), Size()));
+                TLR_ASSERT(0 == getProxyLevel(Size(1920, 1080), Size(1920, 1080)));
+                TLR_ASSERT(0 == getProxyLevel(Size(1920, 1080), Size(1000, 1000)));
+                TLR_ASSERT(1 == getProxyLevel(Size(1920, 1080), Size(960, 960)));
+                TLR_ASSERT(3 == getProxyLevel(Size(1920, 1080), Size(160, 90)));
+                TLR_ASSERT(3 == getProxyLevel(Size(1920, 1080), Size(200, 100)));
+                TLR_ASSERT(11 == getProxyLevel(Size(1920, 1080), Size(1, 1)));
+            }
+            {
+                TLR_ASSERT(Size(1920, 1080) == getProxySize(Size(1920, 1080), 0));
+                TLR_ASSERT(Size(240, 135) == getProxySize(Size(1920, 1080), 3));
+                TLR_ASSERT(Size(3, 2) == getProxySize(Size(5, 3), 1));
+                TLR_ASSERT(Size(1, 1) == getProxySize(Size(5, 3), 20));
+            }
+            {
+                auto image = Image::create(Info(4, 2, PixelType::L_U8));
+                const uint8_t data[] = { 0, 2, 10, 20, 4, 6, 30, 40 };
+                std::memcpy(image->getData(), data, sizeof(data));
+                image->setTags({ { "Key", "Value" } });
+                auto proxy = downscale(image, Size(2, 1));
+                TLR_ASSERT(Size(2, 1) == proxy->getSize());
+                TLR_ASSERT(PixelType::L_U8 == proxy->getPixelType());
+                TLR_ASSERT(3 == proxy->getData()[0]);
+                TLR_ASSERT(25 == proxy->getData()[1]);
+                TLR_ASSERT(image->getTags() == proxy->getTags());
+                TLR_ASSERT(image == downscale(image, Size(4, 2)));
+                TLR_ASSERT(image == downscale(image, Size()));
+            }
+            {
+                auto image = Image::create(Info(2, 2, PixelType::RGB_F32));
+                float* data = reinterpret_cast<float*>(image->getData());
+                for (size_t i = 0; i < 12; ++i)
+                {
+                    data[i] = i / 11.F;
+                }
+                auto proxy = downscale(image, Size(1, 1));
+                const float* proxyData = reinterpret_cast<const float*>(proxy->getData());
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    TLR_ASSERT(fabs(proxyData[c] - (c * 4 + 18) / 44.F) < .0001F);
+                }
+            }
+            for (auto pixelType : getPixelTypeEnums())
+            {
+                auto image = Image::create(Info(33, 17, pixelType));
+                if (image->getData())
+                {
+                    image->zero();
+                    const Size size = getProxySize(image->getSize(), 2);
+                    auto proxy = downscale(image, size);
+                    TLR_ASSERT(size == proxy->getSize());
+                    TLR_ASSERT(pixelType == proxy->getPixelType());
+                }
             }
         }
     }
@@ -26,6 +26,8 @@ namespace tlr
             void _info();
             void _util();
             void _image();
+            void _imagePool();
+            void _proxy();
         };
     }
 }
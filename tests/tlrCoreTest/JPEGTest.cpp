@@ -24,6 +24,13 @@ namespace tlr
         }
 
         void JPEGTest::run()
+        {
+            _io();
+            _yuv();
+            _cache();
+        }
+
+        void JPEGTest::_io()
         {
             auto plugin = _context->getSystem<avio::System>()->getPlugin<jpeg::Plugin>();
             const std::map<std::string, std::string> tags =
@@ -78,5 +85,71 @@ namespace tlr
                 }
             }
         }
+
+        void JPEGTest::_yuv()
+        {
+            auto plugin = _context->getSystem<avio::System>()->getPlugin<jpeg::Plugin>();
+            const file::Path path("JPEGTest_yuv.0.jpg");
+            const auto imageInfo = imaging::Info(32, 16, imaging::PixelType::RGB_U8);
+            avio::Info info;
+            info.video.push_back(imageInfo);
+            info.videoDuration = otime::RationalTime(1.0, 24.0);
+            auto image = imaging::Image::create(imageInfo);
+            image->zero();
+            plugin->write(path, info)->writeVideoFrame(otime::RationalTime(0.0, 24.0), image);
+
+            avio::Options options;
+            options["JPEG/YUV"] = "1";
+            auto read = plugin->read(path, options);
+            TLR_ASSERT(imaging::PixelType::YUV_420P == read->getInfo().get().video[0].pixelType);
+            for (const auto& i : std::vector<std::pair<imaging::Size, imaging::Size> >(
+                {
+                    { imaging::Size(), imaging::Size(32, 16) },
+                    { imaging::Size(16, 8), imaging::Size(16, 8) },
+                    { imaging::Size(4, 2), imaging::Size(4, 2) }
+                }))
+            {
+                const auto videoFrame = read->readVideoFrame(otime::RationalTime(0.0, 24.0), 0, i.first).get();
+                TLR_ASSERT(videoFrame.image);
+                TLR_ASSERT(i.second == videoFrame.image->getSize());
+                TLR_ASSERT(imaging::PixelType::YUV_420P == videoFrame.image->getPixelType());
+
+                // Black is zero luma and neutral chroma.
+                const uint8_t* data = videoFrame.image->getData();
+                const size_t lumaCount = i.second.w * i.second.h;
+                TLR_ASSERT(data[0] < 2);
+                TLR_ASSERT(abs(data[lumaCount] - 128) < 2);
+            }
+        }
+
+        void JPEGTest::_cache()
+        {
+            // Readers of the same file with and without the "JPEG/YUV" option
+            // share the video frame cache, but must not share frames.
+            auto plugin = _context->getSystem<avio::System>()->getPlugin<jpeg::Plugin>();
+            const file::Path path("JPEGTest_cache.0.jpg");
+            const auto imageInfo = imaging::Info(32, 16, imaging::PixelType::RGB_U8);
+            avio::Info info;
+            info.video.push_back(imageInfo);
+            info.videoDuration = otime::RationalTime(1.0, 24.0);
+            auto image = imaging::Image::create(imageInfo);
+            image->zero();
+            plugin->write(path, info)->writeVideoFrame(otime::RationalTime(0.0, 24.0), image);
+
+            for (const auto& i : std::vector<std::pair<std::string, imaging::PixelType> >(
+                {
+                    { "0", imaging::PixelType::RGB_U8 },
+                    { "1", imaging::PixelType::YUV_420P },
+                    { "0", imaging::PixelType::RGB_U8 }
+                }))
+            {
+                avio::Options options;
+                options["JPEG/YUV"] = i.first;
+                auto read = plugin->read(path, options);
+                const auto videoFrame = read->readVideoFrame(otime::RationalTime(0.0, 24.0)).get();
+                TLR_ASSERT(videoFrame.image);
+                TLR_ASSERT(i.second == videoFrame.image->getPixelType());
+            }
+        }
     }
 }
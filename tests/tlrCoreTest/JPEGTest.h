@@ -19,6 +19,11 @@ namespace tlr
             static std::shared_ptr<JPEGTest> create(const std::shared_ptr<core::Context>&);
 
             void run() override;
+
+        private:
+            void _io();
+            void _yuv();
+            void _cache();
         };
     }
 }
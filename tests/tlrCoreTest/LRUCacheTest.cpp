@@ -62,9 +62,37 @@ namespace tlr
                 TLR_ASSERT(c.contains(3));
                 TLR_ASSERT(c.contains(1));
                 TLR_ASSERT(c.contains(4));
-                const auto l = c.getKeys();
-                TLR_ASSERT(std::vector<int>({ 1, 3, 4 }) == c.getKeys());
-                TLR_ASSERT(std::vector<int>({ 2, 4, 5 }) == c.getValues());
+                TLR_ASSERT(std::vector<int>({ 4, 1, 3 }) == c.getKeys());
+                TLR_ASSERT(std::vector<int>({ 5, 2, 4 }) == c.getValues());
+            }
+            {
+                LRUCache<int, int> c;
+                c.setMax(10);
+                c.add(0, 1, 4);
+                c.add(1, 2, 4);
+                TLR_ASSERT(8 == c.getSize());
+                TLR_ASSERT(2 == c.getCount());
+                TLR_ASSERT(80.F == c.getPercentageUsed());
+                int v = 0;
+                c.get(0, v);
+                c.add(2, 3, 4);
+                TLR_ASSERT(c.contains(0));
+                TLR_ASSERT(!c.contains(1));
+                TLR_ASSERT(c.contains(2));
+                TLR_ASSERT(8 == c.getSize());
+                c.add(2, 4, 2);
+                TLR_ASSERT(6 == c.getSize());
+                TLR_ASSERT(c.get(2, v));
+                TLR_ASSERT(4 == v);
+                c.remove(0);
+                TLR_ASSERT(2 == c.getSize());
+                TLR_ASSERT(1 == c.getCount());
+                c.add(3, 5, 20);
+                TLR_ASSERT(0 == c.getSize());
+                TLR_ASSERT(0 == c.getCount());
+                c.add(0, 1, 1);
+                c.clear();
+                TLR_ASSERT(0 == c.getSize());
             }
         }
     }
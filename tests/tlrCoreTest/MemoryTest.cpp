@@ -7,7 +7,9 @@
 #include <tlrCore/Assert.h>
 #include <tlrCore/Memory.h>
 
+#include <chrono>
 #include <sstream>
+#include <vector>
 
 using namespace tlr::memory;
 
@@ -27,14 +29,29 @@ namespace tlr
         void MemoryTest::run()
         {
             _enums();
+            _alignedAlloc();
             _endian();
+            _endianSIMD();
+            _endianBenchmark();
         }
         
         void MemoryTest::_enums()
         {
             _enum<Endian>("Endian", getEndianEnums);
+            _enum<SIMD>("SIMD", getSIMDEnums);
         }
         
+        void MemoryTest::_alignedAlloc()
+        {
+            for (size_t alignment : { sizeof(void*), static_cast<size_t>(16), defaultAlignment, static_cast<size_t>(4096) })
+            {
+                void* p = alignedAlloc(1000, alignment);
+                TLR_ASSERT(p);
+                TLR_ASSERT(0 == reinterpret_cast<std::uintptr_t>(p) % alignment);
+                alignedFree(p);
+            }
+        }
+
         void MemoryTest::_endian()
         {
             {
@@ -151,5 +168,91 @@ namespace tlr
                 TLR_ASSERT(p[7] == p2[0]);
             }
         }
+
+        void MemoryTest::_endianSIMD()
+        {
+            {
+                std::stringstream ss;
+                ss << "SIMD: " << getSIMD();
+                _print(ss.str());
+            }
+            const SIMD simd = getSIMD();
+            for (auto i : getSIMDEnums())
+            {
+                if (!isSupported(i))
+                {
+                    continue;
+                }
+                setSIMD(i);
+                TLR_ASSERT(i == getSIMD());
+                for (size_t wordSize : { 2, 4, 8 })
+                {
+                    // Use sizes that leave words over from the vectors, and
+                    // an offset for unaligned data.
+                    for (size_t size : { 0, 1, 3, 15, 16, 17, 100 })
+                    {
+                        for (size_t offset : { 0, 1 })
+                        {
+                            const size_t byteCount = size * wordSize;
+                            std::vector<uint8_t> data(byteCount + offset);
+                            for (size_t j = 0; j < data.size(); ++j)
+                            {
+                                data[j] = static_cast<uint8_t>(j);
+                            }
+                            std::vector<uint8_t> out(byteCount + offset);
+                            endian(data.data() + offset, out.data() + offset, size, wordSize);
+                            endian(data.data() + offset, size, wordSize);
+                            for (size_t j = 0; j < byteCount; ++j)
+                            {
+                                const size_t k = j / wordSize * wordSize + wordSize - 1 - j % wordSize;
+                                TLR_ASSERT(static_cast<uint8_t>(k + offset) == data[j + offset]);
+                                TLR_ASSERT(static_cast<uint8_t>(k + offset) == out[j + offset]);
+                            }
+                        }
+                    }
+                }
+            }
+            setSIMD(simd);
+            TLR_ASSERT(simd == getSIMD());
+        }
+
+        void MemoryTest::_endianBenchmark()
+        {
+            const SIMD simd = getSIMD();
+            const size_t byteCount = 16 * megabyte;
+            std::vector<uint8_t> data(byteCount);
+            std::vector<uint8_t> out(byteCount);
+            for (auto i : getSIMDEnums())
+            {
+                if (!isSupported(i))
+                {
+                    continue;
+                }
+                setSIMD(i);
+                for (size_t wordSize : { 2, 4, 8 })
+                {
+                    const size_t count = 8;
+                    const auto t0 = std::chrono::steady_clock::now();
+                    for (size_t j = 0; j < count; ++j)
+                    {
+                        endian(data.data(), byteCount / wordSize, wordSize);
+                    }
+                    const auto t1 = std::chrono::steady_clock::now();
+                    for (size_t j = 0; j < count; ++j)
+                    {
+                        endian(data.data(), out.data(), byteCount / wordSize, wordSize);
+                    }
+                    const auto t2 = std::chrono::steady_clock::now();
+                    const std::chrono::duration<double> inPlace = t1 - t0;
+                    const std::chrono::duration<double> outOfPlace = t2 - t1;
+                    std::stringstream ss;
+                    ss << "Endian " << i << " word size " << wordSize << ": " <<
+                        (count * byteCount / megabyte) / inPlace.count() << " MB/s in place, " <<
+                        (count * byteCount / megabyte) / outOfPlace.count() << " MB/s out of place";
+                    _print(ss.str());
+                }
+            }
+            setSIMD(simd);
+        }
     }
 }
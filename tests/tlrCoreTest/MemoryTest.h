@@ -22,7 +22,10 @@ namespace tlr
         
         private:
             void _enums();
+            void _alignedAlloc();
             void _endian();
+            void _endianSIMD();
+            void _endianBenchmark();
         };
     }
 }
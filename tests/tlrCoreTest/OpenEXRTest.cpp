@@ -8,6 +8,7 @@
 #include <tlrCore/Assert.h>
 #include <tlrCore/OpenEXR.h>
 
+#include <cstring>
 #include <sstream>
 
 namespace tlr
@@ -24,6 +25,20 @@ namespace tlr
         }
 
         void OpenEXRTest::run()
+        {
+            _enums();
+            _io();
+            _channels();
+            _stream();
+        }
+
+        void OpenEXRTest::_enums()
+        {
+            _enum<exr::Channels>("Channels", exr::getChannelsEnums);
+            _enum<exr::Precision>("Precision", exr::getPrecisionEnums);
+        }
+
+        void OpenEXRTest::_io()
         {
             auto plugin = _context->getSystem<avio::System>()->getPlugin<exr::Plugin>();
             const std::map<std::string, std::string> tags =
@@ -93,5 +108,73 @@ namespace tlr
                 }
             }
         }
+
+        void OpenEXRTest::_channels()
+        {
+            auto plugin = _context->getSystem<avio::System>()->getPlugin<exr::Plugin>();
+            const file::Path path("OpenEXRTest_channels.0.exr");
+            {
+                const auto imageInfo = imaging::Info(16, 16, imaging::PixelType::RGBA_F16);
+                avio::Info info;
+                info.video.push_back(imageInfo);
+                info.videoDuration = otime::RationalTime(1.0, 24.0);
+                auto write = plugin->write(path, info);
+                write->writeVideoFrame(otime::RationalTime(0.0, 24.0), imaging::Image::create(imageInfo));
+            }
+            for (const auto& i : std::vector<std::pair<avio::Options, imaging::PixelType> >(
+                {
+                    { {}, imaging::PixelType::RGBA_F16 },
+                    { { { "OpenEXR/Channels", "Color" } }, imaging::PixelType::RGB_F16 },
+                    { { { "OpenEXR/Precision", "Native" }, { "OpenEXR/ThreadCount", "2" } }, imaging::PixelType::RGBA_F16 }
+                }))
+            {
+                auto read = plugin->read(path, i.first);
+                const auto info = read->getInfo().get();
+                TLR_ASSERT(1 == info.video.size());
+                TLR_ASSERT(i.second == info.video[0].pixelType);
+                const auto videoFrame = read->readVideoFrame(otime::RationalTime(0.0, 24.0)).get();
+                TLR_ASSERT(videoFrame.image);
+                TLR_ASSERT(i.second == videoFrame.image->getPixelType());
+            }
+            {
+                auto read = plugin->read(path, { { "OpenEXR/Layer", "diffuse" } });
+                TLR_ASSERT(read->getInfo().get().video.empty());
+            }
+        }
+
+        void OpenEXRTest::_stream()
+        {
+            const std::string fileName = "OpenEXRTest_stream.exr";
+            {
+                auto plugin = _context->getSystem<avio::System>()->getPlugin<exr::Plugin>();
+                const auto imageInfo = imaging::Info(16, 16, imaging::PixelType::RGBA_F16);
+                avio::Info info;
+                info.video.push_back(imageInfo);
+                info.videoDuration = otime::RationalTime(1.0, 24.0);
+                auto write = plugin->write(file::Path(fileName), info);
+                write->writeVideoFrame(otime::RationalTime(0.0, 24.0), imaging::Image::create(imageInfo));
+            }
+            const char magic[] = { 0x76, 0x2f, 0x31, 0x01 };
+            exr::IStream stream(fileName);
+            char buf[4];
+            stream.read(buf, 4);
+            TLR_ASSERT(0 == memcmp(buf, magic, 4));
+            TLR_ASSERT(4 == stream.tellg());
+            stream.seekg(0);
+            if (stream.isMemoryMapped())
+            {
+                TLR_ASSERT(0 == memcmp(stream.readMemoryMapped(4), magic, 4));
+                TLR_ASSERT(4 == stream.tellg());
+            }
+            try
+            {
+                stream.seekg(0);
+                std::vector<char> data(1024 * 1024);
+                stream.read(data.data(), data.size());
+                TLR_ASSERT(false);
+            }
+            catch (const std::exception&)
+            {}
+        }
     }
 }
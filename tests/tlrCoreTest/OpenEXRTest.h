@@ -19,6 +19,12 @@ namespace tlr
             static std::shared_ptr<OpenEXRTest> create(const std::shared_ptr<core::Context>&);
 
             void run() override;
+
+        private:
+            void _enums();
+            void _io();
+            void _channels();
+            void _stream();
         };
     }
 }
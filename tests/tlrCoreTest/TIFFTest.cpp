@@ -6,8 +6,14 @@
 
 #include <tlrCore/AVIOSystem.h>
 #include <tlrCore/Assert.h>
+#include <tlrCore/StringFormat.h>
+#include <tlrCore/ThreadPool.h>
 #include <tlrCore/TIFF.h>
 
+#include <tiffio.h>
+
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 
 namespace tlr
@@ -24,6 +30,12 @@ namespace tlr
         }
 
         void TIFFTest::run()
+        {
+            _io();
+            _threads();
+        }
+
+        void TIFFTest::_io()
         {
             auto plugin = _context->getSystem<avio::System>()->getPlugin<tiff::Plugin>();
             const std::map<std::string, std::string> tags =
@@ -83,5 +95,151 @@ namespace tlr
                 }
             }
         }
+
+        namespace
+        {
+            // Write an RGBA image as strips or tiles, with the samples
+            // interleaved or in separate planes.
+            void writeTIFF(
+                const std::string& fileName,
+                const std::shared_ptr<imaging::Image>& image,
+                bool tiled,
+                bool planar)
+            {
+                const uint16 samples = 4;
+                const uint32 chunkSize = 16;
+                const uint32 width = image->getWidth();
+                const uint32 height = image->getHeight();
+                TIFF* f = TIFFOpen(fileName.c_str(), "w");
+                if (!f)
+                {
+                    throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
+                }
+                uint16 extraSamples[] = { EXTRASAMPLE_ASSOCALPHA };
+                TIFFSetField(f, TIFFTAG_IMAGEWIDTH, width);
+                TIFFSetField(f, TIFFTAG_IMAGELENGTH, height);
+                TIFFSetField(f, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_RGB);
+                TIFFSetField(f, TIFFTAG_SAMPLESPERPIXEL, samples);
+                TIFFSetField(f, TIFFTAG_BITSPERSAMPLE, 8);
+                TIFFSetField(f, TIFFTAG_EXTRASAMPLES, 1, extraSamples);
+                TIFFSetField(f, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_UINT);
+                TIFFSetField(f, TIFFTAG_COMPRESSION, COMPRESSION_NONE);
+                TIFFSetField(f, TIFFTAG_PLANARCONFIG, planar ? PLANARCONFIG_SEPARATE : PLANARCONFIG_CONTIG);
+                if (tiled)
+                {
+                    TIFFSetField(f, TIFFTAG_TILEWIDTH, chunkSize);
+                    TIFFSetField(f, TIFFTAG_TILELENGTH, chunkSize);
+                }
+                else
+                {
+                    TIFFSetField(f, TIFFTAG_ROWSPERSTRIP, chunkSize);
+                }
+
+                // Copy the pixels of a chunk, or a single sample of them
+                // for separate planes.
+                const uint16 chunkSamples = planar ? 1 : samples;
+                const uint32 chunkWidth = tiled ? chunkSize : width;
+                const uint32 chunkHeight = tiled ? chunkSize : 1;
+                std::vector<uint8_t> buffer(chunkWidth * chunkHeight * chunkSamples);
+                auto copy = [image, samples, chunkSamples, chunkWidth, chunkHeight, width, height, &buffer]
+                    (uint32 x0, uint32 y0, uint16 sample)
+                {
+                    std::fill(buffer.begin(), buffer.end(), 0);
+                    for (uint32 y = 0; y < chunkHeight && y0 + y < height; ++y)
+                    {
+                        for (uint32 x = 0; x < chunkWidth && x0 + x < width; ++x)
+                        {
+                            const uint8_t* p = image->getData() + ((y0 + y) * width + x0 + x) * samples;
+                            for (uint16 c = 0; c < chunkSamples; ++c)
+                            {
+                                buffer[(y * chunkWidth + x) * chunkSamples + c] = p[sample + c];
+                            }
+                        }
+                    }
+                };
+                for (uint16 sample = 0; sample < samples; sample += chunkSamples)
+                {
+                    for (uint32 y = 0; y < height; y += chunkHeight)
+                    {
+                        for (uint32 x = 0; x < width; x += chunkWidth)
+                        {
+                            copy(x, y, sample);
+                            const bool ok = tiled ?
+                                TIFFWriteTile(f, buffer.data(), x, y, 0, sample) != -1 :
+                                TIFFWriteScanline(f, buffer.data(), y, sample) != -1;
+                            if (!ok)
+                            {
+                                TIFFClose(f);
+                                throw std::runtime_error(string::Format("{0}: Cannot write").arg(fileName));
+                            }
+                        }
+                    }
+                }
+                TIFFClose(f);
+            }
+        }
+
+        void TIFFTest::_threads()
+        {
+            // Each layout is split into several strips or tiles, so that
+            // every parallel decoding path is used.
+            const auto imageInfo = imaging::Info(40, 100, imaging::PixelType::RGBA_U8);
+            auto image = imaging::Image::create(imageInfo);
+            for (size_t i = 0; i < image->getDataByteCount(); ++i)
+            {
+                image->getData()[i] = static_cast<uint8_t>(i * 7 + i / 1024);
+            }
+            for (const auto& layout : std::vector<std::pair<bool, bool> >(
+                {
+                    { false, false },
+                    { true, false },
+                    { false, true },
+                    { true, true }
+                }))
+            {
+                std::stringstream ss;
+                ss << "TIFFTest_threads";
+                ss << (layout.first ? "_tiled" : "_strips");
+                ss << (layout.second ? "_separate" : "_contig");
+                _print(ss.str());
+                const file::Path path(ss.str() + ".0.tif");
+                try
+                {
+                    writeTIFF(path.get(), image, layout.first, layout.second);
+
+                    // Read without the video frame cache, so that each
+                    // thread count decodes the frame.
+                    std::vector<std::shared_ptr<imaging::Image> > images;
+                    for (const auto& threadCount : { "1", "4" })
+                    {
+                        avio::Options options;
+                        options["TIFF/ThreadCount"] = threadCount;
+                        auto read = tiff::Read::create(
+                            path,
+                            options,
+                            nullptr,
+                            _context->getSystem<core::ThreadPool>(),
+                            _context->getLogSystem());
+                        const auto videoFrame = read->readVideoFrame(otime::RationalTime(0.0, 24.0)).get();
+                        TLR_ASSERT(videoFrame.image);
+                        TLR_ASSERT(imageInfo.size == videoFrame.image->getSize());
+                        TLR_ASSERT(imageInfo.pixelType == videoFrame.image->getPixelType());
+                        TLR_ASSERT(0 == memcmp(
+                            image->getData(),
+                            videoFrame.image->getData(),
+                            image->getDataByteCount()));
+                        images.push_back(videoFrame.image);
+                    }
+                    TLR_ASSERT(0 == memcmp(
+                        images[0]->getData(),
+                        images[1]->getData(),
+                        image->getDataByteCount()));
+                }
+                catch (const std::exception& e)
+                {
+                    _printError(e.what());
+                }
+            }
+        }
     }
 }
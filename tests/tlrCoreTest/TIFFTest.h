@@ -19,6 +19,10 @@ namespace tlr
             static std::shared_ptr<TIFFTest> create(const std::shared_ptr<core::Context>&);
 
             void run() override;
+
+        private:
+            void _io();
+            void _threads();
         };
     }
 }
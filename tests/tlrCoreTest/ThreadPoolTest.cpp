@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCoreTest/ThreadPoolTest.h>
+
+#include <tlrCore/Assert.h>
+#include <tlrCore/Context.h>
+#include <tlrCore/ThreadPool.h>
+
+#include <atomic>
+#include <sstream>
+
+using namespace tlr::core;
+
+namespace tlr
+{
+    namespace CoreTest
+    {
+        ThreadPoolTest::ThreadPoolTest(const std::shared_ptr<core::Context>& context) :
+            ITest("CoreTest::ThreadPoolTest", context)
+        {}
+
+        std::shared_ptr<ThreadPoolTest> ThreadPoolTest::create(const std::shared_ptr<core::Context>& context)
+        {
+            return std::shared_ptr<ThreadPoolTest>(new ThreadPoolTest(context));
+        }
+
+        void ThreadPoolTest::run()
+        {
+            auto threadPool = _context->getSystem<ThreadPool>();
+            TLR_ASSERT(threadPool);
+            TLR_ASSERT(threadPool->getThreadCount() > 0);
+            const ThreadPoolStats stats = threadPool->getStats();
+            {
+                std::stringstream ss;
+                ss << "Thread count: " << threadPool->getThreadCount();
+                _print(ss.str());
+            }
+            {
+                std::vector<std::future<int> > futures;
+                for (int i = 0; i < 100; ++i)
+                {
+                    futures.push_back(threadPool->submit(
+                        [i]
+                        {
+                            return i * 2;
+                        }));
+                }
+                for (int i = 0; i < 100; ++i)
+                {
+                    TLR_ASSERT(i * 2 == futures[i].get());
+                }
+            }
+            {
+                std::vector<std::future<void> > futures;
+                std::atomic<int> count(0);
+                for (int i = 0; i < 100; ++i)
+                {
+                    futures.push_back(threadPool->submit(
+                        [&count]
+                        {
+                            ++count;
+                        },
+                        i % 2));
+                }
+                for (auto& i : futures)
+                {
+                    i.get();
+                }
+                TLR_ASSERT(100 == count);
+            }
+            {
+                auto future = threadPool->submit(
+                    []
+                    {
+                        throw std::runtime_error("error");
+                        return 0;
+                    });
+                bool error = false;
+                try
+                {
+                    future.get();
+                }
+                catch (const std::exception&)
+                {
+                    error = true;
+                }
+                TLR_ASSERT(error);
+            }
+            {
+                const ThreadPoolStats stats2 = threadPool->getStats();
+                TLR_ASSERT(stats2.threadCount == threadPool->getThreadCount());
+                TLR_ASSERT(stats2.submitted >= stats.submitted + 201);
+                std::stringstream ss;
+                ss << "Submitted: " << stats2.submitted << ", stolen: " << stats2.stolen;
+                _print(ss.str());
+            }
+        }
+    }
+}
@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlrTestLib/ITest.h>
+
+namespace tlr
+{
+    namespace CoreTest
+    {
+        class ThreadPoolTest : public Test::ITest
+        {
+        protected:
+            ThreadPoolTest(const std::shared_ptr<core::Context>&);
+
+        public:
+            static std::shared_ptr<ThreadPoolTest> create(const std::shared_ptr<core::Context>&);
+
+            void run() override;
+        };
+    }
+}
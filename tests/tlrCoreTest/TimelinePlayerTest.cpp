@@ -41,6 +41,7 @@ namespace tlr
             ITest::_enum<Playback>("Playback", getPlaybackEnums);
             ITest::_enum<Loop>("Loop", getLoopEnums);
             ITest::_enum<TimeAction>("TimeAction", getTimeActionEnums);
+            ITest::_enum<FrameCacheMode>("FrameCacheMode", getFrameCacheModeEnums);
         }
 
         void TimelinePlayerTest::_loopTime()
@@ -135,6 +136,13 @@ namespace tlr
                     }
                     _print(ss.str());
                 });
+            std::size_t frameCacheByteCount = 0;
+            auto frameCacheByteCountObserver = observer::ValueObserver<std::size_t>::create(
+                timelinePlayer->observeFrameCacheByteCount(),
+                [&frameCacheByteCount](std::size_t value)
+                {
+                    frameCacheByteCount = value;
+                });
             for (const auto& loop : getLoopEnums())
             {
                 timelinePlayer->setLoop(loop);
@@ -152,6 +160,22 @@ namespace tlr
                 }
             }
             timelinePlayer->setPlayback(Playback::Stop);
+            TLR_ASSERT(frameCacheByteCount <= imaging::getDataByteCount(imageInfo) * 11);
+
+            // Test the byte count frame cache mode.
+            timelinePlayer->setFrameCacheMode(FrameCacheMode::Bytes);
+            TLR_ASSERT(FrameCacheMode::Bytes == timelinePlayer->getFrameCacheMode());
+            timelinePlayer->setFrameCacheMaxByteCount(imaging::getDataByteCount(imageInfo) * 4);
+            TLR_ASSERT(imaging::getDataByteCount(imageInfo) * 4 == timelinePlayer->getFrameCacheMaxByteCount());
+            timelinePlayer->setPlayback(Playback::Forward);
+            for (size_t i = 0; i < static_cast<size_t>(timelineDuration.value()); ++i)
+            {
+                timelinePlayer->tick();
+                time::sleep(std::chrono::microseconds(1000000 / 24));
+            }
+            timelinePlayer->setPlayback(Playback::Stop);
+            TLR_ASSERT(frameCacheByteCount <= imaging::getDataByteCount(imageInfo) * 4);
+            timelinePlayer->setFrameCacheMode(FrameCacheMode::Frames);
 
             // Test the playback mode.
             Playback playback = Playback::Stop;
@@ -138,6 +138,18 @@ namespace tlr
                 a.time = otime::RationalTime(1.0, 24.0);
                 TLR_ASSERT(a != b);
             }
+            {
+                Frame frame;
+                TLR_ASSERT(0 == getDataByteCount(frame));
+                const imaging::Info info(16, 16, imaging::PixelType::RGB_U8);
+                FrameLayer layer;
+                layer.image = imaging::Image::create(info);
+                frame.layers.push_back(layer);
+                TLR_ASSERT(imaging::getDataByteCount(info) == getDataByteCount(frame));
+                layer.imageB = imaging::Image::create(info);
+                frame.layers.push_back(layer);
+                TLR_ASSERT(imaging::getDataByteCount(info) * 3 == getDataByteCount(frame));
+            }
         }
         
         void TimelineTest::_timeline()
@@ -255,6 +267,28 @@ namespace tlr
                 }
             }
 
+            // Get frames from the timeline with priorities.
+            frames.clear();
+            futures.clear();
+            for (size_t i = 0; i < static_cast<size_t>(timelineDuration.value()); ++i)
+            {
+                futures.push_back(timeline->getFrame(
+                    otime::RationalTime(i, 24.0),
+                    static_cast<int64_t>(timelineDuration.value()) - i));
+            }
+            for (size_t i = 0; i < futures.size(); ++i)
+            {
+                const auto frame = futures[i].get();
+                TLR_ASSERT(frame.time == otime::RationalTime(i, 24.0));
+            }
+
+            // Requests outside of the active ranges return empty frames.
+            timeline->setActiveRanges({ otime::TimeRange(otime::RationalTime(0.0, 24.0), otime::RationalTime(1.0, 24.0)) });
+            {
+                auto future = timeline->getFrame(otime::RationalTime(1.0, 24.0));
+                TLR_ASSERT(future.get().layers.empty());
+            }
+
             // Cancel frames.
             frames.clear();
             futures.clear();
@@ -20,6 +20,7 @@
 #include <tlrCoreTest/RangeTest.h>
 #include <tlrCoreTest/StringTest.h>
 #include <tlrCoreTest/StringFormatTest.h>
+#include <tlrCoreTest/ThreadPoolTest.h>
 #include <tlrCoreTest/TimeTest.h>
 #include <tlrCoreTest/TimelinePlayerTest.h>
 #include <tlrCoreTest/TimelineTest.h>
@@ -96,6 +97,7 @@ int main(int argc, char* argv[])
         tests.push_back(CoreTest::RangeTest::create(context));
         tests.push_back(CoreTest::StringTest::create(context));
         tests.push_back(CoreTest::StringFormatTest::create(context));
+        tests.push_back(CoreTest::ThreadPoolTest::create(context));
         tests.push_back(CoreTest::TimeTest::create(context));
         tests.push_back(CoreTest::TimelinePlayerTest::create(context));
         tests.push_back(CoreTest::TimelineTest::create(context));